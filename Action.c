@@ -51,6 +51,7 @@ in the source distribution for its full text.
 
 #if defined(HAVE_BACKTRACE_SCREEN)
 #include "BacktraceScreen.h"
+#include "ProfileScreen.h"
 #endif
 
 
@@ -292,7 +293,8 @@ static Htop_Reaction actionToggleTreeView(State* st) {
 
    host->activeTable->needsSort = true;
 
-   return HTOP_REFRESH | HTOP_SAVE_SETTINGS | HTOP_KEEP_FOLLOWING | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
+   // rescan, threads of collapsed branches might not have been read
+   return HTOP_RECALCULATE | HTOP_SAVE_SETTINGS | HTOP_KEEP_FOLLOWING | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
 }
 
 static Htop_Reaction actionToggleHideMeters(State* st) {
@@ -311,7 +313,7 @@ static Htop_Reaction actionExpandOrCollapseAllBranches(State* st) {
       Table_collapseAllBranches(host->activeTable);
    else
       Table_expandTree(host->activeTable);
-   return HTOP_REFRESH | HTOP_SAVE_SETTINGS;
+   return HTOP_RECALCULATE | HTOP_SAVE_SETTINGS;
 }
 
 static Htop_Reaction actionIncFilter(State* st) {
@@ -380,6 +382,10 @@ static inline void setActiveScreen(Settings* settings, State* st, unsigned int s
       settings->ss->table = host->processTable;
    host->activeTable = settings->ss->table;
 
+   // screens added in Setup may use a table that is not scanned yet
+   Machine_addTable(host, host->activeTable);
+   Table_setPanel(host->activeTable, (Panel*) st->mainPanel);
+
    // set correct functionBar - readonly if requested, and/or with non-process screens
    bool readonly = Settings_isReadonly() || (host->activeTable != host->processTable);
    MainPanel_setFunctionBar(st->mainPanel, readonly);
@@ -637,6 +643,53 @@ static Htop_Reaction actionBacktrace(State *st) {
 
    return HTOP_REFRESH | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
 }
+
+static Htop_Reaction actionProfile(State* st) {
+   if (!Action_writeableProcess(st))
+      return HTOP_OK;
+
+   Process* selectedProcess = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!selectedProcess)
+      return HTOP_OK;
+
+   assert(Object_isA((const Object*) selectedProcess, (const ObjectClass*) &Process_class));
+
+   /* the tagged processes, or else the selected one; with all their threads known */
+   const Vector* allProcesses = st->host->activeTable->rows;
+   bool tagged = false;
+   for (int i = 0; i < Vector_size(allProcesses) && !tagged; i++)
+      tagged = ((const Row*) Vector_get(allProcesses, i))->tag;
+
+   Vector* processes = Vector_new(Class(Process), false, VECTOR_DEFAULT_SIZE);
+   if (!tagged && Process_isUserlandThread(selectedProcess)) {
+      Vector_add(processes, selectedProcess);
+   } else {
+      for (int i = 0; i < Vector_size(allProcesses); i++) {
+         Process* process = (Process*) Vector_get(allProcesses, i);
+         if (Process_isKernelThread(process))
+            continue;
+
+         bool wanted;
+         if (tagged) {
+            const Row* group = Table_findRow(st->host->activeTable, Process_getThreadGroup(process));
+            wanted = process->super.tag || (group && group->tag);
+         } else {
+            wanted = Process_getThreadGroup(process) == Process_getThreadGroup(selectedProcess);
+         }
+         if (wanted) {
+            Vector_add(processes, process);
+         }
+      }
+   }
+
+   ProfileScreen* ps = ProfileScreen_new(processes);
+   InfoScreen_run((InfoScreen*)ps);
+   ProfileScreen_delete((Object*)ps);
+   Vector_delete(processes);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
 #endif
 
 static Htop_Reaction actionStrace(State* st) {
@@ -705,6 +758,10 @@ static const struct {
    { .key = "N P M T: ",  .roInactive = false, .info = "sort by PID, CPU%, MEM% or TIME" },
    { .key = "      I: ",  .roInactive = false, .info = "invert sort order" },
    { .key = " F6 > .: ",  .roInactive = false, .info = "select sort column" },
+#ifdef HTOP_PCP
+   { .key = "    ( ): ",  .roInactive = false, .info = "archive: step back/forward" },
+   { .key = "    { }: ",  .roInactive = false, .info = "archive: seek 60 steps back/fwd" },
+#endif
    { .key = NULL, .info = NULL }
 };
 
@@ -725,6 +782,7 @@ static const struct {
 #endif
 #if defined(HAVE_BACKTRACE_SCREEN)
    { .key = "      b: ", .roInactive = false, .info = "show process backtrace" },
+   { .key = "      B: ", .roInactive = true,  .info = "profile process/tagged processes" },
 #endif
    { .key = "      e: ", .roInactive = false, .info = "show process environment" },
    { .key = "      i: ", .roInactive = true,  .info = "set IO priority" },
@@ -734,6 +792,11 @@ static const struct {
    { .key = "      w: ", .roInactive = false, .info = "wrap process command in multiple lines" },
 #ifdef SCHEDULER_SUPPORT
    { .key = "      Y: ", .roInactive = true,  .info = "set scheduling policy" },
+#endif
+#ifdef HTOP_PCP
+   { .key = "    g G: ", .roInactive = false, .info = "archive: go to start/end" },
+   { .key = "      @: ", .roInactive = false, .info = "archive: go to a given time" },
+   { .key = "      f: ", .roInactive = false, .info = "archive: cycle replay speed" },
 #endif
    { .key = " F2 C S: ", .roInactive = false, .info = "setup" },
    { .key = " F1 h ?: ", .roInactive = false, .info = "show this help screen" },
@@ -971,6 +1034,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['a'] = actionSetAffinity;
 #if defined(HAVE_BACKTRACE_SCREEN)
    keys['b'] = actionBacktrace;
+   keys['B'] = actionProfile;
 #endif
    keys['c'] = actionTagAllChildren;
    keys['e'] = actionShowEnvScreen;
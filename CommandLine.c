@@ -396,6 +396,11 @@ int CommandLine_run(int argc, char** argv) {
    if (settings->ss->allBranchesCollapsed)
       Table_collapseAllBranches(&pt->super);
 
+   // CPU and I/O rates need two samples: ScreenManager_run takes the second
+   // one right away, so leave a short gap to have them valid in the first frame
+   if (settings->warmStartDelay > 0)
+      napms(settings->warmStartDelay * 100);
+
    ScreenManager_run(scr, NULL, NULL, NULL);
 
    Platform_done();
@@ -200,8 +200,15 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    Panel_add(super, (Object*) CheckItem_newByRef("Enable the mouse", &(settings->enableMouse)));
    #endif
    Panel_add(super, (Object*) NumberItem_newByRef("Update interval (in seconds)", &(settings->delay), -1, 1, 255));
+   Panel_add(super, (Object*) NumberItem_newByRef("- Sample rates this early before the first update (in seconds, 0 - off)", &(settings->warmStartDelay), -1, 0, 10));
    Panel_add(super, (Object*) CheckItem_newByRef("Highlight new and old processes", &(settings->highlightChanges)));
    Panel_add(super, (Object*) NumberItem_newByRef("- Highlight time (in seconds)", &(settings->highlightDelaySecs), 0, 1, 24 * 60 * 60));
+   #ifdef HTOP_LINUX
+   Panel_add(super, (Object*) NumberItem_newByRef("Pages sampled per process for the USS estimate", &(settings->ussSamplePages), 0, 16, 16384));
+   Panel_add(super, (Object*) NumberItem_newByRef("- Confidence of the USS error bound (in percent)", &(settings->ussConfidence), 0, 50, 99));
+   Panel_add(super, (Object*) NumberItem_newByRef("Working set window (in seconds)", &(settings->wssWindow), 0, 1, 600));
+   Panel_add(super, (Object*) NumberItem_newByRef("Processes with performance counters, by CPU usage", &(settings->perfTopProcesses), 0, 1, 256));
+   #endif
    Panel_add(super, (Object*) NumberItem_newByRef("Hide main function bar (0 - off, 1 - on ESC until next input, 2 - permanently)", &(settings->hideFunctionBar), 0, 0, 2));
    #ifdef HAVE_LIBHWLOC
    Panel_add(super, (Object*) CheckItem_newByRef("Show topology when selecting affinity by default", &(settings->topologyAffinity)));
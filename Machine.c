@@ -60,7 +60,7 @@ void Machine_done(Machine* this) {
    free(this->tables);
 }
 
-static void Machine_addTable(Machine* this, Table* table) {
+void Machine_addTable(Machine* this, Table* table) {
    /* check that this table has not been seen previously */
    for (size_t i = 0; i < this->tableCount; i++)
       if (this->tables[i] == table)
@@ -100,13 +100,18 @@ void Machine_setTablesPanel(Machine* this, Panel* panel) {
 void Machine_scanTables(Machine* this) {
    // set scan timestamp
    static bool firstScanDone = false;
+   static uint64_t firstScanMs = 0;
 
    if (firstScanDone) {
-      this->prevMonotonicMs = this->monotonicMs;
+      // rows of the first scan are stamped "far in the past", but the rates
+      // of the second scan need the real time of the first one
+      this->prevMonotonicMs = firstScanMs ? firstScanMs : this->monotonicMs;
+      firstScanMs = 0;
       Platform_gettime_monotonic(&this->monotonicMs);
    } else {
       this->prevMonotonicMs = 0;
       this->monotonicMs = 1;
+      Platform_gettime_monotonic(&firstScanMs);
       firstScanDone = true;
    }
    if (this->monotonicMs <= this->prevMonotonicMs) {
@@ -88,6 +88,8 @@ void Machine_done(Machine* this);
 
 bool Machine_isCPUonline(const Machine* this, unsigned int id);
 
+void Machine_addTable(Machine* this, Table* table);
+
 void Machine_populateTablesFromSettings(Machine* this, Settings* settings, Table* processTable);
 
 void Machine_setTablesPanel(Machine* this, Panel* panel);
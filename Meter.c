@@ -199,8 +199,7 @@ end:
 
 #ifdef HAVE_LIBNCURSESW
 
-#define PIXPERROW_UTF8 4
-static const char* const GraphMeterMode_dotsUtf8[] = {
+const char* const GraphMeterMode_dotsUtf8[] = {
    /*00*/" ", /*01*/"⢀", /*02*/"⢠", /*03*/"⢰", /*04*/ "⢸",
    /*10*/"⡀", /*11*/"⣀", /*12*/"⣠", /*13*/"⣰", /*14*/ "⣸",
    /*20*/"⡄", /*21*/"⣄", /*22*/"⣤", /*23*/"⣴", /*24*/ "⣼",
@@ -210,8 +209,7 @@ static const char* const GraphMeterMode_dotsUtf8[] = {
 
 #endif
 
-#define PIXPERROW_ASCII 2
-static const char* const GraphMeterMode_dotsAscii[] = {
+const char* const GraphMeterMode_dotsAscii[] = {
    /*00*/" ", /*01*/".", /*02*/":",
    /*10*/".", /*11*/".", /*12*/":",
    /*20*/":", /*21*/":", /*22*/":"
@@ -155,4 +155,13 @@ ListItem* Meter_toListItem(const Meter* this, bool moving);
 
 extern const MeterClass BlankMeter_class;
 
+/* Glyphs of two samples side by side, indexed by left * (PIXPERROW + 1) + right */
+#ifdef HAVE_LIBNCURSESW
+#define PIXPERROW_UTF8 4
+extern const char* const GraphMeterMode_dotsUtf8[];
+#endif
+
+#define PIXPERROW_ASCII 2
+extern const char* const GraphMeterMode_dotsAscii[];
+
 #endif
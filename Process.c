@@ -800,6 +800,7 @@ void Process_done(Process* this) {
    free(this->procCwd);
    free(this->mergedCommand.str);
    free(this->tty_name);
+   Row_done(&this->super);
 }
 
 /* This function returns the string displayed in Command column, so that sorting
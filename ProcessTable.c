@@ -43,7 +43,7 @@ Process* ProcessTable_getProcess(ProcessTable* this, pid_t pid, bool* preExistin
    return proc;
 }
 
-static void ProcessTable_prepareEntries(Table* super) {
+void ProcessTable_prepareEntries(Table* super) {
    ProcessTable* this = (ProcessTable*) super;
    this->totalTasks = 0;
    this->userlandThreads = 0;
@@ -53,13 +53,13 @@ static void ProcessTable_prepareEntries(Table* super) {
    Table_prepareEntries(super);
 }
 
-static void ProcessTable_iterateEntries(Table* super) {
+void ProcessTable_iterateEntries(Table* super) {
    ProcessTable* this = (ProcessTable*) super;
    // calling into platform-specific code
    ProcessTable_goThroughEntries(this);
 }
 
-static void ProcessTable_cleanupEntries(Table* super) {
+void ProcessTable_cleanupEntries(Table* super) {
    Machine* host = super->host;
    const Settings* settings = host->settings;
 
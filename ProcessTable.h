@@ -37,6 +37,12 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
 
 void ProcessTable_done(ProcessTable* this);
 
+void ProcessTable_prepareEntries(Table* super);
+
+void ProcessTable_iterateEntries(Table* super);
+
+void ProcessTable_cleanupEntries(Table* super);
+
 extern const TableClass ProcessTable_class;
 
 static inline void ProcessTable_add(ProcessTable* this, Process* process) {
@@ -0,0 +1,478 @@
+/*
+htop - ProfileScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProfileScreen.h"
+
+#if defined(HAVE_BACKTRACE_SCREEN)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/select.h>
+
+#include "BacktraceScreen.h"
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "ListItem.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+/*
+ * Sampling profiler: the stacks of all sampled threads are unwound through
+ * Platform_getBacktrace on every pass, which stops each thread briefly, and
+ * merged into one call tree per process. Lines are rebuilt from the tree at
+ * most twice a second.
+ */
+
+#define PROFILE_DRAW_INTERVAL_MS 500
+
+typedef enum ProfileNodeExpansion_ {
+   PROFILE_NODE_AUTO,                /* open while it has a notable share of the samples */
+   PROFILE_NODE_OPEN,
+   PROFILE_NODE_CLOSED,
+} ProfileNodeExpansion;
+
+/* passes per second */
+static const unsigned int ProfileScreen_rates[] = { 1, 2, 5, 10, 20, 50, 100 };
+
+#define PROFILE_DEFAULT_RATE 3
+
+static const char* const ProfileScreenFunctions[] = {"Export ", "Search ", "Filter ", "Refresh", "Pause  ", "Slower ", "Faster ", "Reset  ", "Done   ", NULL};
+
+static const char* const ProfileScreenKeys[] = {"F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "Esc"};
+
+static const int ProfileScreenEvents[] = {KEY_F(2), KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), KEY_F(7), KEY_F(8), KEY_F(9), 27};
+
+static ProfileNode* ProfileNode_new(const char* name, const char* object) {
+   ProfileNode* this = xCalloc(1, sizeof(ProfileNode));
+   this->name = xStrdup(name);
+   this->object = object ? xStrdup(object) : NULL;
+   this->expansion = PROFILE_NODE_AUTO;
+   return this;
+}
+
+static void ProfileNode_deleteChildren(ProfileNode* this) {
+   ProfileNode* child = this->children;
+   while (child) {
+      ProfileNode* next = child->next;
+      ProfileNode_deleteChildren(child);
+      free(child->name);
+      free(child->object);
+      free(child);
+      child = next;
+   }
+   this->children = NULL;
+}
+
+static ProfileNode* ProfileNode_child(ProfileNode* this, const char* name, const char* object) {
+   for (ProfileNode* child = this->children; child; child = child->next) {
+      if (String_eq(child->name, name) && String_eq_nullable(child->object, object))
+         return child;
+   }
+
+   ProfileNode* child = ProfileNode_new(name, object);
+   child->next = this->children;
+   this->children = child;
+   return child;
+}
+
+/* Insertion sort by decreasing samples; the order rarely changes between two draws */
+static void ProfileNode_sortChildren(ProfileNode* this) {
+   ProfileNode* sorted = NULL;
+   ProfileNode* child = this->children;
+   while (child) {
+      ProfileNode* next = child->next;
+      ProfileNode** at = &sorted;
+      while (*at && (*at)->samples >= child->samples)
+         at = &(*at)->next;
+      child->next = *at;
+      *at = child;
+      child = next;
+   }
+   this->children = sorted;
+}
+
+static bool ProfileNode_isOpen(const ProfileNode* this, unsigned long long total) {
+   if (this->expansion != PROFILE_NODE_AUTO)
+      return this->expansion == PROFILE_NODE_OPEN;
+
+   return this->samples * 20 >= total;
+}
+
+ProfileScreen* ProfileScreen_new(Vector* processes) {
+   ProfileScreen* this = xCalloc(1, sizeof(ProfileScreen));
+   Object_setClass(this, Class(ProfileScreen));
+   this->frames = Vector_new(Class(BacktraceFrameData), true, VECTOR_DEFAULT_SIZE);
+   this->rate = PROFILE_DEFAULT_RATE;
+   this->sampling = true;
+
+   size_t count = (size_t) Vector_size(processes);
+   this->targets = xCalloc(count, sizeof(ProfileTarget));
+   pid_t* groups = xCalloc(count, sizeof(pid_t));
+
+   for (size_t i = 0; i < count; i++) {
+      const Process* process = (const Process*) Vector_get(processes, (int) i);
+      pid_t tgid = Process_getThreadGroup(process);
+
+      /* one node for each process, named after its main thread if that is sampled too */
+      ProfileNode* top = NULL;
+      for (size_t j = 0; j < this->nTargets; j++) {
+         if (groups[j] == tgid)
+            top = this->targets[j].top;
+      }
+      if (!top) {
+         const Process* leader = process;
+         for (size_t j = 0; j < count; j++) {
+            const Process* other = (const Process*) Vector_get(processes, (int) j);
+            if (Process_getPid(other) == tgid)
+               leader = other;
+         }
+
+         char* name = NULL;
+         xAsprintf(&name, "%s [%d]", leader->procComm ? leader->procComm : Process_getCommand(leader), tgid);
+         top = ProfileNode_child(&this->root, name, NULL);
+         free(name);
+      }
+
+      groups[this->nTargets] = tgid;
+      this->targets[this->nTargets].tid = Process_getPid(process);
+      this->targets[this->nTargets].top = top;
+      this->nTargets++;
+   }
+   free(groups);
+
+   FunctionBar* bar = FunctionBar_new(ProfileScreenFunctions, ProfileScreenKeys, ProfileScreenEvents);
+   CRT_disableDelay();
+   const Process* first = count ? (const Process*) Vector_get(processes, 0) : NULL;
+   return (ProfileScreen*) InfoScreen_init(&this->super, first, bar, LINES - 2, " TOTAL%  SELF%  SAMPLES  FUNCTION");
+}
+
+void ProfileScreen_delete(Object* cast) {
+   ProfileScreen* this = (ProfileScreen*) cast;
+   ProfileNode_deleteChildren(&this->root);
+   Vector_delete(this->frames);
+   free(this->targets);
+   free(this->rows);
+   free(this->message);
+   CRT_enableDelay();
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void ProfileScreen_draw(InfoScreen* super) {
+   const ProfileScreen* this = (const ProfileScreen*) super;
+
+   size_t nProcesses = 0;
+   for (const ProfileNode* top = this->root.children; top; top = top->next)
+      nProcesses++;
+
+   char rate[16] = "paused";
+   if (this->sampling)
+      xSnprintf(rate, sizeof(rate), "%u/s", ProfileScreen_rates[this->rate]);
+
+   char state[96];
+   if (this->failures) {
+      xSnprintf(state, sizeof(state), "%llu samples, %llu failed, %s", this->root.samples, this->failures, rate);
+   } else {
+      xSnprintf(state, sizeof(state), "%llu samples, %s", this->root.samples, rate);
+   }
+
+   const char* message = this->message ? this->message : "";
+   const char* separator = this->message ? " - " : "";
+
+   if (nProcesses == 1 && super->process) {
+      InfoScreen_drawTitled(super, "Profile of process %d (%zu threads) - %s: %s%s%s",
+         Process_getThreadGroup(super->process), this->nTargets, Process_getCommand(super->process), state, separator, message);
+   } else {
+      InfoScreen_drawTitled(super, "Profile of %zu processes (%zu threads): %s%s%s",
+         nProcesses, this->nTargets, state, separator, message);
+   }
+}
+
+static void ProfileScreen_addRow(ProfileScreen* this, ProfileNode* node, int depth, unsigned long long total) {
+   ProfileNode_sortChildren(node);
+
+   bool open = ProfileNode_isOpen(node, total);
+   const char* marker = !node->children ? "   " : open ? "[-]" : "[+]";
+   double share = total ? 100.0 * (double) node->samples / (double) total : 0.0;
+   double selfShare = total ? 100.0 * (double) node->self / (double) total : 0.0;
+
+   char* line = NULL;
+   xAsprintf(&line, "%6.1f%% %5.1f%% %8llu  %*s%s %s%s%s%s",
+      share, selfShare, node->samples,
+      2 * depth, "", marker, node->name,
+      node->object ? "  (" : "", node->object ? node->object : "", node->object ? ")" : "");
+
+   if (this->nRows == this->rowsCapacity) {
+      this->rowsCapacity = this->rowsCapacity ? this->rowsCapacity * 2 : 256;
+      this->rows = xReallocArray(this->rows, this->rowsCapacity, sizeof(*this->rows));
+   }
+   this->rows[this->nRows] = node;
+
+   InfoScreen_addLine(&this->super, line);
+   ListItem* item = (ListItem*) Vector_get(this->super.lines, Vector_size(this->super.lines) - 1);
+   item->key = (int) this->nRows;
+   this->nRows++;
+   free(line);
+
+   if (!open)
+      return;
+
+   for (ProfileNode* child = node->children; child; child = child->next)
+      ProfileScreen_addRow(this, child, depth + 1, total);
+}
+
+static ProfileNode* ProfileScreen_selectedNode(const ProfileScreen* this) {
+   const ListItem* item = (const ListItem*) Panel_getSelected(this->super.display);
+   if (!item || item->key < 0 || (size_t) item->key >= this->nRows)
+      return NULL;
+
+   return this->rows[item->key];
+}
+
+static void ProfileScreen_scan(InfoScreen* super) {
+   ProfileScreen* this = (ProfileScreen*) super;
+   Panel* display = super->display;
+
+   /* after a refresh or a resize, the lines are gone already */
+   const ProfileNode* selected = Vector_size(super->lines) ? ProfileScreen_selectedNode(this) : NULL;
+   int scrollV = display->scrollV;
+
+   Panel_prune(display);
+   Vector_prune(super->lines);
+   this->nRows = 0;
+
+   ProfileNode_sortChildren(&this->root);
+   for (ProfileNode* top = this->root.children; top; top = top->next)
+      ProfileScreen_addRow(this, top, 0, this->root.samples);
+
+   display->scrollV = scrollV;
+   for (int i = 0; selected && i < Panel_size(display); i++) {
+      const ListItem* item = (const ListItem*) Panel_get(display, i);
+      if (this->rows[item->key] == selected) {
+         Panel_setSelected(display, i);
+         break;
+      }
+   }
+
+   this->changed = false;
+}
+
+static void ProfileScreen_sample(ProfileScreen* this) {
+   for (size_t i = 0; i < this->nTargets; i++) {
+      char* error = NULL;
+      Platform_getBacktrace(this->targets[i].tid, this->frames, &error);
+      if (error || Vector_size(this->frames) == 0) {
+         this->failures++;
+         free(error);
+         Vector_prune(this->frames);
+         continue;
+      }
+
+      ProfileNode* node = this->targets[i].top;
+      this->root.samples++;
+      node->samples++;
+
+      /* the outermost frame comes last */
+      for (int j = Vector_size(this->frames) - 1; j >= 0; j--) {
+         const BacktraceFrameData* frame = (const BacktraceFrameData*) Vector_get(this->frames, j);
+         const char* name = frame->demangleFunctionName ? frame->demangleFunctionName : frame->functionName;
+         node = ProfileNode_child(node, name ? name : "???", frame->objectName);
+         node->samples++;
+      }
+      node->self++;
+
+      Vector_prune(this->frames);
+   }
+
+   this->changed = true;
+}
+
+static void ProfileScreen_update(InfoScreen* super) {
+   ProfileScreen* this = (ProfileScreen*) super;
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+
+   if (this->sampling && now >= this->nextSampleMs) {
+      ProfileScreen_sample(this);
+
+      /* passes taking longer than the interval slow the rate down rather than queue up */
+      this->nextSampleMs += 1000 / ProfileScreen_rates[this->rate];
+      Platform_gettime_monotonic(&now);
+      this->nextSampleMs = MAXIMUM(this->nextSampleMs, now);
+   }
+
+   if (this->changed && now >= this->drawnMs + PROFILE_DRAW_INTERVAL_MS) {
+      ProfileScreen_scan(super);
+      InfoScreen_draw(super);
+      this->drawnMs = now;
+   }
+
+   /* sleep until the next pass, unless a key comes first */
+   uint64_t waitMs = this->sampling ? saturatingSub(this->nextSampleMs, now) : PROFILE_DRAW_INTERVAL_MS;
+   waitMs = MINIMUM(waitMs, PROFILE_DRAW_INTERVAL_MS);
+
+   fd_set fds;
+   FD_ZERO(&fds);
+   FD_SET(STDIN_FILENO, &fds);
+   struct timeval tv = { .tv_sec = 0, .tv_usec = (suseconds_t) (waitMs * 1000) };
+   select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv);
+}
+
+static void ProfileScreen_writeFolded(FILE* fp, const ProfileNode* node, const ProfileNode** path, size_t depth, size_t* stacks) {
+   path[depth] = node;
+
+   if (node->self) {
+      for (size_t i = 0; i <= depth; i++) {
+         if (i)
+            fputc(';', fp);
+         /* ';' separates the frames, a newline the stacks */
+         for (const char* c = path[i]->name; *c; c++)
+            fputc((*c == ';' || *c == '\n') ? '_' : *c, fp);
+      }
+      fprintf(fp, " %llu\n", node->self);
+      (*stacks)++;
+   }
+
+   for (const ProfileNode* child = node->children; child; child = child->next)
+      ProfileScreen_writeFolded(fp, child, path, depth + 1, stacks);
+}
+
+static size_t ProfileNode_depth(const ProfileNode* this) {
+   size_t depth = 0;
+   for (const ProfileNode* child = this->children; child; child = child->next)
+      depth = MAXIMUM(depth, ProfileNode_depth(child));
+   return depth + 1;
+}
+
+/* Writes the stacks in the folded format of flame graph tools into the working directory */
+static void ProfileScreen_export(ProfileScreen* this) {
+   char path[64];
+   time_t now = time(NULL);
+   struct tm tm;
+   localtime_r(&now, &tm);
+   strftime(path, sizeof(path), "htop-profile-%Y%m%d-%H%M%S.folded", &tm);
+
+   free(this->message);
+   this->message = NULL;
+
+   /* often run as root, so never through a link or over a file planted in a shared directory */
+   int fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+   if (fd < 0) {
+      if (errno == EEXIST) {
+         xAsprintf(&this->message, "cannot write %s: file exists", path);
+      } else {
+         xAsprintf(&this->message, "cannot write %s: %s", path, strerror(errno));
+      }
+      return;
+   }
+
+   FILE* fp = fdopen(fd, "w");
+   if (!fp) {
+      xAsprintf(&this->message, "cannot write %s: %s", path, strerror(errno));
+      close(fd);
+      return;
+   }
+
+   const ProfileNode** stack = xCalloc(ProfileNode_depth(&this->root), sizeof(*stack));
+   size_t stacks = 0;
+   for (const ProfileNode* top = this->root.children; top; top = top->next)
+      ProfileScreen_writeFolded(fp, top, stack, 0, &stacks);
+   free(stack);
+
+   if (fclose(fp) != 0) {
+      xAsprintf(&this->message, "cannot write %s: %s", path, strerror(errno));
+      return;
+   }
+
+   xAsprintf(&this->message, "wrote %zu stacks to %s", stacks, path);
+}
+
+static void ProfileScreen_reset(ProfileScreen* this) {
+   for (ProfileNode* top = this->root.children; top; top = top->next) {
+      ProfileNode_deleteChildren(top);
+      top->samples = 0;
+      top->self = 0;
+   }
+   this->root.samples = 0;
+   this->failures = 0;
+   this->changed = true;
+}
+
+static bool ProfileScreen_onKey(InfoScreen* super, int ch) {
+   ProfileScreen* this = (ProfileScreen*) super;
+
+   switch (ch) {
+      case ' ':
+      case '\r':
+      case '\n':
+      case KEY_ENTER: {
+         ProfileNode* node = ProfileScreen_selectedNode(this);
+         if (!node || !node->children)
+            return true;
+
+         node->expansion = ProfileNode_isOpen(node, this->root.samples) ? PROFILE_NODE_CLOSED : PROFILE_NODE_OPEN;
+         ProfileScreen_scan(super);
+         return true;
+      }
+      case 'e':
+      case KEY_F(2):
+         ProfileScreen_export(this);
+         InfoScreen_draw(this);
+         return true;
+      case 'z':
+      case KEY_F(6):
+         this->sampling = !this->sampling;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), this->sampling ? "Pause  " : "Resume ");
+         InfoScreen_draw(this);
+         return true;
+      case '-':
+      case KEY_F(7):
+         if (this->rate > 0)
+            this->rate--;
+         InfoScreen_draw(this);
+         return true;
+      case '+':
+      case '=':
+      case KEY_F(8):
+         if (this->rate < ARRAYSIZE(ProfileScreen_rates) - 1)
+            this->rate++;
+         InfoScreen_draw(this);
+         return true;
+      case KEY_F(9):
+         ProfileScreen_reset(this);
+         ProfileScreen_scan(super);
+         InfoScreen_draw(this);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass ProfileScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = ProfileScreen_delete
+   },
+   .scan = ProfileScreen_scan,
+   .draw = ProfileScreen_draw,
+   .onErr = ProfileScreen_update,
+   .onKey = ProfileScreen_onKey,
+};
+
+#endif
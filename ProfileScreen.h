@@ -0,0 +1,65 @@
+#ifndef HEADER_ProfileScreen
+#define HEADER_ProfileScreen
+/*
+htop - ProfileScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Vector.h"
+
+
+/* A function on the sampled stacks, below the frames calling it */
+typedef struct ProfileNode_ {
+   char* name;                       /* function, or process at the top level */
+   char* object;                     /* basename of the file mapping it, NULL if unknown */
+   unsigned long long samples;       /* stacks passing through */
+   unsigned long long self;          /* stacks ending here */
+   int expansion;                    /* ProfileNodeExpansion */
+   struct ProfileNode_* children;    /* by decreasing samples once drawn */
+   struct ProfileNode_* next;
+} ProfileNode;
+
+/* A thread sampled on each pass */
+typedef struct ProfileTarget_ {
+   pid_t tid;
+   ProfileNode* top;                 /* node of its process */
+} ProfileTarget;
+
+typedef struct ProfileScreen_ {
+   InfoScreen super;
+
+   ProfileTarget* targets;
+   size_t nTargets;
+   ProfileNode root;                 /* parent of the process nodes */
+   Vector* frames;                   /* reused for each stack */
+
+   ProfileNode** rows;               /* node of each line, by the key of its ListItem */
+   size_t nRows;
+   size_t rowsCapacity;
+
+   size_t rate;                      /* index into the sampling rates */
+   bool sampling;
+   bool changed;                     /* samples not drawn yet */
+   uint64_t nextSampleMs;
+   uint64_t drawnMs;
+   unsigned long long failures;      /* threads that could not be unwound */
+   char* message;                    /* outcome of the last export */
+} ProfileScreen;
+
+extern const InfoScreenClass ProfileScreen_class;
+
+/* Samples the threads in processes, which are not owned */
+ProfileScreen* ProfileScreen_new(Vector* processes);
+
+void ProfileScreen_delete(Object* cast);
+
+#endif
@@ -23,6 +23,7 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "Machine.h"
 #include "Macros.h"
+#include "Meter.h"
 #include "Process.h"
 #include "RichString.h"
 #include "Settings.h"
@@ -43,7 +44,7 @@ void Row_init(Row* this, const Machine* host) {
 
 void Row_done(Row* this) {
    assert(this != NULL);
-   (void) this;
+   Row_freeHistory(this);
 }
 
 static inline bool Row_isNew(const Row* this) {
@@ -526,6 +527,88 @@ int Row_printPercentage(float val, char* buffer, size_t n, uint8_t width, int* a
    return xSnprintf(buffer, n, "%*.*s ", width, width, "N/A");
 }
 
+int Row_printDecimal(double val, char* buffer, size_t n, uint8_t width, int* attr) {
+   assert(n >= 6 && width >= 4 && "Invalid width in Row_printDecimal()");
+   width = (uint8_t)CLAMP(width, 4, n - 2);
+
+   if (isNonnegative(val)) {
+      if (val < 0.05)
+         *attr = CRT_colors[PROCESS_SHADOW];
+
+      return xSnprintf(buffer, n, "%*.1f ", width, val);
+   }
+
+   *attr = CRT_colors[PROCESS_SHADOW];
+   return xSnprintf(buffer, n, "%*.*s ", width, width, "N/A");
+}
+
+/* Samples are stored as round(ROW_HISTORY_STEPS * log2(1 + value)): one
+   byte covers values up to 2^42 at a resolution of about 12 percent */
+#define ROW_HISTORY_STEPS 6
+
+void Row_recordHistory(Row* this, const double values[ROW_HISTORY_SERIES]) {
+   if (!this->history)
+      this->history = xCalloc(1, sizeof(RowHistory));
+
+   RowHistory* history = this->history;
+   for (size_t i = 0; i < ROW_HISTORY_SERIES; i++) {
+      double value = isNonnegative(values[i]) ? values[i] : 0.0;
+      double steps = ROW_HISTORY_STEPS * log2(1.0 + value);
+      history->samples[i][history->next] = (uint8_t) MINIMUM(lround(steps), UINT8_MAX);
+   }
+
+   history->next = (history->next + 1) % ROW_HISTORY_SAMPLES;
+   if (history->count < ROW_HISTORY_SAMPLES)
+      history->count++;
+}
+
+void Row_freeHistory(Row* this) {
+   free(this->history);
+   this->history = NULL;
+}
+
+static double RowHistory_value(uint8_t sample) {
+   return exp2((double)sample / ROW_HISTORY_STEPS) - 1.0;
+}
+
+void Row_printHistory(RichString* str, const Row* this, RowHistorySeries series, double minScale) {
+   const RowHistory* history = this->history;
+   unsigned int count = history ? history->count : 0;
+
+   const char* const* dots = GraphMeterMode_dotsAscii;
+   int pixPerRow = PIXPERROW_ASCII;
+#ifdef HAVE_LIBNCURSESW
+   if (CRT_utf8) {
+      dots = GraphMeterMode_dotsUtf8;
+      pixPerRow = PIXPERROW_UTF8;
+   }
+#endif
+
+   /* oldest first, columns without samples yet are left blank */
+   int pix[ROW_HISTORY_SAMPLES] = { 0 };
+   if (count > 0) {
+      double values[ROW_HISTORY_SAMPLES];
+      double scale = minScale;
+      for (unsigned int i = 0; i < count; i++) {
+         uint8_t sample = history->samples[series][(history->next + ROW_HISTORY_SAMPLES - count + i) % ROW_HISTORY_SAMPLES];
+         values[i] = RowHistory_value(sample);
+         scale = MAXIMUM(scale, values[i]);
+      }
+
+      for (unsigned int i = 0; i < count; i++) {
+         if (values[i] <= 0.0 || scale <= 0.0)
+            continue;
+         /* anything above zero is visible */
+         pix[ROW_HISTORY_SAMPLES - count + i] = CLAMP((int) lround(values[i] / scale * pixPerRow), 1, pixPerRow);
+      }
+   }
+
+   int attr = count > 0 ? CRT_colors[GRAPH_1] : CRT_colors[PROCESS_SHADOW];
+   for (size_t i = 0; i < ROW_HISTORY_SAMPLES; i += 2)
+      RichString_appendWide(str, attr, dots[pix[i] * (pixPerRow + 1) + pix[i + 1]]);
+   RichString_appendAscii(str, attr, " ");
+}
+
 void Row_toggleTag(Row* this) {
    this->tag = !this->tag;
 }
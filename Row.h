@@ -26,6 +26,24 @@ extern uint8_t Row_fieldWidths[LAST_RESERVED_FIELD];
 extern int Row_pidDigits;
 extern int Row_uidDigits;
 
+/* Series kept for the sparkline columns of a row */
+typedef enum RowHistorySeries_ {
+   ROW_HISTORY_CPU,
+   ROW_HISTORY_MEMORY,
+   ROW_HISTORY_IO,
+   ROW_HISTORY_SERIES
+} RowHistorySeries;
+
+/* Number of samples per series, drawn two per terminal column */
+#define ROW_HISTORY_SAMPLES 16
+
+typedef struct RowHistory_ {
+   /* log-scaled samples, see Row_recordHistory */
+   uint8_t samples[ROW_HISTORY_SERIES][ROW_HISTORY_SAMPLES];
+   uint8_t count;
+   uint8_t next;
+} RowHistory;
+
 struct Machine_;     // IWYU pragma: keep
 struct Settings_;    // IWYU pragma: keep
 struct Table_;       // IWYU pragma: keep
@@ -63,6 +81,9 @@ typedef struct Row_ {
    /* Whether the row was updated during the last scan */
    bool updated;
 
+   /* Whether the row was on or near the visible part of the panel last cycle */
+   bool inViewport;
+
    /*
     * Internal state for tree-mode.
     */
@@ -74,6 +95,9 @@ typedef struct Row_ {
     */
    uint64_t seenStampMs;
    uint64_t tombStampMs;
+
+   /* Recent samples for the sparkline columns, NULL unless one is shown */
+   RowHistory* history;
 } Row;
 
 typedef Row* (*Row_New)(const struct Machine_*);
@@ -162,6 +186,18 @@ void Row_printRate(RichString* str, double rate, bool coloring);
 
 int Row_printPercentage(float val, char* buffer, size_t n, uint8_t width, int* attr);
 
+/* Formats a non-negative value with one decimal, like Row_printPercentage without its 100% highlighting */
+int Row_printDecimal(double val, char* buffer, size_t n, uint8_t width, int* attr);
+
+/* Appends one sample per series to the history, allocating it on first use */
+void Row_recordHistory(Row* this, const double values[ROW_HISTORY_SERIES]);
+
+void Row_freeHistory(Row* this);
+
+/* Draws a series as sparkline scaled to its largest sample, but at least
+   minScale. Prints ROW_HISTORY_SAMPLES / 2 + 1 columns. */
+void Row_printHistory(RichString* str, const Row* this, RowHistorySeries series, double minScale);
+
 static inline int Row_idEqualCompare(const void* v1, const void* v2) {
    const int p1 = ((const Row*)v1)->id;
    const int p2 = ((const Row*)v2)->id;
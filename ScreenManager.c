@@ -161,6 +161,10 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
 
    if (*redraw) {
       Table_rebuildPanel(host->activeTable);
+      if (this->state->pauseUpdate && Table_scanReveal(host->activeTable)) {
+         host->activeTable->needsSort = true;
+         Table_rebuildPanel(host->activeTable);
+      }
       if (!this->state->hideMeters)
          Header_draw(this->header);
    }
@@ -19,6 +19,7 @@ in the source distribution for its full text.
 #include "FunctionBar.h"
 #include "Hashtable.h"
 #include "Macros.h"
+#include "Platform.h"
 #include "ProvideCurses.h"
 #include "Settings.h"
 #include "XUtils.h"
@@ -280,7 +281,13 @@ static void startRenaming(Panel* super) {
 static void addNewScreen(Panel* super, DynamicScreen* ds) {
    ScreenNamesPanel* const this = (ScreenNamesPanel*) super;
    const char* name = "New";
-   ScreenSettings* ss = (ds != NULL) ? Settings_newDynamicScreen(this->settings, name, ds, NULL) : Settings_newScreen(this->settings, &(const ScreenDefaults) { .name = name, .columns = "PID Command", .sortKey = "PID" });
+   ScreenSettings* ss;
+   if (ds != NULL) {
+      ss = Settings_newDynamicScreen(this->settings, name, ds, NULL);
+      Platform_addDynamicScreen(ss);
+   } else {
+      ss = Settings_newScreen(this->settings, &(const ScreenDefaults) { .name = name, .columns = "PID Command", .sortKey = "PID" });
+   }
    ScreenNameListItem* item = ScreenNameListItem_new(name, ss);
    int idx = Panel_getSelectedIndex(super);
    Panel_insert(super, idx + 1, (Object*) item);
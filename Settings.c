@@ -284,7 +284,12 @@ ScreenSettings* Settings_newScreen(Settings* this, const ScreenDefaults* default
 }
 
 ScreenSettings* Settings_newDynamicScreen(Settings* this, const char* tab, const DynamicScreen* screen, Table* table) {
-   int sortKey = toFieldIndex(this->dynamicColumns, screen->columnKeys);
+   unsigned int key;
+   int sortKey;
+   if (screen->sortKey && DynamicColumn_search(this->dynamicColumns, screen->sortKey, &key))
+      sortKey = (int)key;
+   else
+      sortKey = toFieldIndex(this->dynamicColumns, screen->columnKeys);
 
    ScreenSettings* ss = xMalloc(sizeof(ScreenSettings));
    *ss = (ScreenSettings) {
@@ -481,6 +486,8 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
          this->accountGuestInCPUMeter = atoi(option[1]);
       } else if (String_eq(option[0], "delay")) {
          this->delay = CLAMP(atoi(option[1]), 1, 255);
+      } else if (String_eq(option[0], "warm_start_delay")) {
+         this->warmStartDelay = CLAMP(atoi(option[1]), 0, 10);
       } else if (String_eq(option[0], "color_scheme")) {
          this->colorScheme = atoi(option[1]);
          if (this->colorScheme < 0 || this->colorScheme >= LAST_COLORSCHEME) {
@@ -520,6 +527,16 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
       } else if (String_eq(option[0], "topology_affinity")) {
          this->topologyAffinity = !!atoi(option[1]);
       #endif
+      #ifdef HTOP_LINUX
+      } else if (String_eq(option[0], "uss_sample_pages")) {
+         this->ussSamplePages = CLAMP(atoi(option[1]), 16, 16384);
+      } else if (String_eq(option[0], "uss_confidence")) {
+         this->ussConfidence = CLAMP(atoi(option[1]), 50, 99);
+      } else if (String_eq(option[0], "wss_window")) {
+         this->wssWindow = CLAMP(atoi(option[1]), 1, 600);
+      } else if (String_eq(option[0], "perf_top_processes")) {
+         this->perfTopProcesses = CLAMP(atoi(option[1]), 1, 256);
+      #endif
       } else if (strncmp(option[0], "screen:", 7) == 0) {
          screen = Settings_newScreen(this, &(const ScreenDefaults) { .name = option[0] + 7, .columns = option[1] });
       } else if (String_eq(option[0], ".sort_key")) {
@@ -713,10 +730,17 @@ int Settings_write(const Settings* this, bool onCrash) {
    printSettingInteger("enable_mouse", this->enableMouse);
    #endif
    printSettingInteger("delay", (int) this->delay);
+   printSettingInteger("warm_start_delay", this->warmStartDelay);
    printSettingInteger("hide_function_bar", (int) this->hideFunctionBar);
    #ifdef HAVE_LIBHWLOC
    printSettingInteger("topology_affinity", this->topologyAffinity);
    #endif
+   #ifdef HTOP_LINUX
+   printSettingInteger("uss_sample_pages", this->ussSamplePages);
+   printSettingInteger("uss_confidence", this->ussConfidence);
+   printSettingInteger("wss_window", this->wssWindow);
+   printSettingInteger("perf_top_processes", this->perfTopProcesses);
+   #endif
 
    printSettingString("header_layout", HeaderLayout_getName(this->hLayout));
    for (unsigned int i = 0; i < HeaderLayout_getColumns(this->hLayout); i++) {
@@ -824,6 +848,12 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
    #ifdef HAVE_LIBHWLOC
    this->topologyAffinity = false;
    #endif
+   #ifdef HTOP_LINUX
+   this->ussSamplePages = DEFAULT_USS_SAMPLE_PAGES;
+   this->ussConfidence = DEFAULT_USS_CONFIDENCE;
+   this->wssWindow = DEFAULT_WSS_WINDOW;
+   this->perfTopProcesses = DEFAULT_PERF_TOP_PROCESSES;
+   #endif
 
    this->screens = xCalloc(Platform_numberOfDefaultScreens, sizeof(ScreenSettings*));
    this->nScreens = 0;
@@ -868,6 +898,7 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
 #endif
    this->changed = false;
    this->delay = DEFAULT_DELAY;
+   this->warmStartDelay = DEFAULT_WARM_START_DELAY;
 
    bool ok = Settings_read(this, this->filename, host, /*checkWritability*/true);
    if (!ok && legacyDotfile) {
@@ -19,6 +19,11 @@ in the source distribution for its full text.
 
 
 #define DEFAULT_DELAY 15
+#define DEFAULT_WARM_START_DELAY 2
+#define DEFAULT_USS_SAMPLE_PAGES 512
+#define DEFAULT_USS_CONFIDENCE 95
+#define DEFAULT_WSS_WINDOW 10
+#define DEFAULT_PERF_TOP_PROCESSES 16
 
 #define CONFIG_READER_MIN_VERSION 3
 
@@ -72,6 +77,7 @@ typedef struct Settings_ {
 
    int colorScheme;
    int delay;
+   int warmStartDelay;
 
    bool countCPUsFromOne;
    bool detailedCPUTime;
@@ -109,6 +115,12 @@ typedef struct Settings_ {
    #ifdef HAVE_LIBHWLOC
    bool topologyAffinity;
    #endif
+   #ifdef HTOP_LINUX
+   int ussSamplePages;   /* resident pages sampled per process for the USS estimate */
+   int ussConfidence;    /* confidence level of its error bound, in percent */
+   int wssWindow;        /* seconds between marking pages idle and checking them */
+   int perfTopProcesses; /* processes or cgroups with the most CPU usage given performance counters */
+   #endif
 
    bool changed;
    uint64_t lastUpdate;
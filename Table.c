@@ -11,6 +11,7 @@ in the source distribution for its full text.
 #include "Table.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -28,6 +29,7 @@ Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
    this->displayList = Vector_new(klass, false, VECTOR_DEFAULT_SIZE);
    this->table = Hashtable_new(200, false);
    this->needsSort = true;
+   this->sortedRows = -1;
    this->following = -1;
    this->host = host;
    return this;
@@ -186,11 +188,44 @@ static void Table_buildTree(Table* this) {
    }
 
    this->needsSort = false;
+   this->sortedRows = -1;
 
    // Check consistency of the built structures
    assert(Vector_size(this->displayList) == vsize); (void)vsize;
 }
 
+// In flat mode only the rows that end up in the panel viewport need to be
+// in their final order.  Returns how many leading rows to sort, leaving one
+// page of look-ahead for scrolling; INT_MAX if the full order is required.
+static int Table_topRowsLimit(const Table* this) {
+   const Panel* panel = this->panel;
+   if (!panel || panel->h <= 0 || this->following != -1)
+      return INT_MAX;
+
+   int currSize = Panel_size(panel);
+   int currPos = Panel_getSelectedIndex(panel);
+   if (currPos > 0 && currPos == currSize - 1)
+      return INT_MAX;  // last row stays selected, see Table_rebuildPanel
+
+   return MAXIMUM(panel->scrollV, currPos) + 2 * panel->h;
+}
+
+// Extends the sorted prefix of a top-N sorted flat display list
+static void Table_sortMoreRows(Table* this, int count) {
+   int start = this->sortedRows;
+   int size = Vector_size(this->rows);
+   if (count >= size - start) {
+      Vector_partialSort(this->rows, start, size - start);
+      this->sortedRows = -1;
+   } else {
+      Vector_partialSort(this->rows, start, count);
+      this->sortedRows = start + count;
+   }
+
+   for (int i = start; i < size; i++)
+      Vector_set(this->displayList, i, Vector_get(this->rows, i));
+}
+
 void Table_updateDisplayList(Table* this) {
    const Settings* settings = this->host->settings;
 
@@ -198,8 +233,19 @@ void Table_updateDisplayList(Table* this) {
       if (this->needsSort)
          Table_buildTree(this);
    } else {
-      if (this->needsSort)
-         Vector_insertionSort(this->rows);
+      if (this->needsSort) {
+         int limit = Table_topRowsLimit(this);
+         if (limit < Vector_size(this->rows) / 2) {
+            Vector_partialSort(this->rows, 0, limit);
+            this->sortedRows = limit;
+         } else if (this->sortedRows != -1) {
+            // rows beyond the previous top-N are unordered, insertion sort would be quadratic
+            Vector_quickSort(this->rows);
+            this->sortedRows = -1;
+         } else {
+            Vector_insertionSort(this->rows);
+         }
+      }
       Vector_prune(this->displayList);
       int size = Vector_size(this->rows);
       for (int i = 0; i < size; i++)
@@ -229,12 +275,27 @@ void Table_collapseAllBranches(Table* this) {
    }
 }
 
+// Flags the rows in the viewport, with a page of margin in either direction
+// for scrolling, so scans can skip data that is only needed for display
+static void Table_markViewport(Table* this) {
+   Panel* panel = this->panel;
+   int selected = Panel_getSelectedIndex(panel);
+   int first = MAXIMUM(MINIMUM(panel->scrollV, selected) - panel->h, 0);
+   int last = MINIMUM(MAXIMUM(panel->scrollV, selected) + 2 * panel->h, Panel_size(panel));
+
+   for (int i = first; i < last; i++) {
+      Row* row = (Row*) Panel_get(panel, i);
+      row->inViewport = true;
+   }
+}
+
 void Table_rebuildPanel(Table* this) {
    Table_updateDisplayList(this);
 
    const int currPos = Panel_getSelectedIndex(this->panel);
    const int currScrollV = this->panel->scrollV;
    const int currSize = Panel_size(this->panel);
+   const int limit = this->host->settings->ss->treeView ? -1 : Table_topRowsLimit(this);
 
    Panel_prune(this->panel);
 
@@ -253,7 +314,12 @@ void Table_rebuildPanel(Table* this) {
    int idx = 0;
 
    for (int i = 0; i < rowCount; i++) {
+      /* Hidden and filtered rows can leave the viewport short of top-N sorted ones */
+      if (i == this->sortedRows && idx < limit)
+         Table_sortMoreRows(this, limit == INT_MAX ? INT_MAX : MAXIMUM(limit - idx, this->sortedRows));
+
       Row* row = (Row*) Vector_get(this->displayList, i);
+      row->inViewport = false;
 
       if ( !row->show || (Row_matchesFilter(row, this) == true) )
          continue;
@@ -284,6 +350,8 @@ void Table_rebuildPanel(Table* this) {
 
       this->panel->scrollV = currScrollV;
    }
+
+   Table_markViewport(this);
 }
 
 void Table_printHeader(const Settings* settings, RichString* header) {
@@ -33,6 +33,8 @@ typedef struct Table_ {
    struct Machine_* host;
    const char* incFilter;
    bool needsSort;
+   int sortedRows;        /* -1 if all rows are in sort order, otherwise only this many
+                             leading ones are (flat top-N mode, see Table_updateDisplayList) */
    int following;         /* -1 or row being visually tracked in the user interface */
 
    struct Panel_* panel;
@@ -42,12 +44,14 @@ typedef Table* (*Table_New)(const struct Machine_*);
 typedef void (*Table_ScanPrepare)(Table* this);
 typedef void (*Table_ScanIterate)(Table* this);
 typedef void (*Table_ScanCleanup)(Table* this);
+typedef bool (*Table_ScanReveal)(Table* this);
 
 typedef struct TableClass_ {
    const ObjectClass super;
    const Table_ScanPrepare prepare;
    const Table_ScanIterate iterate;
    const Table_ScanCleanup cleanup;
+   const Table_ScanReveal reveal;  /* optional; adds rows left out of the last scan that a view change has revealed */
 } TableClass;
 
 #define As_Table(this_)  ((const TableClass*)((this_)->super.klass))
@@ -55,6 +59,7 @@ typedef struct TableClass_ {
 #define Table_scanPrepare(t_)  (As_Table(t_)->prepare ? (As_Table(t_)->prepare(t_)) : Table_prepareEntries(t_))
 #define Table_scanIterate(t_)  (As_Table(t_)->iterate(t_))  /* mandatory; must have a custom iterate method */
 #define Table_scanCleanup(t_)  (As_Table(t_)->cleanup ? (As_Table(t_)->cleanup(t_)) : Table_cleanupEntries(t_))
+#define Table_scanReveal(t_)   (As_Table(t_)->reveal ? (As_Table(t_)->reveal(t_)) : false)
 
 Table* Table_init(Table* this, const ObjectClass* klass, struct Machine_* host);
 
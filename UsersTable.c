@@ -9,36 +9,319 @@ in the source distribution for its full text.
 
 #include "UsersTable.h"
 
+#include <errno.h>
+#include <pthread.h>
 #include <pwd.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include "XUtils.h"
+#include "generic/gettime.h"
 
 
+#define PASSWD_FILE "/etc/passwd"
+
+/* re-stat the passwd file at most this often */
+#define PASSWD_CHECK_INTERVAL_MS 1000
+
+typedef struct UsersResolverEntry_ {
+   unsigned int uid;
+   char* name;            /* NULL if NSS does not know the uid */
+} UsersResolverEntry;
+
+/*
+ * State shared with the resolver thread, guarded by lock.  The hashtables
+ * of the users table are only ever touched by the UI thread.
+ */
+typedef struct UsersResolver_ {
+   pthread_mutex_t lock;
+   pthread_cond_t wakeup;
+   pthread_t thread;
+
+   unsigned int* pending;
+   size_t nPending;
+   size_t pendingCapacity;
+
+   UsersResolverEntry* resolved;
+   size_t nResolved;
+   size_t resolvedCapacity;
+
+   bool busy;             /* a lookup is in progress */
+   bool stop;
+   bool detached;         /* the thread frees this when its lookup returns */
+} UsersResolver;
+
+static char UsersTable_mark;
+
+static void UsersResolver_free(UsersResolver* this) {
+   for (size_t i = 0; i < this->nResolved; i++)
+      free(this->resolved[i].name);
+   free(this->resolved);
+   free(this->pending);
+   pthread_cond_destroy(&this->wakeup);
+   pthread_mutex_destroy(&this->lock);
+   free(this);
+}
+
+static char* UsersResolver_lookup(unsigned int uid) {
+   long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+   size_t bufferSize = size > 0 ? (size_t) size : 1024;
+   char* buffer = xMalloc(bufferSize);
+   char* name = NULL;
+
+   for (;;) {
+      struct passwd pwd;
+      struct passwd* result = NULL;
+      int err = getpwuid_r(uid, &pwd, buffer, bufferSize, &result);
+      if (err == ERANGE && bufferSize < 1024 * 1024) {
+         bufferSize *= 2;
+         buffer = xRealloc(buffer, bufferSize);
+         continue;
+      }
+      if (err == 0 && result)
+         name = xStrdup(result->pw_name);
+      break;
+   }
+
+   free(buffer);
+   return name;
+}
+
+static void* UsersResolver_run(void* data) {
+   UsersResolver* this = data;
+
+   pthread_mutex_lock(&this->lock);
+   while (!this->stop) {
+      if (this->nPending == 0) {
+         pthread_cond_wait(&this->wakeup, &this->lock);
+         continue;
+      }
+
+      unsigned int uid = this->pending[--this->nPending];
+      this->busy = true;
+      pthread_mutex_unlock(&this->lock);
+
+      char* name = UsersResolver_lookup(uid);
+
+      pthread_mutex_lock(&this->lock);
+      this->busy = false;
+      if (this->nResolved == this->resolvedCapacity) {
+         this->resolvedCapacity = this->resolvedCapacity ? this->resolvedCapacity * 2 : 16;
+         this->resolved = xReallocArray(this->resolved, this->resolvedCapacity, sizeof(*this->resolved));
+      }
+      this->resolved[this->nResolved++] = (UsersResolverEntry) { .uid = uid, .name = name };
+   }
+
+   bool detached = this->detached;
+   pthread_mutex_unlock(&this->lock);
+
+   if (detached)
+      UsersResolver_free(this);
+
+   return NULL;
+}
+
+static UsersResolver* UsersResolver_new(void) {
+   UsersResolver* this = xCalloc(1, sizeof(UsersResolver));
+   pthread_mutex_init(&this->lock, NULL);
+   pthread_cond_init(&this->wakeup, NULL);
+
+   if (pthread_create(&this->thread, NULL, UsersResolver_run, this) != 0) {
+      UsersResolver_free(this);
+      return NULL;
+   }
+
+   return this;
+}
+
+static void UsersResolver_delete(UsersResolver* this) {
+   pthread_mutex_lock(&this->lock);
+   this->stop = true;
+   /* do not wait for a lookup that may block for long */
+   this->detached = this->busy;
+   pthread_cond_signal(&this->wakeup);
+   pthread_mutex_unlock(&this->lock);
+
+   if (this->detached) {
+      pthread_detach(this->thread);
+   } else {
+      pthread_join(this->thread, NULL);
+      UsersResolver_free(this);
+   }
+}
+
 UsersTable* UsersTable_new(void) {
    UsersTable* this;
-   this = xMalloc(sizeof(UsersTable));
+   this = xCalloc(1, sizeof(UsersTable));
    this->users = Hashtable_new(10, true);
+   this->unknown = Hashtable_new(10, false);
+   this->queued = Hashtable_new(10, false);
+   this->passwd = Hashtable_new(64, true);
    return this;
 }
 
 void UsersTable_delete(UsersTable* this) {
+   if (this->resolver)
+      UsersResolver_delete(this->resolver);
+
+   Hashtable_delete(this->passwd);
+   Hashtable_delete(this->queued);
+   Hashtable_delete(this->unknown);
    Hashtable_delete(this->users);
    free(this);
 }
 
+static void UsersTable_parsePasswd(UsersTable* this, FILE* fp) {
+   Hashtable_clear(this->passwd);
+
+   char* line;
+   while ((line = String_readLine(fp)) != NULL) {
+      /* name:password:uid:gid:gecos:dir:shell */
+      char* sep = strchr(line, ':');
+      if (!sep || sep == line || line[0] == '+' || line[0] == '-')
+         goto next;
+
+      sep = strchr(sep + 1, ':');
+      if (!sep)
+         goto next;
+
+      char* end;
+      unsigned long uid = strtoul(sep + 1, &end, 10);
+      if (end == sep + 1 || *end != ':' || uid > UINT32_MAX)
+         goto next;
+
+      /* keep the first entry like getpwuid(3) does */
+      if (!Hashtable_get(this->passwd, uid)) {
+         *strchr(line, ':') = '\0';
+         Hashtable_put(this->passwd, uid, xStrdup(line));
+      }
+
+next:
+      free(line);
+   }
+}
+
+static void UsersTable_checkPasswd(UsersTable* this) {
+   uint64_t now;
+   Generic_gettime_monotonic(&now);
+   if (this->passwdCheckMs && now - this->passwdCheckMs < PASSWD_CHECK_INTERVAL_MS)
+      return;
+
+   this->passwdCheckMs = now;
+
+   struct stat sb;
+   if (stat(PASSWD_FILE, &sb) != 0)
+      return;
+
+   if (sb.st_ino == this->passwdIno && sb.st_size == this->passwdSize && sb.st_mtime == this->passwdMtime)
+      return;
+
+   FILE* fp = fopen(PASSWD_FILE, "r");
+   if (!fp)
+      return;
+
+   UsersTable_parsePasswd(this, fp);
+   fclose(fp);
+
+   this->passwdIno = sb.st_ino;
+   this->passwdSize = sb.st_size;
+   this->passwdMtime = sb.st_mtime;
+
+   /* users may have been added */
+   Hashtable_clear(this->unknown);
+}
+
+/* Takes over the names the resolver thread found since the last call */
+static void UsersTable_collectNSS(UsersTable* this) {
+   UsersResolver* resolver = this->resolver;
+   if (!resolver)
+      return;
+
+   pthread_mutex_lock(&resolver->lock);
+   UsersResolverEntry* resolved = resolver->resolved;
+   size_t nResolved = resolver->nResolved;
+   resolver->resolved = NULL;
+   resolver->nResolved = 0;
+   resolver->resolvedCapacity = 0;
+   pthread_mutex_unlock(&resolver->lock);
+
+   for (size_t i = 0; i < nResolved; i++) {
+      unsigned int uid = resolved[i].uid;
+      Hashtable_remove(this->queued, uid);
+
+      if (!resolved[i].name) {
+         Hashtable_put(this->unknown, uid, &UsersTable_mark);
+      } else if (Hashtable_get(this->users, uid)) {
+         free(resolved[i].name);
+      } else {
+         Hashtable_put(this->users, uid, resolved[i].name);
+      }
+   }
+
+   free(resolved);
+}
+
+/* Leaves the numeric uid shown until the resolver thread found its name */
+static char* UsersTable_lookupNSS(UsersTable* this, unsigned int uid) {
+   if (Hashtable_get(this->queued, uid))
+      return NULL;
+
+   if (!this->resolver)
+      this->resolver = UsersResolver_new();
+
+   UsersResolver* resolver = this->resolver;
+   if (!resolver) {
+      /* no thread to spare, look it up in place */
+      char* name = UsersResolver_lookup(uid);
+      if (name)
+         Hashtable_put(this->users, uid, name);
+      else
+         Hashtable_put(this->unknown, uid, &UsersTable_mark);
+      return name;
+   }
+
+   Hashtable_put(this->queued, uid, &UsersTable_mark);
+
+   pthread_mutex_lock(&resolver->lock);
+   if (resolver->nPending == resolver->pendingCapacity) {
+      resolver->pendingCapacity = resolver->pendingCapacity ? resolver->pendingCapacity * 2 : 16;
+      resolver->pending = xReallocArray(resolver->pending, resolver->pendingCapacity, sizeof(*resolver->pending));
+   }
+   resolver->pending[resolver->nPending++] = uid;
+   pthread_cond_signal(&resolver->wakeup);
+   pthread_mutex_unlock(&resolver->lock);
+
+   return NULL;
+}
+
 char* UsersTable_getRef(UsersTable* this, unsigned int uid) {
    char* name = Hashtable_get(this->users, uid);
-   if (name == NULL) {
-      const struct passwd* userData = getpwuid(uid);
-      if (userData != NULL) {
-         name = xStrdup(userData->pw_name);
-         Hashtable_put(this->users, uid, name);
-      }
+   if (name)
+      return name;
+
+   UsersTable_collectNSS(this);
+
+   name = Hashtable_get(this->users, uid);
+   if (name)
+      return name;
+
+   UsersTable_checkPasswd(this);
+
+   const char* entry = Hashtable_get(this->passwd, uid);
+   if (entry) {
+      name = xStrdup(entry);
+      Hashtable_put(this->users, uid, name);
+      return name;
    }
-   return name;
+
+   if (Hashtable_get(this->unknown, uid))
+      return NULL;
+
+   return UsersTable_lookupNSS(this, uid);
 }
 
 inline void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData) {
@@ -7,11 +7,29 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
 #include "Hashtable.h"
 
 
+struct UsersResolver_;
+
 typedef struct UsersTable_ {
-   Hashtable* users;
+   Hashtable* users;      /* uid -> user name of the uids looked up, entries are never replaced */
+   Hashtable* unknown;    /* negative cache of uids without any passwd entry */
+   Hashtable* queued;     /* uids waiting for the resolver thread */
+
+   /* /etc/passwd parse cache, validated by inode, size and mtime */
+   Hashtable* passwd;
+   ino_t passwdIno;
+   off_t passwdSize;
+   time_t passwdMtime;
+   uint64_t passwdCheckMs;
+
+   /* NSS lookups (sssd, LDAP, ...) may block, so they run on a thread of their own */
+   struct UsersResolver_* resolver;
 } UsersTable;
 
 UsersTable* UsersTable_new(void);
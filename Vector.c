@@ -128,6 +128,22 @@ static void quickSort(Object** array, int left, int right, Object_Compare compar
    quickSort(array, pivotNewIndex + 1, right, compare);
 }
 
+// Quickselect variant: only the positions up to `last` end up in order,
+// the remaining ones are partitioned (all greater or equal) but unordered.
+static void partialQuickSort(Object** array, int left, int right, int last, Object_Compare compare) {
+   while (left < right) {
+      int pivotIndex = left + (right - left) / 2;
+      int pivotNewIndex = partition(array, left, right, pivotIndex, compare);
+      if (pivotNewIndex > last) {
+         right = pivotNewIndex - 1;
+         continue;
+      }
+
+      quickSort(array, left, pivotNewIndex - 1, compare);
+      left = pivotNewIndex + 1;
+   }
+}
+
 // If I were to use only one sorting algorithm for both cases, it would probably be this one:
 /*
 
@@ -174,6 +190,16 @@ void Vector_quickSortCustomCompare(Vector* this, Object_Compare compare) {
    assert(Vector_isConsistent(this));
 }
 
+void Vector_partialSort(Vector* this, int start, int count) {
+   assert(this->type->compare);
+   assert(start >= 0);
+   assert(count >= 0);
+   assert(Vector_isConsistent(this));
+   if (count > 0)
+      partialQuickSort(this->array, start, this->items - 1, start + count - 1, this->type->compare);
+   assert(Vector_isConsistent(this));
+}
+
 void Vector_insertionSort(Vector* this) {
    assert(this->type->compare);
    assert(Vector_isConsistent(this));
@@ -40,6 +40,10 @@ static inline void Vector_quickSort(Vector* this) {
    Vector_quickSortCustomCompare(this, this->type->compare);
 }
 
+/* Sort only the first `count` items starting at `start`; the items after
+   them compare greater or equal but are left in no particular order */
+void Vector_partialSort(Vector* this, int start, int count);
+
 void Vector_insertionSort(Vector* this);
 
 void Vector_insert(Vector* this, int idx, void* data_);
@@ -24,6 +24,13 @@ in the source distribution for its full text.
 #include "Macros.h"
 
 
+#ifdef HTOP_BENCH
+unsigned long long XUtils_allocations;
+#define countAllocation() (XUtils_allocations++)
+#else
+#define countAllocation() ((void) 0)
+#endif
+
 void fail(void) {
    CRT_done();
    abort();
@@ -33,6 +40,7 @@ void fail(void) {
 
 void* xMalloc(size_t size) {
    assert(size > 0);
+   countAllocation();
    void* data = malloc(size);
    if (!data) {
       fail();
@@ -55,6 +63,7 @@ void* xCalloc(size_t nmemb, size_t size) {
    if (SIZE_MAX / nmemb < size) {
       fail();
    }
+   countAllocation();
    void* data = calloc(nmemb, size);
    if (!data) {
       fail();
@@ -64,6 +73,7 @@ void* xCalloc(size_t nmemb, size_t size) {
 
 void* xRealloc(void* ptr, size_t size) {
    assert(size > 0);
+   countAllocation();
    void* data = realloc(ptr, size);
    if (!data) {
       /* free'ing ptr here causes an indirect memory leak if pointers
@@ -239,6 +249,7 @@ size_t strnlen(const char* str, size_t maxLen) {
 int xAsprintf(char** strp, const char* fmt, ...) {
    *strp = NULL;
 
+   countAllocation();
    va_list vl;
    va_start(vl, fmt);
    int r = vasprintf(strp, fmt, vl);
@@ -270,6 +281,7 @@ int xSnprintf(char* buf, size_t len, const char* fmt, ...) {
 }
 
 char* xStrdup(const char* str) {
+   countAllocation();
    char* data = strdup(str);
    if (!data) {
       fail();
@@ -286,6 +298,7 @@ void free_and_xStrdup(char** ptr, const char* str) {
 }
 
 char* xStrndup(const char* str, size_t len) {
+   countAllocation();
    char* data = strndup(str, len);
    if (!data) {
       fail();
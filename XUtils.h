@@ -28,6 +28,11 @@ in the source distribution for its full text.
 ATTR_NORETURN
 void fail(void);
 
+#ifdef HTOP_BENCH
+/* Number of allocations done through the x* wrappers, reported by htop-bench */
+extern unsigned long long XUtils_allocations;
+#endif
+
 ATTR_RETNONNULL ATTR_MALLOC ATTR_ALLOC_SIZE1(1)
 void* xMalloc(size_t size);
 
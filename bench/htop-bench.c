@@ -0,0 +1,254 @@
+/*
+htop - bench/htop-bench.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+/*
+ * Drives the scan and display list pipeline of htop without a terminal
+ * and reports the time and the number of allocations of each phase.
+ * Usually run through "make bench" on a tree written by htop-genprocfs.
+ */
+
+#include "config.h" // IWYU pragma: keep
+
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Action.h"
+#include "CRT.h"
+#include "CommandLine.h"
+#include "DynamicColumn.h"
+#include "DynamicMeter.h"
+#include "DynamicScreen.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "MainPanel.h"
+#include "Object.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Settings.h"
+#include "Table.h"
+#include "UsersTable.h"
+#include "XUtils.h"
+
+
+const char* program = "htop-bench";
+
+/* no terminal is set up, but building command lines looks up attributes */
+static int Bench_colors[LAST_COLORELEMENT];
+
+typedef enum BenchPhase_ {
+   PHASE_MACHINE_SCAN,
+   PHASE_SCAN_TABLES,
+   PHASE_UPDATE_DISPLAY_LIST,
+   PHASE_REBUILD_PANEL,
+   LAST_PHASE
+} BenchPhase;
+
+static const char* const BenchPhase_names[LAST_PHASE] = {
+   [PHASE_MACHINE_SCAN] = "Machine_scan",
+   [PHASE_SCAN_TABLES] = "Machine_scanTables",
+   [PHASE_UPDATE_DISPLAY_LIST] = "Table_updateDisplayList",
+   [PHASE_REBUILD_PANEL] = "Table_rebuildPanel",
+};
+
+typedef struct BenchStats_ {
+   double totalMs;
+   double minMs;
+   double maxMs;
+   unsigned long long allocations;
+   unsigned int samples;
+} BenchStats;
+
+static double Bench_nowMs(void) {
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void Bench_record(BenchStats* stats, double ms, unsigned long long allocations) {
+   if (stats->samples == 0 || ms < stats->minMs)
+      stats->minMs = ms;
+   if (stats->samples == 0 || ms > stats->maxMs)
+      stats->maxMs = ms;
+   stats->totalMs += ms;
+   stats->allocations += allocations;
+   stats->samples++;
+}
+
+#define BENCH_PHASE(phase_, call_)                                          \
+   do {                                                                     \
+      unsigned long long allocations_ = XUtils_allocations;                 \
+      double start_ = Bench_nowMs();                                        \
+      call_;                                                                \
+      double ms_ = Bench_nowMs() - start_;                                  \
+      allocations_ = XUtils_allocations - allocations_;                     \
+      if (iteration == 0)                                                   \
+         Bench_record(&first[phase_], ms_, allocations_);                   \
+      else                                                                  \
+         Bench_record(&steady[phase_], ms_, allocations_);                  \
+   } while (0)
+
+static void Bench_report(const char* title, const BenchStats* stats) {
+   if (stats[0].samples == 0)
+      return;
+
+   printf("%s (%u iteration%s)\n", title, stats[0].samples, stats[0].samples == 1 ? "" : "s");
+   printf("   %-24s %10s %10s %10s %12s\n", "phase", "mean ms", "min ms", "max ms", "allocs/iter");
+   for (int i = 0; i < LAST_PHASE; i++) {
+      const BenchStats* s = &stats[i];
+      printf("   %-24s %10.3f %10.3f %10.3f %12llu\n", BenchPhase_names[i],
+             s->totalMs / s->samples, s->minMs, s->maxMs, s->allocations / s->samples);
+   }
+}
+
+static void Bench_usage(void) {
+   printf("Usage: %s [OPTIONS]\n"
+          "   -n --iterations=COUNT   Number of scans to run (default 10)\n"
+          "   -s --sort-key=COLUMN    Sort by COLUMN in list view\n"
+          "   -t --tree               Show the tree view\n"
+          "   -r --rows=ROWS          Height of the process panel (default 40)\n"
+          "   -h --help               Print this help screen\n", program);
+   Platform_longOptionsUsage(program);
+}
+
+int main(int argc, char** argv) {
+   int iterations = 10;
+   int rows = 40;
+   int sortKey = 0;
+   bool treeView = false;
+
+   const struct option long_opts[] = {
+      {"help",       no_argument,         0, 'h'},
+      {"iterations", required_argument,   0, 'n'},
+      {"sort-key",   required_argument,   0, 's'},
+      {"tree",       no_argument,         0, 't'},
+      {"rows",       required_argument,   0, 'r'},
+      PLATFORM_LONG_OPTIONS
+      {0, 0, 0, 0}
+   };
+
+   int opt, opti = 0;
+   while ((opt = getopt_long(argc, argv, "hn:s:tr:", long_opts, &opti)) != EOF) {
+      switch (opt) {
+         case 'h':
+            Bench_usage();
+            return 0;
+         case 'n':
+            iterations = atoi(optarg);
+            if (iterations < 1) {
+               fprintf(stderr, "Error: invalid iteration count \"%s\".\n", optarg);
+               return 1;
+            }
+            break;
+         case 's':
+            for (int j = 1; j < LAST_PROCESSFIELD; j++) {
+               if (Process_fields[j].name && String_eq(optarg, Process_fields[j].name)) {
+                  sortKey = j;
+                  break;
+               }
+            }
+            if (sortKey == 0) {
+               fprintf(stderr, "Error: invalid column \"%s\".\n", optarg);
+               return 1;
+            }
+            break;
+         case 't':
+            treeView = true;
+            break;
+         case 'r':
+            rows = atoi(optarg);
+            if (rows < 1) {
+               fprintf(stderr, "Error: invalid number of rows \"%s\".\n", optarg);
+               return 1;
+            }
+            break;
+         default:
+            if (Platform_getLongOption(opt, argc, argv) != STATUS_OK)
+               return 1;
+            break;
+      }
+   }
+
+   /* use the built-in defaults unless a configuration is given explicitly */
+   setenv("HTOPRC", "/nonexistent/htoprc", 0);
+   Settings_enableReadonly();
+
+   if (!Platform_init())
+      return 1;
+
+   CRT_colors = Bench_colors;
+
+   UsersTable* ut = UsersTable_new();
+   Hashtable* dm = DynamicMeters_new();
+   Hashtable* dc = DynamicColumns_new();
+   Hashtable* ds = DynamicScreens_new();
+
+   Machine* host = Machine_new(ut, (uid_t)-1);
+   ProcessTable* pt = ProcessTable_new(host, NULL);
+   Settings* settings = Settings_new(host, dm, dc, ds);
+   Machine_populateTablesFromSettings(host, settings, &pt->super);
+
+   settings->ss->treeView = treeView;
+   if (sortKey > 0)
+      ScreenSettings_setSortKey(settings->ss, sortKey);
+
+   MainPanel* panel = MainPanel_new();
+   Machine_setTablesPanel(host, (Panel*) panel);
+   Panel_resize((Panel*) panel, 200, rows);
+
+   State state = {
+      .host = host,
+      .mainPanel = panel,
+      .header = NULL,
+   };
+   MainPanel_setState(panel, &state);
+
+   Table* table = host->activeTable;
+
+   BenchStats first[LAST_PHASE] = { { 0 } };
+   BenchStats steady[LAST_PHASE] = { { 0 } };
+
+   for (int iteration = 0; iteration < iterations; iteration++) {
+      /* Machine_scanTables skips scans within the same millisecond */
+      uint64_t now;
+      do {
+         Platform_gettime_monotonic(&now);
+      } while (now <= host->monotonicMs);
+
+      BENCH_PHASE(PHASE_MACHINE_SCAN, Machine_scan(host));
+      BENCH_PHASE(PHASE_SCAN_TABLES, Machine_scanTables(host));
+      table->needsSort = true;
+      BENCH_PHASE(PHASE_UPDATE_DISPLAY_LIST, Table_updateDisplayList(table));
+      BENCH_PHASE(PHASE_REBUILD_PANEL, Table_rebuildPanel(table));
+
+      /* as in CommandLine_run, branches are collapsed after the first scan */
+      if (iteration == 0 && settings->ss->allBranchesCollapsed)
+         Table_collapseAllBranches(table);
+   }
+
+   printf("%d rows, %s view, %d visible\n", Vector_size(table->rows),
+          treeView ? "tree" : "list", Panel_size((Panel*) panel));
+   Bench_report("first scan", first);
+   Bench_report("steady state", steady);
+
+   Platform_done();
+
+   Machine_delete(host);
+   Object_delete(panel);
+   UsersTable_delete(ut);
+   Settings_delete(settings);
+   DynamicColumns_delete(dc);
+   DynamicMeters_delete(dm);
+   DynamicScreens_delete(ds);
+
+   return 0;
+}
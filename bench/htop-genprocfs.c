@@ -0,0 +1,460 @@
+/*
+htop - bench/htop-genprocfs.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+/*
+ * Writes a synthetic procfs and sysfs tree for htop-bench:
+ *
+ *    htop-genprocfs DIR [PROCESSES [THREADS [CPUS]]]
+ *
+ * creates DIR/proc and DIR/sys with the given number of processes,
+ * additional userland threads spread unevenly over them and CPUs.
+ * The content is deterministic, so runs on different hosts and
+ * revisions are comparable.
+ */
+
+#include "config.h" // IWYU pragma: keep
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "Macros.h"
+
+
+#define PF_KTHREAD 0x00200000
+
+typedef struct FakeProcess_ {
+   int pid;
+   int ppid;
+   int nThreads;     /* including the main thread */
+   int firstTid;     /* tids of the other threads follow consecutively */
+   bool kernel;
+   const char* name;
+} FakeProcess;
+
+static const char* const userNames[] = {
+   "bash", "sshd", "systemd", "postgres", "nginx", "java", "python3", "node",
+   "chrome", "containerd", "dockerd", "rsyslogd", "cron", "dbus-daemon", "Xorg",
+   "pipewire", "firefox", "redis-server", "mysqld", "gnome-shell",
+};
+
+static const char* const kernelNames[] = {
+   "kworker/0:1H", "ksoftirqd/0", "rcu_preempt", "migration/0", "kswapd0",
+   "jbd2/sda1-8", "kcompactd0", "khugepaged", "watchdogd", "irq/42-nvme0q1",
+};
+
+static const char* const cgroups[] = {
+   "/user.slice/user-1000.slice/session-2.scope",
+   "/user.slice/user-1000.slice/user@1000.service/app.slice/dbus.service",
+   "/system.slice/sshd.service",
+   "/system.slice/docker-4f0c2a9d81e3.scope",
+   "/system.slice/postgresql@16-main.service",
+   "/init.scope",
+};
+
+static const char* const libraries[] = {
+   "/usr/lib/x86_64-linux-gnu/libc.so.6",
+   "/usr/lib/x86_64-linux-gnu/libm.so.6",
+   "/usr/lib/x86_64-linux-gnu/libpthread.so.0",
+   "/usr/lib/x86_64-linux-gnu/libssl.so.3",
+   "/usr/lib/x86_64-linux-gnu/libz.so.1",
+   "/usr/lib/x86_64-linux-gnu/ld-linux-x86-64.so.2",
+};
+
+static uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+/* xorshift64*, deterministic across platforms */
+static uint64_t rnd(void) {
+   seed ^= seed >> 12;
+   seed ^= seed << 25;
+   seed ^= seed >> 27;
+   return seed * 0x2545F4914F6CDD1DULL;
+}
+
+static unsigned long long rndRange(unsigned long long max) {
+   return max ? rnd() % max : 0;
+}
+
+ATTR_NORETURN
+static void die(const char* what, const char* path) {
+   fprintf(stderr, "htop-genprocfs: %s %s: %s\n", what, path, strerror(errno));
+   exit(1);
+}
+
+ATTR_FORMAT(printf, 3, 4)
+static void formatPath(char* path, size_t size, const char* fmt, ...) {
+   va_list ap;
+   va_start(ap, fmt);
+   int n = vsnprintf(path, size, fmt, ap);
+   va_end(ap);
+
+   if (n < 0 || (size_t)n >= size) {
+      errno = ENAMETOOLONG;
+      die("path too long", fmt);
+   }
+}
+
+ATTR_FORMAT(printf, 1, 2)
+static void makeDir(const char* fmt, ...) {
+   char path[4096];
+   va_list ap;
+   va_start(ap, fmt);
+   int n = vsnprintf(path, sizeof(path), fmt, ap);
+   va_end(ap);
+
+   if (n < 0 || (size_t)n >= sizeof(path)) {
+      errno = ENAMETOOLONG;
+      die("path too long", fmt);
+   }
+
+   if (mkdir(path, 0755) < 0 && errno != EEXIST)
+      die("cannot create", path);
+}
+
+static FILE* openFile(const char* dir, const char* name) {
+   char path[4096];
+   formatPath(path, sizeof(path), "%s/%s", dir, name);
+
+   FILE* fp = fopen(path, "w");
+   if (!fp)
+      die("cannot write", path);
+   return fp;
+}
+
+ATTR_FORMAT(printf, 3, 4)
+static void writeFile(const char* dir, const char* name, const char* fmt, ...) {
+   FILE* fp = openFile(dir, name);
+   va_list ap;
+   va_start(ap, fmt);
+   vfprintf(fp, fmt, ap);
+   va_end(ap);
+   fclose(fp);
+}
+
+static void writeTaskFiles(const char* dir, const FakeProcess* p, int tid, unsigned int cpus) {
+   const bool mainThread = tid == p->pid;
+   const unsigned long long vsize = p->kernel ? 0 : 100000000ULL + rndRange(4000000000ULL);
+   const unsigned long long rss = p->kernel ? 0 : 200 + rndRange(200000);
+   const unsigned long long utime = rndRange(500000);
+   const unsigned long long stime = rndRange(100000);
+   const unsigned long long starttime = 100 + rndRange(1000000);
+   const int nice = rndRange(10) == 0 ? (int)rndRange(40) - 20 : 0;
+
+   writeFile(dir, "stat",
+      "%d (%s) %c %d %d %d %d %d %u %llu 0 %llu 0 %llu %llu 0 0 %d %d %d 0 %llu %llu %llu "
+      "18446744073709551615 94000000000000 94000000100000 140720000000000 0 0 0 0 0 0 "
+      "0 0 0 17 %u 0 0 %llu 0 0 94000000200000 94000000300000 94000000400000 "
+      "140720000100000 140720000200000 140720000200000 140720000300000 0\n",
+      tid, p->name, rndRange(50) == 0 ? 'R' : 'S', p->ppid, p->pid, p->pid,
+      p->kernel ? 0 : 34816, p->kernel ? -1 : p->pid,
+      p->kernel ? (unsigned int)(0x00208040 | PF_KTHREAD) : 0x00400100U,
+      rndRange(100000), rndRange(1000), utime, stime,
+      20 + nice, nice, p->nThreads, starttime, vsize, rss,
+      (unsigned int)rndRange(cpus), rndRange(100));
+
+   writeFile(dir, "statm", "%llu %llu %llu %llu 0 %llu 0\n",
+      vsize / 4096, rss, rss / 3, rndRange(2000), rss / 2);
+
+   writeFile(dir, "comm", "%s\n", p->name);
+
+   if (p->kernel) {
+      writeFile(dir, "cmdline", "%s", "");
+   } else {
+      FILE* fp = openFile(dir, "cmdline");
+      fprintf(fp, "/usr/bin/%s", p->name);
+      fputc('\0', fp);
+      for (unsigned long long i = rndRange(6); i > 0; i--) {
+         fprintf(fp, "--option-%llu=%llu", i, rndRange(100000));
+         fputc('\0', fp);
+      }
+      fclose(fp);
+   }
+
+   writeFile(dir, "status",
+      "Name:\t%s\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t%d\nNgid:\t0\nPid:\t%d\n"
+      "PPid:\t%d\nTracerPid:\t0\nUid:\t1000\t1000\t1000\t1000\nGid:\t1000\t1000\t1000\t1000\n"
+      "FDSize:\t64\nGroups:\t4 24 27 1000 \nNStgid:\t%d\nNSpid:\t%d\nNSpgid:\t%d\nNSsid:\t%d\n"
+      "Kthread:\t%d\n"
+      "VmPeak:\t%llu kB\nVmSize:\t%llu kB\nVmLck:\t0 kB\nVmPin:\t0 kB\nVmHWM:\t%llu kB\n"
+      "VmRSS:\t%llu kB\nRssAnon:\t%llu kB\nRssFile:\t%llu kB\nRssShmem:\t%llu kB\n"
+      "VmData:\t%llu kB\nVmStk:\t132 kB\nVmExe:\t%llu kB\nVmLib:\t%llu kB\nVmPTE:\t%llu kB\n"
+      "VmSwap:\t%llu kB\nHugetlbPages:\t0 kB\nCoreDumping:\t0\nTHP_enabled:\t1\n"
+      "Threads:\t%d\nSigQ:\t0/63158\nSigPnd:\t0000000000000000\nShdPnd:\t0000000000000000\n"
+      "SigBlk:\t0000000000000000\nSigIgn:\t0000000000001000\nSigCgt:\t0000000180004a03\n"
+      "CapInh:\t0000000000000000\nCapPrm:\t0000000000000000\nCapEff:\t0000000000000000\n"
+      "CapBnd:\t000001ffffffffff\nCapAmb:\t0000000000000000\nNoNewPrivs:\t0\nSeccomp:\t0\n"
+      "Cpus_allowed:\tff\nCpus_allowed_list:\t0-%u\nMems_allowed_list:\t0\n"
+      "voluntary_ctxt_switches:\t%llu\nnonvoluntary_ctxt_switches:\t%llu\n",
+      p->name, p->pid, tid, p->ppid, p->pid, tid, p->pid, p->pid, p->kernel ? 1 : 0,
+      vsize / 1024, vsize / 1024, rss * 4, rss * 4, rss * 3, rss, rss / 8,
+      vsize / 4096, rndRange(4000), rndRange(40000), rndRange(1000),
+      rndRange(20) == 0 ? rndRange(100000) : 0,
+      p->nThreads, cpus - 1, rndRange(1000000), rndRange(10000));
+
+   writeFile(dir, "io",
+      "rchar: %llu\nwchar: %llu\nsyscr: %llu\nsyscw: %llu\nread_bytes: %llu\n"
+      "write_bytes: %llu\ncancelled_write_bytes: 0\n",
+      rndRange(1ULL << 32), rndRange(1ULL << 30), rndRange(100000), rndRange(100000),
+      rndRange(1ULL << 30), rndRange(1ULL << 28));
+
+   writeFile(dir, "cgroup", "0::%s\n", p->kernel ? "/" : cgroups[p->pid % (sizeof(cgroups) / sizeof(cgroups[0]))]);
+   writeFile(dir, "oom_score", "%llu\n", p->kernel ? 0 : rndRange(1000));
+   writeFile(dir, "schedstat", "%llu %llu %llu\n", utime * 10000000ULL, rndRange(1ULL << 32), rndRange(100000));
+
+   if (!mainThread)
+      return;
+
+   writeFile(dir, "smaps_rollup",
+      "55d0a0000000-7ffd00000000 ---p 00000000 00:00 0                          [rollup]\n"
+      "Rss:              %llu kB\nPss:              %llu kB\nPss_Dirty:        %llu kB\n"
+      "Pss_Anon:         %llu kB\nPss_File:         %llu kB\nPss_Shmem:        0 kB\n"
+      "Shared_Clean:     %llu kB\nShared_Dirty:     0 kB\nPrivate_Clean:    %llu kB\n"
+      "Private_Dirty:    %llu kB\nReferenced:       %llu kB\nAnonymous:        %llu kB\n"
+      "KSM:              0 kB\nLazyFree:         0 kB\nAnonHugePages:    0 kB\n"
+      "ShmemPmdMapped:   0 kB\nFilePmdMapped:    0 kB\nShared_Hugetlb:   0 kB\n"
+      "Private_Hugetlb:  0 kB\nSwap:             %llu kB\nSwapPss:          %llu kB\nLocked:           0 kB\n",
+      rss * 4, rss * 3, rss * 2, rss * 2, rss, rss, rss, rss * 2, rss * 4, rss * 3,
+      rss / 10, rss / 12);
+
+   FILE* maps = openFile(dir, "maps");
+   if (!p->kernel) {
+      unsigned long long address = 0x55d0a0000000ULL;
+      fprintf(maps, "%llx-%llx r-xp 00000000 08:01 %d /usr/bin/%s\n", address, address + 0x100000, 1000 + p->pid, p->name);
+      address = 0x7f0000000000ULL;
+      for (size_t i = 0; i < sizeof(libraries) / sizeof(libraries[0]); i++) {
+         fprintf(maps, "%llx-%llx r--p 00000000 08:01 %zu %s\n", address, address + 0x28000, 500 + i, libraries[i]);
+         fprintf(maps, "%llx-%llx r-xp 00028000 08:01 %zu %s\n", address + 0x28000, address + 0x1b0000, 500 + i, libraries[i]);
+         address += 0x200000;
+      }
+      fprintf(maps, "7ffd00000000-7ffd00021000 rw-p 00000000 00:00 0                          [stack]\n");
+   }
+   fclose(maps);
+
+   char fdinfo[4096];
+   formatPath(fdinfo, sizeof(fdinfo), "%s/fdinfo", dir);
+   makeDir("%s", fdinfo);
+   if (!p->kernel) {
+      for (int fd = 0; fd < 4; fd++) {
+         char name[16];
+         snprintf(name, sizeof(name), "%d", fd);
+         writeFile(fdinfo, name, "pos:\t%llu\nflags:\t02\nmnt_id:\t25\nino:\t%llu\n", rndRange(100000), rndRange(1000000));
+      }
+   }
+}
+
+static void writeProcess(const char* procDir, const FakeProcess* p, unsigned int cpus) {
+   char dir[4096];
+   formatPath(dir, sizeof(dir), "%s/%d", procDir, p->pid);
+   makeDir("%s", dir);
+   writeTaskFiles(dir, p, p->pid, cpus);
+
+   makeDir("%s/task", dir);
+   for (int i = 0; i < p->nThreads; i++) {
+      int tid = i == 0 ? p->pid : p->firstTid + i - 1;
+      char taskDir[4096];
+      formatPath(taskDir, sizeof(taskDir), "%s/task/%d", dir, tid);
+      makeDir("%s", taskDir);
+      writeTaskFiles(taskDir, p, tid, cpus);
+   }
+}
+
+static void writeMachineFiles(const char* root, const char* procDir, unsigned int cpus, int tasks, int running) {
+   unsigned long long* times = calloc((size_t)cpus * 8, sizeof(unsigned long long));
+   if (!times)
+      die("cannot allocate", "CPU times");
+
+   unsigned long long total[8] = { 0 };
+   for (unsigned int i = 0; i < cpus; i++) {
+      for (int j = 0; j < 8; j++) {
+         times[i * 8 + j] = rndRange(j == 3 ? 100000000ULL : 1000000ULL);
+         total[j] += times[i * 8 + j];
+      }
+   }
+
+   FILE* fp = openFile(procDir, "stat");
+   fprintf(fp, "cpu  %llu %llu %llu %llu %llu %llu %llu %llu 0 0\n", total[0], total[1], total[2], total[3], total[4], total[5], total[6], total[7]);
+   for (unsigned int i = 0; i < cpus; i++) {
+      const unsigned long long* v = &times[i * 8];
+      fprintf(fp, "cpu%u %llu %llu %llu %llu %llu %llu %llu %llu 0 0\n", i, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+   }
+   free(times);
+   fprintf(fp, "intr 123456789 0 9 0 0 0 0 0 0 0\nctxt 987654321\nbtime 1700000000\n"
+      "processes %d\nprocs_running %d\nprocs_blocked 0\nsoftirq 1234567 0 1 2 3 4 5 6 7 8 9\n", tasks, running);
+   fclose(fp);
+
+   writeFile(procDir, "meminfo",
+      "MemTotal:       65536000 kB\nMemFree:        12345678 kB\nMemAvailable:   40000000 kB\n"
+      "Buffers:          512000 kB\nCached:         20000000 kB\nSwapCached:          1000 kB\n"
+      "Active:         20000000 kB\nInactive:       18000000 kB\nShmem:            800000 kB\n"
+      "SReclaimable:    1200000 kB\nSUnreclaim:       300000 kB\n"
+      "SwapTotal:       8388604 kB\nSwapFree:        8000000 kB\nZswap:                 0 kB\nZswapped:              0 kB\n"
+      "HugePages_Total:       0\nHugePages_Free:        0\nHugepagesize:       2048 kB\n");
+
+   writeFile(procDir, "uptime", "123456.78 987654.32\n");
+   writeFile(procDir, "loadavg", "1.23 0.98 0.76 %d/%d %d\n", running, tasks, tasks + 1000);
+   writeFile(procDir, "diskstats",
+      "   8       0 sda 123456 1234 9876543 12345 65432 4321 8765432 54321 0 43210 66666 0 0 0 0\n"
+      "   8       1 sda1 120000 1200 9800000 12000 65000 4300 8700000 54000 0 43000 66000 0 0 0 0\n"
+      " 259       0 nvme0n1 223456 2234 19876543 22345 165432 14321 18765432 154321 0 143210 166666 0 0 0 0\n");
+   writeFile(procDir, "mounts", "/dev/sda1 / ext4 rw,relatime 0 0\n");
+
+   makeDir("%s/net", procDir);
+   char dir[4096];
+   formatPath(dir, sizeof(dir), "%s/net", procDir);
+   writeFile(dir, "dev",
+      "Inter-|   Receive                                                |  Transmit\n"
+      " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed\n"
+      "    lo: 123456789 123456 0 0 0 0 0 0 123456789 123456 0 0 0 0 0 0\n"
+      "  eth0: 987654321 765432 0 0 0 0 0 0 123456789 654321 0 0 0 0 0 0\n");
+
+   makeDir("%s/pressure", procDir);
+   formatPath(dir, sizeof(dir), "%s/pressure", procDir);
+   static const char* const pressure[] = { "cpu", "io", "memory" };
+   for (size_t i = 0; i < 3; i++)
+      writeFile(dir, pressure[i], "some avg10=1.50 avg60=1.20 avg300=0.90 total=123456789\nfull avg10=0.50 avg60=0.20 avg300=0.10 total=23456789\n");
+
+   makeDir("%s/tty", procDir);
+   formatPath(dir, sizeof(dir), "%s/tty", procDir);
+   writeFile(dir, "drivers",
+      "/dev/tty             /dev/tty        5       0 system:/dev/tty\n"
+      "/dev/console         /dev/console    5       1 system:console\n"
+      "pty_slave            /dev/pts      136 0-1048575 pty:slave\n"
+      "serial               /dev/ttyS       4 64-111 serial\n"
+      "/dev/vc/0            /dev/vc/0       4       0 system:vtmaster\n"
+      "unknown              /dev/tty        4 1-63 console\n");
+
+   makeDir("%s/sys", procDir);
+   makeDir("%s/sys/kernel", procDir);
+   makeDir("%s/sys/fs", procDir);
+   formatPath(dir, sizeof(dir), "%s/sys/kernel", procDir);
+   writeFile(dir, "pid_max", "4194304\n");
+   writeFile(dir, "sched_autogroup_enabled", "0\n");
+   formatPath(dir, sizeof(dir), "%s/sys/fs", procDir);
+   writeFile(dir, "file-nr", "12345\t0\t9223372036854775807\n");
+
+   fp = openFile(procDir, "cpuinfo");
+   for (unsigned int i = 0; i < cpus; i++)
+      fprintf(fp, "processor\t: %u\nvendor_id\t: GenuineIntel\nmodel name\t: Synthetic CPU\ncpu MHz\t\t: %llu.000\nphysical id\t: 0\ncore id\t\t: %u\n\n", i, 800 + rndRange(3000), i);
+   fclose(fp);
+
+   makeDir("%s/sys", root);
+   makeDir("%s/sys/devices", root);
+   makeDir("%s/sys/devices/system", root);
+   makeDir("%s/sys/devices/system/cpu", root);
+   for (unsigned int i = 0; i < cpus; i++) {
+      makeDir("%s/sys/devices/system/cpu/cpu%u", root, i);
+      makeDir("%s/sys/devices/system/cpu/cpu%u/cpufreq", root, i);
+      formatPath(dir, sizeof(dir), "%s/sys/devices/system/cpu/cpu%u", root, i);
+      writeFile(dir, "online", "1\n");
+      formatPath(dir, sizeof(dir), "%s/sys/devices/system/cpu/cpu%u/cpufreq", root, i);
+      writeFile(dir, "scaling_cur_freq", "%llu\n", 800000 + rndRange(3000000));
+   }
+}
+
+int main(int argc, char** argv) {
+   if (argc < 2 || argc > 5) {
+      fprintf(stderr, "Usage: %s DIR [PROCESSES [THREADS [CPUS]]]\n", argv[0]);
+      return 1;
+   }
+
+   const char* root = argv[1];
+   int processes = argc > 2 ? atoi(argv[2]) : 1000;
+   int threads = argc > 3 ? atoi(argv[3]) : 4000;
+   unsigned int cpus = argc > 4 ? (unsigned int)atoi(argv[4]) : 8;
+   if (processes < 3 || threads < 0 || cpus < 1) {
+      fprintf(stderr, "%s: need at least 3 processes and 1 CPU\n", argv[0]);
+      return 1;
+   }
+
+   char procDir[4096];
+   formatPath(procDir, sizeof(procDir), "%s/proc", root);
+   makeDir("%s", root);
+   makeDir("%s", procDir);
+
+   FakeProcess* table = calloc(processes, sizeof(FakeProcess));
+   if (!table)
+      return 1;
+
+   /* pid 1 is init, pid 2 kthreadd; about a tenth are kernel threads */
+   int nextPid = 1;
+   int userProcesses = 0;
+   for (int i = 0; i < processes; i++) {
+      FakeProcess* p = &table[i];
+      p->pid = nextPid;
+      nextPid += i < 1 ? 1 : 1 + (int)rndRange(3);
+      p->nThreads = 1;
+      if (i == 0) {
+         p->ppid = 0;
+         p->name = "systemd";
+      } else if (i == 1 || rndRange(10) == 0) {
+         p->kernel = true;
+         p->ppid = i == 1 ? 0 : 2;
+         p->name = i == 1 ? "kthreadd" : kernelNames[rndRange(sizeof(kernelNames) / sizeof(kernelNames[0]))];
+      } else {
+         /* parents are older user processes, which gives a tree of some depth */
+         const FakeProcess* parent;
+         do {
+            parent = &table[rndRange(i)];
+         } while (parent->kernel);
+         p->ppid = parent->pid;
+         p->name = userNames[rndRange(sizeof(userNames) / sizeof(userNames[0]))];
+         userProcesses++;
+      }
+   }
+
+   /* threads favour few processes, like real hosts with a handful of thread pools */
+   for (int t = 0; t < threads && userProcesses > 0; t++) {
+      FakeProcess* p;
+      do {
+         p = &table[rndRange(rndRange(processes) + 1)];
+      } while (p->kernel || p->pid == 1);
+      p->nThreads++;
+   }
+
+   for (int i = 0; i < processes; i++) {
+      FakeProcess* p = &table[i];
+      p->firstTid = nextPid;
+      nextPid += p->nThreads - 1;
+   }
+
+   int tasks = 0;
+   for (int i = 0; i < processes; i++) {
+      writeProcess(procDir, &table[i], cpus);
+      tasks += table[i].nThreads;
+   }
+
+   writeMachineFiles(root, procDir, cpus, tasks, 1 + (int)rndRange(cpus));
+
+   /* self is the first user process after init */
+   const FakeProcess* selfProcess = &table[0];
+   for (int i = 1; i < processes; i++) {
+      if (!table[i].kernel) {
+         selfProcess = &table[i];
+         break;
+      }
+   }
+
+   char self[4096];
+   formatPath(self, sizeof(self), "%s/self", procDir);
+   unlink(self);
+   char target[16];
+   snprintf(target, sizeof(target), "%d", selfProcess->pid);
+   if (symlink(target, self) < 0)
+      die("cannot create", self);
+
+   printf("%s: %d processes, %d tasks, %u CPUs\n", root, processes, tasks, cpus);
+
+   free(table);
+   return 0;
+}
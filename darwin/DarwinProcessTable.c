@@ -110,7 +110,7 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
          proc->super.state = STOPPED;
       }
 
-      if (proc->super.st_uid != ps[i].kp_eproc.e_ucred.cr_uid) {
+      if (proc->super.st_uid != ps[i].kp_eproc.e_ucred.cr_uid || !proc->super.user) {
          proc->super.st_uid = ps[i].kp_eproc.e_ucred.cr_uid;
          proc->super.user = UsersTable_getRef(host->usersTable, proc->super.st_uid);
       }
@@ -219,7 +219,7 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
          }
          // if there are reapers in the system, process can get reparented anytime
          Process_setParent(proc, kproc->ki_ppid);
-         if (proc->st_uid != kproc->ki_uid) {
+         if (proc->st_uid != kproc->ki_uid || !proc->user) {
             // some processes change users (eg. to lower privs)
             proc->st_uid = kproc->ki_uid;
             proc->user = UsersTable_getRef(host->usersTable, proc->st_uid);
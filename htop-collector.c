@@ -0,0 +1,219 @@
+/*
+htop - htop-collector.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+/*
+ * Scans the machine and its processes once per interval and publishes the
+ * result as a memory mapped snapshot, so any number of htop instances
+ * started with --attach share a single scan instead of each reading /proc.
+ */
+
+#include "config.h" // IWYU pragma: keep
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "CRT.h"
+#include "CommandLine.h"
+#include "DynamicColumn.h"
+#include "DynamicMeter.h"
+#include "DynamicScreen.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Settings.h"
+#include "UsersTable.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcess.h"
+#include "linux/Snapshot.h"
+
+
+const char* program = "htop-collector";
+
+/* no terminal is set up, but building command lines looks up attributes */
+static int Collector_colors[LAST_COLORELEMENT];
+
+static volatile sig_atomic_t Collector_stop = 0;
+
+static void Collector_handleSignal(int sgn) {
+   (void) sgn;
+   Collector_stop = 1;
+}
+
+/*
+ * Data read per process by walking its page tables or mappings, or set up
+ * per process in the kernel; only collected for the columns asked for
+ */
+#define COLLECTOR_EXPENSIVE_FLAGS (PROCESS_FLAG_LINUX_SMAPS | PROCESS_FLAG_LINUX_LRS_FIX | PROCESS_FLAG_LINUX_NUMA | \
+                                   PROCESS_FLAG_LINUX_USS | PROCESS_FLAG_LINUX_WSS | PROCESS_FLAG_LINUX_PERF | \
+                                   PROCESS_FLAG_LINUX_SCHEDLAT)
+
+static void Collector_usage(void) {
+   printf("Usage: %s [OPTIONS]\n"
+          "   -c --columns=COLUMNS    Also collect the data of these expensive columns (comma-separated names\n"
+          "                           as in htoprc, e.g. M_PSS,M_USS); the others are always collected\n"
+          "   -d --delay=DELAY        Set the delay between snapshots, in tenths of seconds (default 15)\n"
+          "   -o --output=FILE        Publish the snapshots in FILE (default " SNAPSHOT_DEFAULT_PATH ")\n"
+          "   -h --help               Print this help screen\n", program);
+   Platform_longOptionsUsage(program);
+}
+
+/* ORs the flags of a comma-separated list of column names into flags */
+static bool Collector_parseColumns(const char* list, uint32_t* flags) {
+   char** names = String_split(list, ',', NULL);
+   bool ok = true;
+   for (size_t i = 0; names[i]; i++) {
+      ProcessField field = 0;
+      for (ProcessField j = 1; j < LAST_PROCESSFIELD; j++) {
+         if (Process_fields[j].name && String_eq(Process_fields[j].name, names[i])) {
+            field = j;
+            break;
+         }
+      }
+      if (!field) {
+         fprintf(stderr, "Error: unknown column \"%s\".\n", names[i]);
+         ok = false;
+         break;
+      }
+      *flags |= Process_fields[field].flags;
+   }
+   String_freeArray(names);
+   return ok;
+}
+
+int main(int argc, char** argv) {
+   int delay = 15;
+   const char* output = SNAPSHOT_DEFAULT_PATH;
+   uint32_t expensiveFlags = 0;
+
+   const struct option long_opts[] = {
+      {"help",    no_argument,       0, 'h'},
+      {"columns", required_argument, 0, 'c'},
+      {"delay",   required_argument, 0, 'd'},
+      {"output",  required_argument, 0, 'o'},
+      PLATFORM_LONG_OPTIONS
+      {0, 0, 0, 0}
+   };
+
+   int opt, opti = 0;
+   while ((opt = getopt_long(argc, argv, "hc:d:o:", long_opts, &opti)) != EOF) {
+      switch (opt) {
+         case 'h':
+            Collector_usage();
+            return 0;
+         case 'c':
+            if (!Collector_parseColumns(optarg, &expensiveFlags))
+               return 1;
+            break;
+         case 'd':
+            delay = atoi(optarg);
+            if (delay < 1 || delay > 100) {
+               fprintf(stderr, "Error: invalid delay value \"%s\".\n", optarg);
+               return 1;
+            }
+            break;
+         case 'o':
+            output = optarg;
+            break;
+         default:
+            if (Platform_getLongOption(opt, argc, argv) != STATUS_OK)
+               return 1;
+            break;
+      }
+   }
+
+   /* use the built-in defaults unless a configuration is given explicitly */
+   setenv("HTOPRC", "/nonexistent/htoprc", 0);
+   Settings_enableReadonly();
+
+   if (!Platform_init())
+      return 1;
+
+   if (Snapshot_reader) {
+      /* the collector is the one publishing the snapshots */
+      fprintf(stderr, "Error: --attach is an option of htop.\n");
+      Platform_done();
+      return 1;
+   }
+
+   CRT_colors = Collector_colors;
+
+   UsersTable* ut = UsersTable_new();
+   Hashtable* dm = DynamicMeters_new();
+   Hashtable* dc = DynamicColumns_new();
+   Hashtable* ds = DynamicScreens_new();
+
+   Machine* host = Machine_new(ut, (uid_t)-1);
+   ProcessTable* pt = ProcessTable_new(host, NULL);
+   Settings* settings = Settings_new(host, dm, dc, ds);
+   Machine_populateTablesFromSettings(host, settings, &pt->super);
+
+   /* the viewers filter for themselves and have screens of their own, so
+      collect what any column may show unless it is expensive to gather */
+   ScreenSettings* ss = settings->ss;
+   ss->treeView = false;
+   settings->hideKernelThreads = false;
+   settings->hideUserlandThreads = false;
+   for (ProcessField i = 1; i < LAST_PROCESSFIELD; i++)
+      ss->flags |= Process_fields[i].flags;
+   ss->flags &= ~COLLECTOR_EXPENSIVE_FLAGS;
+   ss->flags |= expensiveFlags;
+
+   SnapshotWriter* writer = SnapshotWriter_new(output, (uint64_t)delay * 100, ss->flags);
+   if (!writer) {
+      Platform_done();
+      Machine_delete(host);
+      UsersTable_delete(ut);
+      Settings_delete(settings);
+      DynamicColumns_delete(dc);
+      DynamicMeters_delete(dm);
+      DynamicScreens_delete(ds);
+      return 1;
+   }
+
+   struct sigaction sa = { .sa_handler = Collector_handleSignal };
+   sigemptyset(&sa.sa_mask);
+   sigaction(SIGINT, &sa, NULL);
+   sigaction(SIGTERM, &sa, NULL);
+   signal(SIGPIPE, SIG_IGN);
+
+   const struct timespec interval = {
+      .tv_sec = delay / 10,
+      .tv_nsec = (delay % 10) * 100000000L,
+   };
+
+   while (!Collector_stop) {
+      Platform_gettime_realtime(&host->realtime, &host->realtimeMs);
+      Machine_scan(host);
+      Machine_scanTables(host);
+      SnapshotWriter_publish(writer, host);
+
+      struct timespec remaining = interval;
+      while (!Collector_stop && nanosleep(&remaining, &remaining) != 0 && errno == EINTR)
+         ;
+   }
+
+   SnapshotWriter_delete(writer);
+   Platform_done();
+
+   Machine_delete(host);
+   UsersTable_delete(ut);
+   Settings_delete(settings);
+   DynamicColumns_delete(dc);
+   DynamicMeters_delete(dm);
+   DynamicScreens_delete(ds);
+
+   return 0;
+}
@@ -0,0 +1,219 @@
+/*
+htop - linux/BacktraceSymbols.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/BacktraceSymbols.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+#include "linux/ProcessMaps.h"
+
+#ifdef HAVE_LIBIBERTY
+#include <libiberty/demangle.h>
+#endif
+
+
+/* functions kept over all objects before the cache starts over */
+#define BACKTRACE_SYMBOLS_MAX 65536
+
+void BacktraceSymbols_init(BacktraceSymbols* this) {
+   this->objects = Hashtable_new(64, false);
+   this->nSymbols = 0;
+   this->size = 16384;
+   this->buffer = xMalloc(this->size);
+   this->mappings = NULL;
+   this->nMappings = 0;
+   this->mappingsCapacity = 0;
+}
+
+static void BacktraceSymbols_freeSymbols(BacktraceObject* object) {
+   for (size_t i = 0; i < object->nSymbols; i++) {
+      free(object->symbols[i].name);
+      free(object->symbols[i].demangledName);
+   }
+   object->nSymbols = 0;
+}
+
+static void BacktraceSymbols_freeChain(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   BacktraceObject* object = value;
+   while (object) {
+      BacktraceObject* next = object->next;
+      BacktraceSymbols_freeSymbols(object);
+      free(object->symbols);
+      free(object->path);
+      free(object);
+      object = next;
+   }
+}
+
+static void BacktraceSymbols_forgetChain(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   for (BacktraceObject* object = value; object; object = object->next)
+      BacktraceSymbols_freeSymbols(object);
+}
+
+void BacktraceSymbols_done(BacktraceSymbols* this) {
+   Hashtable_foreach(this->objects, BacktraceSymbols_freeChain, NULL);
+   Hashtable_delete(this->objects);
+   free(this->mappings);
+   free(this->buffer);
+}
+
+static inline ht_key_t BacktraceSymbols_key(uint64_t dev, uint64_t inode) {
+   uint64_t mixed = (inode ^ (dev * 0x9E3779B97F4A7C15ULL));
+   return (ht_key_t) (mixed ^ (mixed >> 32));
+}
+
+static BacktraceObject* BacktraceSymbols_object(BacktraceSymbols* this, const ProcessMapping* mapping) {
+   ht_key_t key = BacktraceSymbols_key(mapping->dev, mapping->inode);
+   BacktraceObject* head = Hashtable_get(this->objects, key);
+   for (BacktraceObject* object = head; object; object = object->next) {
+      if (object->dev == mapping->dev && object->inode == mapping->inode)
+         return object;
+   }
+
+   BacktraceObject* object = xCalloc(1, sizeof(BacktraceObject));
+   object->dev = mapping->dev;
+   object->inode = mapping->inode;
+   object->path = xStrndup(mapping->path, mapping->pathLen);
+   const char* slash = strrchr(object->path, '/');
+   object->name = slash ? slash + 1 : object->path;
+   object->next = head;
+   Hashtable_put(this->objects, key, object);
+   return object;
+}
+
+bool BacktraceSymbols_readMaps(BacktraceSymbols* this, pid_t tid) {
+   char path[PATH_MAX];
+   LinuxMachine_procPath(path, sizeof(path), "/%d/maps", tid);
+
+   ssize_t length;
+   for (;;) {
+      length = xReadfile(path, this->buffer, this->size);
+      if (length < 0)
+         return false;
+      if ((size_t) length < this->size - 1)
+         break;
+
+      this->size *= 2;
+      this->buffer = xRealloc(this->buffer, this->size);
+   }
+
+   this->nMappings = 0;
+
+   const char* cursor = this->buffer;
+   const char* end = this->buffer + length;
+   ProcessMapping mapping;
+   while (ProcessMaps_nextFile(&cursor, end, &mapping)) {
+      if (!mapping.exec)
+         continue;
+
+      if (this->nMappings == this->mappingsCapacity) {
+         this->mappingsCapacity = this->mappingsCapacity ? this->mappingsCapacity * 2 : 64;
+         this->mappings = xReallocArray(this->mappings, this->mappingsCapacity, sizeof(*this->mappings));
+      }
+
+      BacktraceMapping* entry = &this->mappings[this->nMappings++];
+      entry->start = mapping.start;
+      entry->end = mapping.end;
+      entry->offset = mapping.offset;
+      entry->object = BacktraceSymbols_object(this, &mapping);
+   }
+
+   return true;
+}
+
+const BacktraceMapping* BacktraceSymbols_mapping(const BacktraceSymbols* this, uint64_t address) {
+   size_t low = 0;
+   size_t high = this->nMappings;
+   while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      const BacktraceMapping* mapping = &this->mappings[mid];
+      if (address < mapping->start) {
+         high = mid;
+      } else if (address >= mapping->end) {
+         low = mid + 1;
+      } else {
+         return mapping;
+      }
+   }
+   return NULL;
+}
+
+/* Index of the first symbol of an object ending after a file offset */
+static size_t BacktraceSymbols_search(const BacktraceObject* object, uint64_t offset) {
+   size_t low = 0;
+   size_t high = object->nSymbols;
+   while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (object->symbols[mid].end <= offset) {
+         low = mid + 1;
+      } else {
+         high = mid;
+      }
+   }
+   return low;
+}
+
+const BacktraceSymbol* BacktraceSymbols_find(const BacktraceMapping* mapping, uint64_t address) {
+   const BacktraceObject* object = mapping->object;
+   uint64_t offset = address - mapping->start + mapping->offset;
+
+   size_t i = BacktraceSymbols_search(object, offset);
+   if (i < object->nSymbols && object->symbols[i].start <= offset)
+      return &object->symbols[i];
+
+   return NULL;
+}
+
+const BacktraceSymbol* BacktraceSymbols_add(BacktraceSymbols* this, const BacktraceMapping* mapping, uint64_t start, uint64_t end, const char* name) {
+   if (this->nSymbols >= BACKTRACE_SYMBOLS_MAX) {
+      Hashtable_foreach(this->objects, BacktraceSymbols_forgetChain, NULL);
+      this->nSymbols = 0;
+   }
+
+   BacktraceObject* object = mapping->object;
+   uint64_t offset = mapping->offset - mapping->start;
+   start += offset;
+   end += offset;
+
+   size_t i = BacktraceSymbols_search(object, start);
+
+   /* clipped to its neighbours, should the unwinder report overlapping ranges */
+   if (i > 0)
+      start = MAXIMUM(start, object->symbols[i - 1].end);
+   if (i < object->nSymbols) {
+      if (object->symbols[i].start <= start)
+         return &object->symbols[i];
+      end = MINIMUM(end, object->symbols[i].start);
+   }
+   if (end <= start)
+      end = start + 1;
+
+   if (object->nSymbols == object->capacity) {
+      object->capacity = object->capacity ? object->capacity * 2 : 64;
+      object->symbols = xReallocArray(object->symbols, object->capacity, sizeof(*object->symbols));
+   }
+   memmove(&object->symbols[i + 1], &object->symbols[i], (object->nSymbols - i) * sizeof(*object->symbols));
+   object->nSymbols++;
+   this->nSymbols++;
+
+   BacktraceSymbol* symbol = &object->symbols[i];
+   symbol->start = start;
+   symbol->end = end;
+   symbol->name = xStrdup(name);
+   symbol->demangledName = NULL;
+#ifdef HAVE_LIBIBERTY
+   symbol->demangledName = cplus_demangle(name, DMGL_PARAMS | AUTO_DEMANGLING);
+#endif
+   return symbol;
+}
@@ -0,0 +1,81 @@
+#ifndef HEADER_BacktraceSymbols
+#define HEADER_BacktraceSymbols
+/*
+htop - linux/BacktraceSymbols.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+
+
+/*
+ * Function names of the frames of unwound stacks, kept by mapped file and
+ * offset in that file rather than by address, so they are shared between
+ * processes mapping the same library at different addresses and between
+ * the samples of the profiler. Each function is stored with the range of
+ * file offsets it covers, so any later address within it is resolved
+ * without asking the unwinder again.
+ */
+
+typedef struct BacktraceSymbol_ {
+   uint64_t start;                   /* file offsets covered by the function */
+   uint64_t end;
+   char* name;
+   char* demangledName;              /* NULL if not a mangled name */
+} BacktraceSymbol;
+
+/* A mapped executable or library, by device and inode */
+typedef struct BacktraceObject_ {
+   uint64_t dev;
+   uint64_t inode;
+   char* path;
+   const char* name;                 /* basename within path */
+   BacktraceSymbol* symbols;         /* sorted by start, not overlapping */
+   size_t nSymbols;
+   size_t capacity;
+   struct BacktraceObject_* next;    /* another object with the same key */
+} BacktraceObject;
+
+/* An executable mapping of the task being unwound */
+typedef struct BacktraceMapping_ {
+   uint64_t start;
+   uint64_t end;
+   uint64_t offset;                  /* file offset of start */
+   BacktraceObject* object;
+} BacktraceMapping;
+
+typedef struct BacktraceSymbols_ {
+   Hashtable* objects;               /* mixed dev and inode -> BacktraceObject chain */
+   size_t nSymbols;                  /* over all objects, the cache is emptied beyond a limit */
+
+   char* buffer;                     /* reused for reading maps */
+   size_t size;
+   BacktraceMapping* mappings;       /* of the task being unwound, sorted by address */
+   size_t nMappings;
+   size_t mappingsCapacity;
+} BacktraceSymbols;
+
+void BacktraceSymbols_init(BacktraceSymbols* this);
+
+void BacktraceSymbols_done(BacktraceSymbols* this);
+
+/* Reads the executable mappings of a task; false if its maps are not readable */
+bool BacktraceSymbols_readMaps(BacktraceSymbols* this, pid_t tid);
+
+/* Mapping of an address of the task last read, NULL for anonymous memory */
+const BacktraceMapping* BacktraceSymbols_mapping(const BacktraceSymbols* this, uint64_t address);
+
+/* Cached function at an address within a mapping, NULL if not seen before */
+const BacktraceSymbol* BacktraceSymbols_find(const BacktraceMapping* mapping, uint64_t address);
+
+/* Caches the function covering the addresses start to end of a mapping */
+const BacktraceSymbol* BacktraceSymbols_add(BacktraceSymbols* this, const BacktraceMapping* mapping, uint64_t start, uint64_t end, const char* name);
+
+#endif
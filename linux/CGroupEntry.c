@@ -0,0 +1,208 @@
+/*
+htop - linux/CGroupEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupEntry.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+CGroupEntry* CGroupEntry_new(const Machine* host, const Table* table) {
+   CGroupEntry* this = xCalloc(1, sizeof(CGroupEntry));
+   Object_setClass(this, Class(CGroupEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+
+   this->table = table;
+   this->percent_cpu = 0.0F;
+   this->io_read_rate = NAN;
+   this->io_write_rate = NAN;
+   this->memory_anon = ULLONG_MAX;
+   this->memory_file = ULLONG_MAX;
+   this->memory_wss = ULLONG_MAX;
+   this->pids_current = ULLONG_MAX;
+   this->cpu_some = NAN;
+   this->memory_some = NAN;
+   this->memory_full = NAN;
+   this->io_some = NAN;
+   this->io_full = NAN;
+   for (size_t i = 0; i < PERF_EVENT_COUNT; i++)
+      this->perf_rates[i] = NAN;
+
+   return this;
+}
+
+void CGroupEntry_done(CGroupEntry* this) {
+   free(this->path);
+   Row_done(&this->super);
+}
+
+static void CGroupEntry_delete(Object* cast) {
+   CGroupEntry* this = (CGroupEntry*) cast;
+   CGroupEntry_done(this);
+   free(this);
+}
+
+static void CGroupEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+   uint8_t width = column ? (uint8_t) MINIMUM(abs(column->width), DYNAMIC_MAX_COLUMN_WIDTH) : 5;
+
+   int local = LinuxDynamicColumn_field(settings, this->table, field);
+   switch (local) {
+   case CGROUP_NAME: Row_printLeftAlignedField(str, attr, this->path, width); return;
+   case CGROUP_PERCENT_CPU: Row_printPercentage(this->percent_cpu, buffer, n, width, &attr); break;
+   case CGROUP_CPU_USER: Row_printTime(str, this->user_usec / 10000, coloring); return;
+   case CGROUP_CPU_SYSTEM: Row_printTime(str, this->system_usec / 10000, coloring); return;
+   case CGROUP_NR_THROTTLED: Row_printCount(str, this->nr_throttled, coloring); return;
+   case CGROUP_THROTTLED_TIME: Row_printTime(str, this->throttled_usec / 10000, coloring); return;
+   case CGROUP_MEM_CURRENT: Row_printBytes(str, this->memory_current, coloring); return;
+   case CGROUP_MEM_ANON: Row_printBytes(str, this->memory_anon, coloring); return;
+   case CGROUP_MEM_FILE: Row_printBytes(str, this->memory_file, coloring); return;
+   case CGROUP_MEM_WSS: Row_printBytes(str, this->memory_wss, coloring); return;
+   case CGROUP_IO_READ_RATE: Row_printRate(str, this->io_read_rate, coloring); return;
+   case CGROUP_IO_WRITE_RATE: Row_printRate(str, this->io_write_rate, coloring); return;
+   case CGROUP_PIDS: Row_printCount(str, this->pids_current, coloring); return;
+   case CGROUP_CPU_PRESSURE: Row_printPercentage(this->cpu_some, buffer, n, width, &attr); break;
+   case CGROUP_MEMORY_PRESSURE_SOME: Row_printPercentage(this->memory_some, buffer, n, width, &attr); break;
+   case CGROUP_MEMORY_PRESSURE_FULL: Row_printPercentage(this->memory_full, buffer, n, width, &attr); break;
+   case CGROUP_IO_PRESSURE_SOME: Row_printPercentage(this->io_some, buffer, n, width, &attr); break;
+   case CGROUP_IO_PRESSURE_FULL: Row_printPercentage(this->io_full, buffer, n, width, &attr); break;
+   case CGROUP_PERF_IPC: {
+      double ipc = PerfCounters_ratio(this->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES);
+      if (isNonnegative(ipc)) {
+         xSnprintf(buffer, n, "%*.2f ", width, MINIMUM(ipc, 9.99));
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%*s ", width, "N/A");
+      }
+      break;
+   }
+   case CGROUP_PERF_CACHE_MISS: Row_printPercentage((float) (100.0 * PerfCounters_ratio(this->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES)), buffer, n, width, &attr); break;
+   case CGROUP_PERF_CSW_RATE: Row_printCount(str, isNonnegative(this->perf_rates[PERF_EVENT_CONTEXT_SWITCHES]) ? (unsigned long long) this->perf_rates[PERF_EVENT_CONTEXT_SWITCHES] : ULLONG_MAX, coloring); return;
+   case CGROUP_PERF_FAULT_RATE: Row_printCount(str, isNonnegative(this->perf_rates[PERF_EVENT_PAGE_FAULTS]) ? (unsigned long long) this->perf_rates[PERF_EVENT_PAGE_FAULTS] : ULLONG_MAX, coloring); return;
+   default:
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static const char* CGroupEntry_sortKeyString(Row* super) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   return this->path;
+}
+
+static bool CGroupEntry_matchesFilter(const Row* super, const Table* table) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   const char* incFilter = table->incFilter;
+   return incFilter && !String_contains_i(this->path, incFilter, true);
+}
+
+static int CGroupEntry_compareByKey(const CGroupEntry* c1, const CGroupEntry* c2, int local) {
+   switch (local) {
+   case CGROUP_NAME:
+      return SPACESHIP_NULLSTR(c1->path, c2->path);
+   case CGROUP_PERCENT_CPU:
+      return compareRealNumbers(c1->percent_cpu, c2->percent_cpu);
+   case CGROUP_CPU_USER:
+      return SPACESHIP_NUMBER(c1->user_usec, c2->user_usec);
+   case CGROUP_CPU_SYSTEM:
+      return SPACESHIP_NUMBER(c1->system_usec, c2->system_usec);
+   case CGROUP_NR_THROTTLED:
+      return SPACESHIP_NUMBER(c1->nr_throttled, c2->nr_throttled);
+   case CGROUP_THROTTLED_TIME:
+      return SPACESHIP_NUMBER(c1->throttled_usec, c2->throttled_usec);
+   case CGROUP_MEM_CURRENT:
+      return SPACESHIP_NUMBER(c1->memory_current, c2->memory_current);
+   case CGROUP_MEM_ANON:
+      return SPACESHIP_NUMBER(c1->memory_anon, c2->memory_anon);
+   case CGROUP_MEM_FILE:
+      return SPACESHIP_NUMBER(c1->memory_file, c2->memory_file);
+   case CGROUP_MEM_WSS:
+      return SPACESHIP_NUMBER(c1->memory_wss, c2->memory_wss);
+   case CGROUP_IO_READ_RATE:
+      return compareRealNumbers(c1->io_read_rate, c2->io_read_rate);
+   case CGROUP_IO_WRITE_RATE:
+      return compareRealNumbers(c1->io_write_rate, c2->io_write_rate);
+   case CGROUP_PIDS:
+      return SPACESHIP_NUMBER(c1->pids_current, c2->pids_current);
+   case CGROUP_CPU_PRESSURE:
+      return compareRealNumbers(c1->cpu_some, c2->cpu_some);
+   case CGROUP_MEMORY_PRESSURE_SOME:
+      return compareRealNumbers(c1->memory_some, c2->memory_some);
+   case CGROUP_MEMORY_PRESSURE_FULL:
+      return compareRealNumbers(c1->memory_full, c2->memory_full);
+   case CGROUP_IO_PRESSURE_SOME:
+      return compareRealNumbers(c1->io_some, c2->io_some);
+   case CGROUP_IO_PRESSURE_FULL:
+      return compareRealNumbers(c1->io_full, c2->io_full);
+   case CGROUP_PERF_IPC:
+      return compareRealNumbers(PerfCounters_ratio(c1->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES),
+                                PerfCounters_ratio(c2->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES));
+   case CGROUP_PERF_CACHE_MISS:
+      return compareRealNumbers(PerfCounters_ratio(c1->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES),
+                                PerfCounters_ratio(c2->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES));
+   case CGROUP_PERF_CSW_RATE:
+      return compareRealNumbers(c1->perf_rates[PERF_EVENT_CONTEXT_SWITCHES], c2->perf_rates[PERF_EVENT_CONTEXT_SWITCHES]);
+   case CGROUP_PERF_FAULT_RATE:
+      return compareRealNumbers(c1->perf_rates[PERF_EVENT_PAGE_FAULTS], c2->perf_rates[PERF_EVENT_PAGE_FAULTS]);
+   default:
+      return 0;
+   }
+}
+
+static int CGroupEntry_compare(const void* v1, const void* v2) {
+   const CGroupEntry* c1 = (const CGroupEntry*)v1;
+   const CGroupEntry* c2 = (const CGroupEntry*)v2;
+   const Settings* settings = c1->super.host->settings;
+   const ScreenSettings* ss = settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int local = LinuxDynamicColumn_field(settings, c1->table, key);
+   int result = CGroupEntry_compareByKey(c1, c2, local);
+
+   // Implement tie-breaker (needed to make the sort order stable)
+   if (!result)
+      return SPACESHIP_NULLSTR(c1->path, c2->path);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass CGroupEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = CGroupEntry_delete,
+      .compare = CGroupEntry_compare,
+   },
+   .matchesFilter = CGroupEntry_matchesFilter,
+   .sortKeyString = CGroupEntry_sortKeyString,
+   .writeField = CGroupEntry_writeField,
+};
@@ -0,0 +1,93 @@
+#ifndef HEADER_CGroupEntry
+#define HEADER_CGroupEntry
+/*
+htop - linux/CGroupEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Row.h"
+
+#include "linux/PerfCounters.h"
+
+
+/* Table-local fields, in the order of CGroupTable_columns[] */
+typedef enum CGroupField_ {
+   CGROUP_PERCENT_CPU = 0,
+   CGROUP_CPU_USER,
+   CGROUP_CPU_SYSTEM,
+   CGROUP_NR_THROTTLED,
+   CGROUP_THROTTLED_TIME,
+   CGROUP_MEM_CURRENT,
+   CGROUP_MEM_ANON,
+   CGROUP_MEM_FILE,
+   CGROUP_MEM_WSS,
+   CGROUP_IO_READ_RATE,
+   CGROUP_IO_WRITE_RATE,
+   CGROUP_PIDS,
+   CGROUP_CPU_PRESSURE,
+   CGROUP_MEMORY_PRESSURE_SOME,
+   CGROUP_MEMORY_PRESSURE_FULL,
+   CGROUP_IO_PRESSURE_SOME,
+   CGROUP_IO_PRESSURE_FULL,
+   CGROUP_PERF_IPC,
+   CGROUP_PERF_CACHE_MISS,
+   CGROUP_PERF_CSW_RATE,
+   CGROUP_PERF_FAULT_RATE,
+   CGROUP_NAME,
+   CGROUP_LAST_FIELD
+} CGroupField;
+
+typedef struct CGroupEntry_ {
+   Row super;
+
+   const struct Table_* table;       /* owning table, to resolve sort keys */
+   char* path;                       /* relative to the cgroup2 mount point */
+
+   /* cpu.stat, in microseconds */
+   unsigned long long usage_usec;
+   unsigned long long user_usec;
+   unsigned long long system_usec;
+   unsigned long long nr_throttled;
+   unsigned long long throttled_usec;
+   float percent_cpu;
+
+   /* memory.current and memory.stat, in bytes */
+   unsigned long long memory_current;
+   unsigned long long memory_anon;
+   unsigned long long memory_file;
+   /* working sets of the processes in the cgroup and its descendants, in bytes */
+   unsigned long long memory_wss;
+
+   /* io.stat, summed over all devices */
+   unsigned long long io_rbytes;
+   unsigned long long io_wbytes;
+   double io_read_rate;
+   double io_write_rate;
+
+   unsigned long long pids_current;
+
+   /* avg10 values from {cpu,memory,io}.pressure */
+   float cpu_some;
+   float memory_some;
+   float memory_full;
+   float io_some;
+   float io_full;
+
+   /* performance counter events per second, NAN unless the cgroup is among those counted */
+   double perf_rates[PERF_EVENT_COUNT];
+
+   uint64_t last_scan_ms;            /* realtime of the previous sample, 0 if none */
+} CGroupEntry;
+
+extern const RowClass CGroupEntry_class;
+
+CGroupEntry* CGroupEntry_new(const Machine* host, const struct Table_* table);
+
+void CGroupEntry_done(CGroupEntry* this);
+
+#endif
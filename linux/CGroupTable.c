@@ -0,0 +1,432 @@
+/*
+htop - linux/CGroupTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupTable.h"
+
+#include <assert.h>
+#include <dirent.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/CGroupEntry.h"
+#include "linux/LinuxMachine.h"
+#include "linux/LinuxProcess.h"
+#include "linux/LinuxProcessTable.h"
+
+
+/* Indexed by CGroupField */
+static const LinuxDynamicColumnDefaults CGroupTable_columns[] = {
+   [CGROUP_PERCENT_CPU] = { .name = "cpu", .heading = "CPU%", .description = "Percentage of CPU time used by the cgroup since last update", .width = 5, .enabled = true, },
+   [CGROUP_CPU_USER] = { .name = "user", .heading = "USER", .description = "Total user CPU time (cpu.stat user_usec)", .width = 8, .enabled = false, },
+   [CGROUP_CPU_SYSTEM] = { .name = "system", .heading = "SYSTEM", .description = "Total system CPU time (cpu.stat system_usec)", .width = 8, .enabled = false, },
+   [CGROUP_NR_THROTTLED] = { .name = "throttled", .heading = "THROTTLED", .description = "Number of periods the cgroup was throttled (cpu.stat nr_throttled)", .width = 11, .enabled = false, },
+   [CGROUP_THROTTLED_TIME] = { .name = "throttled_time", .heading = "THR_TIME", .description = "Total time the cgroup was throttled (cpu.stat throttled_usec)", .width = 8, .enabled = false, },
+   [CGROUP_MEM_CURRENT] = { .name = "memory", .heading = "MEM", .description = "Memory charged to the cgroup (memory.current)", .width = 5, .enabled = true, },
+   [CGROUP_MEM_ANON] = { .name = "anon", .heading = "ANON", .description = "Anonymous memory of the cgroup (memory.stat anon)", .width = 5, .enabled = false, },
+   [CGROUP_MEM_FILE] = { .name = "file", .heading = "FILE", .description = "Page cache memory of the cgroup (memory.stat file)", .width = 5, .enabled = false, },
+   [CGROUP_MEM_WSS] = { .name = "wss", .heading = "WSS", .description = "Working sets of the processes in the cgroup and below, by idle page tracking (requires root)", .width = 5, .enabled = false, },
+   [CGROUP_IO_READ_RATE] = { .name = "read_rate", .heading = "DISK READ", .description = "Block device read rate of the cgroup (io.stat rbytes)", .width = 11, .enabled = true, },
+   [CGROUP_IO_WRITE_RATE] = { .name = "write_rate", .heading = "DISK WRITE", .description = "Block device write rate of the cgroup (io.stat wbytes)", .width = 11, .enabled = true, },
+   [CGROUP_PIDS] = { .name = "pids", .heading = "PIDS", .description = "Number of tasks in the cgroup (pids.current)", .width = 11, .enabled = true, },
+   [CGROUP_CPU_PRESSURE] = { .name = "cpu_some", .heading = "CPU PSI", .description = "CPU pressure stall, some, 10s average (cpu.pressure)", .width = 7, .enabled = true, },
+   [CGROUP_MEMORY_PRESSURE_SOME] = { .name = "memory_some", .heading = "MEM PSI", .description = "Memory pressure stall, some, 10s average (memory.pressure)", .width = 7, .enabled = true, },
+   [CGROUP_MEMORY_PRESSURE_FULL] = { .name = "memory_full", .heading = "MEM FUL", .description = "Memory pressure stall, full, 10s average (memory.pressure)", .width = 7, .enabled = false, },
+   [CGROUP_IO_PRESSURE_SOME] = { .name = "io_some", .heading = "IO PSI", .description = "I/O pressure stall, some, 10s average (io.pressure)", .width = 7, .enabled = true, },
+   [CGROUP_IO_PRESSURE_FULL] = { .name = "io_full", .heading = "IO FUL", .description = "I/O pressure stall, full, 10s average (io.pressure)", .width = 7, .enabled = false, },
+   [CGROUP_PERF_IPC] = { .name = "ipc", .heading = "IPC", .description = "Instructions per CPU cycle (perf_event hardware counters, cgroups using the most CPU only)", .width = 5, .enabled = false, },
+   [CGROUP_PERF_CACHE_MISS] = { .name = "cache_miss", .heading = "MISS%", .description = "Percentage of cache references that missed (perf_event hardware counters, cgroups using the most CPU only)", .width = 5, .enabled = false, },
+   [CGROUP_PERF_CSW_RATE] = { .name = "csw_rate", .heading = "CSW/s", .description = "Context switches per second (perf_event software counter, cgroups using the most CPU only)", .width = 11, .enabled = false, },
+   [CGROUP_PERF_FAULT_RATE] = { .name = "fault_rate", .heading = "FAULTS/s", .description = "Page faults per second (perf_event software counter, cgroups using the most CPU only)", .width = 11, .enabled = false, },
+   [CGROUP_NAME] = { .name = "name", .heading = "CGROUP", .description = "Control group path below the cgroup2 mount point", .width = -48, .enabled = true, },
+};
+
+static_assert(ARRAYSIZE(CGroupTable_columns) == CGROUP_LAST_FIELD, "CGroupTable_columns must match CGroupField");
+
+const LinuxDynamicScreenDefaults CGroupTable_screen = {
+   .name = "cgroup",
+   .heading = "CGroups",
+   .caption = "Control group (cgroup v2) resource usage",
+   .sortKey = "cpu",
+   .direction = -1,
+   .columns = CGroupTable_columns,
+   .totalColumns = ARRAYSIZE(CGroupTable_columns),
+   .newTable = CGroupTable_new,
+};
+
+static char* CGroupTable_findMountPoint(void) {
+   char mountsPath[PATH_MAX];
+   FILE* fp = fopen(LinuxMachine_procPath(mountsPath, sizeof(mountsPath), "/self/mounts"), "r");
+   if (!fp)
+      return NULL;
+
+   char* mountPoint = NULL;
+   char lineBuffer[PROC_LINE_LENGTH + 1];
+   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
+      char path[PATH_MAX];
+      char type[32];
+      if (sscanf(lineBuffer, "%*s %4095s %31s", path, type) != 2)
+         continue;
+      if (String_eq(type, "cgroup2")) {
+         mountPoint = xStrdup(path);
+         break;
+      }
+   }
+   fclose(fp);
+
+   return mountPoint;
+}
+
+Table* CGroupTable_new(Machine* host) {
+   CGroupTable* this = xCalloc(1, sizeof(CGroupTable));
+   Object_setClass(this, Class(CGroupTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(CGroupEntry), host);
+
+   this->root = CGroupTable_findMountPoint();
+   this->paths = Hashtable_new(64, false);
+   PerfCounters_init(&this->perfCounters);
+
+   return super;
+}
+
+void CGroupTable_done(CGroupTable* this) {
+   free(this->root);
+   Hashtable_delete(this->paths);
+   PerfCounters_done(&this->perfCounters);
+   Table_done(&this->super);
+}
+
+static void CGroupTable_delete(Object* cast) {
+   CGroupTable* this = (CGroupTable*) cast;
+   CGroupTable_done(this);
+   free(this);
+}
+
+/* Reads <path>/<name> into buffer; path is restored before returning */
+static ssize_t CGroupTable_readFile(char* path, size_t len, const char* name, char* buffer, size_t size) {
+   if (len + 1 + strlen(name) >= PATH_MAX)
+      return -1;
+
+   path[len] = '/';
+   strcpy(path + len + 1, name);
+   ssize_t r = xReadfile(path, buffer, size);
+   path[len] = '\0';
+   return r;
+}
+
+/* Looks up a "key value" line in a flat keyed file such as cpu.stat */
+static unsigned long long CGroupTable_keyedValue(const char* buffer, const char* key) {
+   size_t keyLen = strlen(key);
+
+   for (const char* line = buffer; line && *line; ) {
+      if (strncmp(line, key, keyLen) == 0 && line[keyLen] == ' ')
+         return strtoull(line + keyLen + 1, NULL, 10);
+
+      line = strchr(line, '\n');
+      if (line)
+         line++;
+   }
+
+   return ULLONG_MAX;
+}
+
+/* Sums a "key=value" entry over all lines of a nested keyed file such as io.stat */
+static unsigned long long CGroupTable_nestedSum(const char* buffer, const char* key) {
+   size_t keyLen = strlen(key);
+   unsigned long long sum = 0;
+
+   for (const char* p = buffer; (p = strstr(p, key)) != NULL; ) {
+      char* end;
+      p += keyLen;
+      sum += strtoull(p, &end, 10);
+      p = end;
+   }
+
+   return sum;
+}
+
+static void CGroupTable_readPressure(char* path, size_t len, const char* name, float* some, float* full) {
+   char buffer[256];
+
+   *some = NAN;
+   if (full)
+      *full = NAN;
+
+   if (CGroupTable_readFile(path, len, name, buffer, sizeof(buffer)) <= 0)
+      return;
+
+   (void) sscanf(buffer, "some avg10=%f", some);
+
+   const char* line = strstr(buffer, "full avg10=");
+   if (full && line)
+      (void) sscanf(line, "full avg10=%f", full);
+}
+
+static void CGroupTable_readEntry(CGroupEntry* entry, const Machine* host, char* path, size_t len) {
+   char buffer[16 * 1024];
+
+   uint64_t timeDelta = entry->last_scan_ms ? saturatingSub(host->realtimeMs, entry->last_scan_ms) : 0;
+   entry->last_scan_ms = host->realtimeMs;
+
+   if (CGroupTable_readFile(path, len, "cpu.stat", buffer, sizeof(buffer)) > 0) {
+      unsigned long long usage = CGroupTable_keyedValue(buffer, "usage_usec");
+      if (usage != ULLONG_MAX) {
+         if (timeDelta > 0)
+            entry->percent_cpu = (float) (saturatingSub(usage, entry->usage_usec) / (double) timeDelta / 10.0);
+         entry->usage_usec = usage;
+      }
+
+      entry->user_usec = CGroupTable_keyedValue(buffer, "user_usec");
+      entry->system_usec = CGroupTable_keyedValue(buffer, "system_usec");
+
+      /* only present when the cpu controller is enabled for this cgroup */
+      unsigned long long throttled = CGroupTable_keyedValue(buffer, "nr_throttled");
+      entry->nr_throttled = throttled != ULLONG_MAX ? throttled : 0;
+      throttled = CGroupTable_keyedValue(buffer, "throttled_usec");
+      entry->throttled_usec = throttled != ULLONG_MAX ? throttled : 0;
+   }
+
+   if (CGroupTable_readFile(path, len, "memory.current", buffer, sizeof(buffer)) > 0)
+      entry->memory_current = strtoull(buffer, NULL, 10);
+   else
+      entry->memory_current = ULLONG_MAX;
+
+   if (CGroupTable_readFile(path, len, "memory.stat", buffer, sizeof(buffer)) > 0) {
+      entry->memory_anon = CGroupTable_keyedValue(buffer, "anon");
+      entry->memory_file = CGroupTable_keyedValue(buffer, "file");
+   } else {
+      entry->memory_anon = ULLONG_MAX;
+      entry->memory_file = ULLONG_MAX;
+   }
+
+   if (CGroupTable_readFile(path, len, "io.stat", buffer, sizeof(buffer)) >= 0) {
+      unsigned long long rbytes = CGroupTable_nestedSum(buffer, "rbytes=");
+      unsigned long long wbytes = CGroupTable_nestedSum(buffer, "wbytes=");
+      if (timeDelta > 0) {
+         entry->io_read_rate = saturatingSub(rbytes, entry->io_rbytes) * 1000.0 / timeDelta;
+         entry->io_write_rate = saturatingSub(wbytes, entry->io_wbytes) * 1000.0 / timeDelta;
+      } else {
+         entry->io_read_rate = NAN;
+         entry->io_write_rate = NAN;
+      }
+      entry->io_rbytes = rbytes;
+      entry->io_wbytes = wbytes;
+   }
+
+   if (CGroupTable_readFile(path, len, "pids.current", buffer, sizeof(buffer)) > 0)
+      entry->pids_current = strtoull(buffer, NULL, 10);
+   else
+      entry->pids_current = ULLONG_MAX;
+
+   CGroupTable_readPressure(path, len, "cpu.pressure", &entry->cpu_some, NULL);
+   CGroupTable_readPressure(path, len, "memory.pressure", &entry->memory_some, &entry->memory_full);
+   CGroupTable_readPressure(path, len, "io.pressure", &entry->io_some, &entry->io_full);
+}
+
+static ht_key_t CGroupTable_pathKey(const char* path) {
+   ht_key_t hash = 2166136261U;
+   for (const char* c = path; *c; c++)
+      hash = (hash ^ (unsigned char)*c) * 16777619U;
+   return hash;
+}
+
+static CGroupEntry* CGroupTable_getEntry(CGroupTable* this, int id, bool* preExisting) {
+   Table* super = &this->super;
+   CGroupEntry* entry = (CGroupEntry*) Hashtable_get(super->table, id);
+   *preExisting = entry != NULL;
+   if (entry) {
+      assert(Vector_indexOf(super->rows, entry, Row_idEqualCompare) != -1);
+      assert(entry->super.id == id);
+   } else {
+      entry = CGroupEntry_new(super->host, super);
+      entry->super.id = id;
+   }
+   return entry;
+}
+
+static void CGroupTable_scanDirectory(CGroupTable* this, char* path, size_t len, int id, int parent) {
+   Table* super = &this->super;
+   size_t rootLen = strlen(this->root);
+
+   bool preExisting;
+   CGroupEntry* entry = CGroupTable_getEntry(this, id, &preExisting);
+   const char* name = len > rootLen ? path + rootLen : "/";
+   if (!entry->path || !String_eq(entry->path, name))
+      free_and_xStrdup(&entry->path, name);
+
+   Row* row = &entry->super;
+   row->parent = parent;
+   row->isRoot = parent == 0;
+
+   CGroupTable_readEntry(entry, super->host, path, len);
+   entry->memory_wss = ULLONG_MAX;
+   Hashtable_put(this->paths, CGroupTable_pathKey(entry->path), entry);
+
+   if (!preExisting)
+      Table_add(super, row);
+   row->updated = true;
+   row->show = true;
+
+   DIR* dir = opendir(path);
+   if (!dir)
+      return;
+
+   const struct dirent* dirent;
+   while ((dirent = readdir(dir)) != NULL) {
+      if (dirent->d_type != DT_DIR || dirent->d_name[0] == '.')
+         continue;
+
+      size_t nameLen = strlen(dirent->d_name);
+      if (len + 1 + nameLen >= PATH_MAX)
+         continue;
+
+      path[len] = '/';
+      memcpy(path + len + 1, dirent->d_name, nameLen + 1);
+      CGroupTable_scanDirectory(this, path, len + 1 + nameLen, (int) dirent->d_ino, id);
+      path[len] = '\0';
+   }
+   closedir(dir);
+}
+
+/* Whether a screen of this table shows one of the columns from first to last */
+static bool CGroupTable_showsColumns(const Table* super, CGroupField first, CGroupField last) {
+   const Settings* settings = super->host->settings;
+   for (unsigned int i = 0; i < settings->nScreens; i++) {
+      const ScreenSettings* ss = settings->screens[i];
+      if (ss->table != super)
+         continue;
+
+      for (const RowField* field = ss->fields; *field; field++) {
+         int local = LinuxDynamicColumn_field(settings, super, *field);
+         if (local >= (int) first && local <= (int) last)
+            return true;
+      }
+   }
+   return false;
+}
+
+/* Adds the working set of each process to its cgroup and all ancestors */
+static void CGroupTable_rollUpWorkingSets(CGroupTable* this) {
+   Table* super = &this->super;
+   const Table* processes = (const Table*) super->host->processTable;
+
+   for (int i = 0; i < Vector_size(processes->rows); i++) {
+      const LinuxProcess* lp = (const LinuxProcess*) Vector_get(processes->rows, i);
+      if (lp->super.isUserlandThread || isnan(lp->m_wss) || !lp->wss_cgroup)
+         continue;
+
+      /* paths with a colliding hash are left out */
+      CGroupEntry* entry = Hashtable_get(this->paths, CGroupTable_pathKey(lp->wss_cgroup));
+      if (!entry || !String_eq(entry->path, lp->wss_cgroup))
+         continue;
+
+      unsigned long long bytes = (unsigned long long) lp->m_wss * ONE_K;
+      while (entry) {
+         if (entry->memory_wss == ULLONG_MAX)
+            entry->memory_wss = 0;
+         entry->memory_wss += bytes;
+         entry = entry->super.isRoot ? NULL : Hashtable_get(super->table, entry->super.parent);
+      }
+   }
+}
+
+static int CGroupTable_compareByCpu(const void* v1, const void* v2) {
+   const CGroupEntry* c1 = *(const CGroupEntry* const*) v1;
+   const CGroupEntry* c2 = *(const CGroupEntry* const*) v2;
+   return compareRealNumbers(c2->percent_cpu, c1->percent_cpu);
+}
+
+/* Counts events for the cgroups with the highest CPU usage, on each CPU */
+static void CGroupTable_updatePerfCounters(CGroupTable* this) {
+   Table* super = &this->super;
+   const Machine* host = super->host;
+   size_t limit = (size_t) host->settings->perfTopProcesses;
+
+   CGroupEntry** candidates = xMallocArray((size_t) MAXIMUM(Vector_size(super->rows), 1), sizeof(*candidates));
+   size_t nCandidates = 0;
+   for (int i = 0; i < Vector_size(super->rows); i++) {
+      CGroupEntry* entry = (CGroupEntry*) Vector_get(super->rows, i);
+      for (size_t e = 0; e < PERF_EVENT_COUNT; e++)
+         entry->perf_rates[e] = NAN;
+
+      if (entry->super.updated)
+         candidates[nCandidates++] = entry;
+   }
+   qsort(candidates, nCandidates, sizeof(*candidates), CGroupTable_compareByCpu);
+
+   PerfCounters_begin(&this->perfCounters);
+   for (size_t i = 0; i < MINIMUM(nCandidates, limit); i++) {
+      const CGroupEntry* entry = candidates[i];
+      char path[PATH_MAX];
+      xSnprintf(path, sizeof(path), "%s%s", this->root, entry->super.isRoot ? "" : entry->path);
+
+      if (!PerfCounters_attachCGroup(&this->perfCounters, (ht_key_t) entry->super.id, path, host) && this->perfCounters.exhausted)
+         break;
+   }
+   PerfCounters_end(&this->perfCounters, host->monotonicMs);
+   free(candidates);
+
+   for (size_t i = 0; i < this->perfCounters.nTargets; i++) {
+      const PerfTarget* target = this->perfCounters.list[i];
+      CGroupEntry* entry = Hashtable_get(super->table, (int) target->key);
+      if (entry)
+         memcpy(entry->perf_rates, target->rates, sizeof(entry->perf_rates));
+   }
+}
+
+static void CGroupTable_iterateEntries(Table* super) {
+   CGroupTable* this = (CGroupTable*) super;
+   if (!this->root)
+      return;
+
+   struct stat sb;
+   if (stat(this->root, &sb) != 0)
+      return;
+
+   Hashtable_clear(this->paths);
+
+   char path[PATH_MAX];
+   String_safeStrncpy(path, this->root, sizeof(path));
+   CGroupTable_scanDirectory(this, path, strlen(path), (int) sb.st_ino, 0);
+
+   LinuxProcessTable* pt = (LinuxProcessTable*) super->host->processTable;
+   if (pt && CGroupTable_showsColumns(super, CGROUP_MEM_WSS, CGROUP_MEM_WSS)) {
+      /* processes are tracked from the next process scan on */
+      pt->workingSetWanted = true;
+      CGroupTable_rollUpWorkingSets(this);
+   }
+
+   if (CGroupTable_showsColumns(super, CGROUP_PERF_IPC, CGROUP_PERF_FAULT_RATE))
+      CGroupTable_updatePerfCounters(this);
+   else
+      PerfCounters_clear(&this->perfCounters);
+}
+
+const TableClass CGroupTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = CGroupTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = CGroupTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,33 @@
+#ifndef HEADER_CGroupTable
+#define HEADER_CGroupTable
+/*
+htop - linux/CGroupTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Table.h"
+
+#include "linux/LinuxDynamicScreen.h"
+#include "linux/PerfCounters.h"
+
+
+typedef struct CGroupTable_ {
+   Table super;
+   char* root;  /* cgroup2 mount point, NULL if not mounted */
+   Hashtable* paths;  /* hash of the path -> CGroupEntry, rebuilt by each scan */
+   PerfCounters perfCounters;  /* counters of the cgroups using the most CPU */
+} CGroupTable;
+
+extern const TableClass CGroupTable_class;
+
+extern const LinuxDynamicScreenDefaults CGroupTable_screen;
+
+Table* CGroupTable_new(Machine* host);
+
+void CGroupTable_done(CGroupTable* this);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+htop - linux/DataSource.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DataSource.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XUtils.h"
+#include "generic/gettime.h"
+
+
+#define DATASOURCE_INITIAL_SIZE 4096
+
+static DataSource* DataSources_list;
+static DataSource* DataSources_last;
+
+DataSource* DataSource_get(const char* path, uint64_t minInterval) {
+   for (DataSource* source = DataSources_list; source; source = source->next) {
+      if (String_eq(source->path, path))
+         return source;
+   }
+
+   DataSource* this = xCalloc(1, sizeof(DataSource));
+   this->path = xStrdup(path);
+   this->fd = -1;
+   this->minInterval = minInterval;
+
+   /* append, so the sources registered first are also found first */
+   if (DataSources_last)
+      DataSources_last->next = this;
+   else
+      DataSources_list = this;
+   DataSources_last = this;
+   return this;
+}
+
+static void DataSource_close(DataSource* this) {
+   if (this->fd >= 0) {
+      close(this->fd);
+      this->fd = -1;
+   }
+}
+
+static bool DataSource_fill(DataSource* this) {
+   if (!this->buffer) {
+      this->size = DATASOURCE_INITIAL_SIZE;
+      this->buffer = xMalloc(this->size);
+   }
+
+   for (;;) {
+      ssize_t r = pread(this->fd, this->buffer, this->size - 1, 0);
+      if (r < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+
+      /* a full buffer may have truncated the content: grow and read again */
+      if ((size_t)r < this->size - 1) {
+         this->buffer[r] = '\0';
+         this->length = (size_t)r;
+         return true;
+      }
+
+      this->size *= 2;
+      this->buffer = xRealloc(this->buffer, this->size);
+   }
+}
+
+const char* DataSource_read(DataSource* this) {
+   uint64_t now;
+   Generic_gettime_monotonic(&now);
+
+   if (this->valid && now - this->lastRead < this->minInterval)
+      return this->buffer;
+
+   this->valid = false;
+
+   /* retry once with a new descriptor, the file might have been replaced */
+   for (int attempt = 0; attempt < 2; attempt++) {
+      if (this->fd < 0) {
+         this->fd = open(this->path, O_RDONLY | O_CLOEXEC);
+         if (this->fd < 0)
+            return NULL;
+      }
+
+      if (DataSource_fill(this)) {
+         this->valid = true;
+         this->lastRead = now;
+         return this->buffer;
+      }
+
+      DataSource_close(this);
+   }
+
+   return NULL;
+}
+
+void DataSources_done(void) {
+   DataSource* source = DataSources_list;
+   while (source) {
+      DataSource* next = source->next;
+      DataSource_close(source);
+      free(source->buffer);
+      free(source->path);
+      free(source);
+      source = next;
+   }
+   DataSources_list = NULL;
+   DataSources_last = NULL;
+}
+
+bool DataSource_nextLine(const char** cursor, char* line, size_t size) {
+   const char* at = *cursor;
+   if (!at || *at == '\0')
+      return false;
+
+   const char* end = strchr(at, '\n');
+   const char* next = end ? end + 1 : at + strlen(at);
+
+   size_t len = MINIMUM((size_t)(next - at), size - 1);
+   memcpy(line, at, len);
+   line[len] = '\0';
+
+   *cursor = next;
+   return true;
+}
+
+static inline bool DataSource_isBlank(char c) {
+   return c == ' ' || c == '\t';
+}
+
+size_t DataSource_nextWord(const char** cursor, const char** word) {
+   const char* at = *cursor;
+   while (DataSource_isBlank(*at))
+      at++;
+
+   *word = at;
+   while (*at && *at != '\n' && !DataSource_isBlank(*at))
+      at++;
+
+   *cursor = at;
+   return (size_t)(at - *word);
+}
+
+unsigned long long DataSource_nextNumber(const char** cursor) {
+   const char* at = *cursor;
+   while (DataSource_isBlank(*at))
+      at++;
+
+   unsigned long long value = 0;
+   while (*at >= '0' && *at <= '9')
+      value = value * 10 + (unsigned long long)(*at++ - '0');
+
+   /* skip the rest of a malformed word */
+   while (*at && *at != '\n' && !DataSource_isBlank(*at))
+      at++;
+
+   *cursor = at;
+   return value;
+}
+
+bool DataSource_skipLine(const char** cursor) {
+   const char* end = strchr(*cursor, '\n');
+   *cursor = end ? end + 1 : *cursor + strlen(*cursor);
+   return **cursor != '\0';
+}
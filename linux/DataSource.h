@@ -0,0 +1,57 @@
+#ifndef HEADER_DataSource
+#define HEADER_DataSource
+/*
+htop - linux/DataSource.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * A machine-wide /proc or /sys file which is read over and over again.
+ * The file is kept open and re-read with pread(2) into a reusable buffer.
+ */
+typedef struct DataSource_ {
+   char* path;
+   int fd;                  /* kept open between reads, -1 if not open */
+   char* buffer;            /* content of the last successful read, NUL terminated */
+   size_t size;             /* allocated size of buffer */
+   size_t length;           /* length of the content in buffer */
+   bool valid;              /* buffer holds the content of a successful read */
+   uint64_t minInterval;    /* minimum milliseconds between re-reads */
+   uint64_t lastRead;       /* monotonic time of the last successful read */
+   struct DataSource_* next;
+} DataSource;
+
+/* Finds or registers the data source for path; the registry owns it */
+DataSource* DataSource_get(const char* path, uint64_t minInterval);
+
+/* Content of the file, re-read unless minInterval has not passed yet; NULL if unavailable */
+const char* DataSource_read(DataSource* this);
+
+/* Closes and frees all registered data sources */
+void DataSources_done(void);
+
+/* Copies the next line of content at *cursor into line, like fgets(3)
+   including the newline, and advances the cursor past it.  The rest of
+   lines not fitting into line is skipped.  Returns false at the end. */
+bool DataSource_nextLine(const char** cursor, char* line, size_t size);
+
+/* In-place tokenizer for the content, without copying lines: words are
+   separated by blanks and never extend past the end of the line. */
+
+/* Points word at the next word on the current line and returns its length, 0 at the end of the line */
+size_t DataSource_nextWord(const char** cursor, const char** word);
+
+/* Parses the next word on the current line as unsigned decimal number, 0 if there is none */
+unsigned long long DataSource_nextNumber(const char** cursor);
+
+/* Advances the cursor to the start of the next line; returns false at the end */
+bool DataSource_skipLine(const char** cursor);
+
+#endif
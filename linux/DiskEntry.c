@@ -0,0 +1,169 @@
+/*
+htop - linux/DiskEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DiskEntry.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+DiskEntry* DiskEntry_new(const Machine* host, const Table* table) {
+   DiskEntry* this = xCalloc(1, sizeof(DiskEntry));
+   Object_setClass(this, Class(DiskEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+
+   this->table = table;
+   this->reads_rate = NAN;
+   this->writes_rate = NAN;
+   this->read_rate = NAN;
+   this->write_rate = NAN;
+   this->read_await = NAN;
+   this->write_await = NAN;
+   this->await = NAN;
+   this->queue_size = NAN;
+   this->utilization = NAN;
+
+   return this;
+}
+
+void DiskEntry_done(DiskEntry* this) {
+   Row_done(&this->super);
+}
+
+static void DiskEntry_delete(Object* cast) {
+   DiskEntry* this = (DiskEntry*) cast;
+   DiskEntry_done(this);
+   free(this);
+}
+
+static void DiskEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const DiskEntry* this = (const DiskEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+   uint8_t width = column ? (uint8_t) MINIMUM(abs(column->width), DYNAMIC_MAX_COLUMN_WIDTH) : 5;
+
+   int local = LinuxDynamicColumn_field(settings, this->table, field);
+   switch (local) {
+   case DISK_NAME: Row_printLeftAlignedField(str, this->isPartition ? CRT_colors[PROCESS_SHADOW] : attr, this->name, width); return;
+   case DISK_READS_RATE: Row_printDecimal(this->reads_rate, buffer, n, width, &attr); break;
+   case DISK_WRITES_RATE: Row_printDecimal(this->writes_rate, buffer, n, width, &attr); break;
+   case DISK_IOPS: Row_printDecimal(this->reads_rate + this->writes_rate, buffer, n, width, &attr); break;
+   case DISK_READ_RATE: Row_printRate(str, this->read_rate, coloring); return;
+   case DISK_WRITE_RATE: Row_printRate(str, this->write_rate, coloring); return;
+   case DISK_READ_AWAIT: Row_printDecimal(this->read_await, buffer, n, width, &attr); break;
+   case DISK_WRITE_AWAIT: Row_printDecimal(this->write_await, buffer, n, width, &attr); break;
+   case DISK_AWAIT: Row_printDecimal(this->await, buffer, n, width, &attr); break;
+   case DISK_QUEUE_SIZE: Row_printDecimal(this->queue_size, buffer, n, width, &attr); break;
+   case DISK_INFLIGHT:
+      if (this->inflight == 0)
+         attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "%*llu ", width, this->inflight);
+      break;
+   case DISK_UTILIZATION: Row_printPercentage(this->utilization, buffer, n, width, &attr); break;
+   case DISK_READ_BYTES: Row_printBytes(str, this->sectors_read * 512, coloring); return;
+   case DISK_WRITE_BYTES: Row_printBytes(str, this->sectors_written * 512, coloring); return;
+   default:
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static const char* DiskEntry_sortKeyString(Row* super) {
+   const DiskEntry* this = (const DiskEntry*) super;
+   return this->name;
+}
+
+static bool DiskEntry_matchesFilter(const Row* super, const Table* table) {
+   const DiskEntry* this = (const DiskEntry*) super;
+   const char* incFilter = table->incFilter;
+   return incFilter && !String_contains_i(this->name, incFilter, true);
+}
+
+static int DiskEntry_compareByKey(const DiskEntry* d1, const DiskEntry* d2, int local) {
+   switch (local) {
+   case DISK_NAME:
+      return SPACESHIP_NULLSTR(d1->name, d2->name);
+   case DISK_READS_RATE:
+      return compareRealNumbers(d1->reads_rate, d2->reads_rate);
+   case DISK_WRITES_RATE:
+      return compareRealNumbers(d1->writes_rate, d2->writes_rate);
+   case DISK_IOPS:
+      return compareRealNumbers(d1->reads_rate + d1->writes_rate, d2->reads_rate + d2->writes_rate);
+   case DISK_READ_RATE:
+      return compareRealNumbers(d1->read_rate, d2->read_rate);
+   case DISK_WRITE_RATE:
+      return compareRealNumbers(d1->write_rate, d2->write_rate);
+   case DISK_READ_AWAIT:
+      return compareRealNumbers(d1->read_await, d2->read_await);
+   case DISK_WRITE_AWAIT:
+      return compareRealNumbers(d1->write_await, d2->write_await);
+   case DISK_AWAIT:
+      return compareRealNumbers(d1->await, d2->await);
+   case DISK_QUEUE_SIZE:
+      return compareRealNumbers(d1->queue_size, d2->queue_size);
+   case DISK_INFLIGHT:
+      return SPACESHIP_NUMBER(d1->inflight, d2->inflight);
+   case DISK_UTILIZATION:
+      return compareRealNumbers(d1->utilization, d2->utilization);
+   case DISK_READ_BYTES:
+      return SPACESHIP_NUMBER(d1->sectors_read, d2->sectors_read);
+   case DISK_WRITE_BYTES:
+      return SPACESHIP_NUMBER(d1->sectors_written, d2->sectors_written);
+   default:
+      return 0;
+   }
+}
+
+static int DiskEntry_compare(const void* v1, const void* v2) {
+   const DiskEntry* d1 = (const DiskEntry*)v1;
+   const DiskEntry* d2 = (const DiskEntry*)v2;
+   const Settings* settings = d1->super.host->settings;
+   const ScreenSettings* ss = settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int local = LinuxDynamicColumn_field(settings, d1->table, key);
+   int result = DiskEntry_compareByKey(d1, d2, local);
+
+   // Implement tie-breaker (needed to make the sort order stable)
+   if (!result)
+      return SPACESHIP_NULLSTR(d1->name, d2->name);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass DiskEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = DiskEntry_delete,
+      .compare = DiskEntry_compare,
+   },
+   .matchesFilter = DiskEntry_matchesFilter,
+   .sortKeyString = DiskEntry_sortKeyString,
+   .writeField = DiskEntry_writeField,
+};
@@ -0,0 +1,74 @@
+#ifndef HEADER_DiskEntry
+#define HEADER_DiskEntry
+/*
+htop - linux/DiskEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Row.h"
+
+
+/* Table-local fields, in the order of DiskTable_columns[] */
+typedef enum DiskField_ {
+   DISK_NAME = 0,
+   DISK_READS_RATE,
+   DISK_WRITES_RATE,
+   DISK_IOPS,
+   DISK_READ_RATE,
+   DISK_WRITE_RATE,
+   DISK_READ_AWAIT,
+   DISK_WRITE_AWAIT,
+   DISK_AWAIT,
+   DISK_QUEUE_SIZE,
+   DISK_INFLIGHT,
+   DISK_UTILIZATION,
+   DISK_READ_BYTES,
+   DISK_WRITE_BYTES,
+   DISK_LAST_FIELD
+} DiskField;
+
+typedef struct DiskEntry_ {
+   Row super;
+
+   const struct Table_* table;       /* owning table, to resolve sort keys */
+   char name[32];                    /* kernel name of the block device */
+   bool isPartition;
+
+   /* cumulative counters of /proc/diskstats */
+   unsigned long long reads;
+   unsigned long long sectors_read;
+   unsigned long long read_ms;
+   unsigned long long writes;
+   unsigned long long sectors_written;
+   unsigned long long write_ms;
+   unsigned long long inflight;
+   unsigned long long io_ms;         /* time the device had requests in flight */
+   unsigned long long queue_ms;      /* io_ms weighted by the number of requests in flight */
+
+   /* over the last interval, NAN until two samples were taken */
+   double reads_rate;
+   double writes_rate;
+   double read_rate;                 /* bytes per second */
+   double write_rate;
+   double read_await;                /* average milliseconds per request */
+   double write_await;
+   double await;
+   double queue_size;                /* average number of requests in flight */
+   float utilization;
+
+   uint64_t last_scan_ms;            /* realtime of the previous sample, 0 if none */
+} DiskEntry;
+
+extern const RowClass DiskEntry_class;
+
+DiskEntry* DiskEntry_new(const Machine* host, const struct Table_* table);
+
+void DiskEntry_done(DiskEntry* this);
+
+#endif
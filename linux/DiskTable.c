@@ -0,0 +1,198 @@
+/*
+htop - linux/DiskTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DiskTable.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/DataSource.h"
+#include "linux/DiskEntry.h"
+#include "linux/LinuxMachine.h"
+
+
+/* Indexed by DiskField */
+static const LinuxDynamicColumnDefaults DiskTable_columns[] = {
+   [DISK_NAME] = { .name = "name", .heading = "DEVICE", .description = "Kernel name of the block device", .width = -16, .enabled = true, },
+   [DISK_READS_RATE] = { .name = "reads", .heading = "R/S", .description = "Read requests completed per second", .width = 8, .enabled = true, },
+   [DISK_WRITES_RATE] = { .name = "writes", .heading = "W/S", .description = "Write requests completed per second", .width = 8, .enabled = true, },
+   [DISK_IOPS] = { .name = "iops", .heading = "IOPS", .description = "Read and write requests completed per second", .width = 8, .enabled = false, },
+   [DISK_READ_RATE] = { .name = "read_rate", .heading = "READ", .description = "Bytes read per second", .width = 11, .enabled = true, },
+   [DISK_WRITE_RATE] = { .name = "write_rate", .heading = "WRITE", .description = "Bytes written per second", .width = 11, .enabled = true, },
+   [DISK_READ_AWAIT] = { .name = "r_await", .heading = "R_AWAIT", .description = "Average time in milliseconds to complete a read request", .width = 7, .enabled = true, },
+   [DISK_WRITE_AWAIT] = { .name = "w_await", .heading = "W_AWAIT", .description = "Average time in milliseconds to complete a write request", .width = 7, .enabled = true, },
+   [DISK_AWAIT] = { .name = "await", .heading = "AWAIT", .description = "Average time in milliseconds to complete a read or write request", .width = 7, .enabled = false, },
+   [DISK_QUEUE_SIZE] = { .name = "queue", .heading = "AQU-SZ", .description = "Average number of requests queued or in flight", .width = 6, .enabled = true, },
+   [DISK_INFLIGHT] = { .name = "inflight", .heading = "INFLT", .description = "Number of requests in flight", .width = 5, .enabled = false, },
+   [DISK_UTILIZATION] = { .name = "util", .heading = "UTIL%", .description = "Percentage of time the device had requests in flight", .width = 5, .enabled = true, },
+   [DISK_READ_BYTES] = { .name = "read_bytes", .heading = "READ_TOT", .description = "Total bytes read since boot", .width = 8, .enabled = false, },
+   [DISK_WRITE_BYTES] = { .name = "write_bytes", .heading = "WRITE_TOT", .description = "Total bytes written since boot", .width = 9, .enabled = false, },
+};
+
+static_assert(ARRAYSIZE(DiskTable_columns) == DISK_LAST_FIELD, "DiskTable_columns must match DiskField");
+
+const LinuxDynamicScreenDefaults DiskTable_screen = {
+   .name = "disk",
+   .heading = "Disks",
+   .caption = "Block device I/O statistics (/proc/diskstats)",
+   .sortKey = "util",
+   .direction = -1,
+   .columns = DiskTable_columns,
+   .totalColumns = ARRAYSIZE(DiskTable_columns),
+   .newTable = DiskTable_new,
+};
+
+Table* DiskTable_new(Machine* host) {
+   DiskTable* this = xCalloc(1, sizeof(DiskTable));
+   Object_setClass(this, Class(DiskTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(DiskEntry), host);
+
+   return super;
+}
+
+void DiskTable_done(DiskTable* this) {
+   Table_done(&this->super);
+}
+
+static void DiskTable_delete(Object* cast) {
+   DiskTable* this = (DiskTable*) cast;
+   DiskTable_done(this);
+   free(this);
+}
+
+static DiskEntry* DiskTable_getEntry(DiskTable* this, int id, const char* name, size_t nameLen, bool* preExisting) {
+   Table* super = &this->super;
+   DiskEntry* entry = (DiskEntry*) Hashtable_get(super->table, id);
+   *preExisting = entry != NULL;
+   if (entry) {
+      assert(Vector_indexOf(super->rows, entry, Row_idEqualCompare) != -1);
+      assert(entry->super.id == id);
+   } else {
+      entry = DiskEntry_new(super->host, super);
+      entry->super.id = id;
+   }
+
+   /* a device number can be reused for another device */
+   if (strncmp(entry->name, name, nameLen) != 0 || entry->name[nameLen] != '\0') {
+      memcpy(entry->name, name, nameLen);
+      entry->name[nameLen] = '\0';
+
+      char path[PATH_MAX];
+      entry->isPartition = access(LinuxMachine_sysPath(path, sizeof(path), "/class/block/%s/partition", entry->name), F_OK) == 0;
+      entry->last_scan_ms = 0;
+   }
+
+   return entry;
+}
+
+static void DiskTable_updateRates(DiskEntry* entry, const Machine* host, const unsigned long long stats[11]) {
+   uint64_t timeDelta = entry->last_scan_ms ? saturatingSub(host->realtimeMs, entry->last_scan_ms) : 0;
+   entry->last_scan_ms = host->realtimeMs;
+
+   if (timeDelta > 0) {
+      double seconds = timeDelta / 1000.0;
+      unsigned long long reads = saturatingSub(stats[0], entry->reads);
+      unsigned long long writes = saturatingSub(stats[4], entry->writes);
+      unsigned long long readMs = saturatingSub(stats[3], entry->read_ms);
+      unsigned long long writeMs = saturatingSub(stats[7], entry->write_ms);
+
+      entry->reads_rate = reads / seconds;
+      entry->writes_rate = writes / seconds;
+      entry->read_rate = saturatingSub(stats[2], entry->sectors_read) * 512.0 / seconds;
+      entry->write_rate = saturatingSub(stats[6], entry->sectors_written) * 512.0 / seconds;
+      entry->read_await = reads ? (double) readMs / reads : 0.0;
+      entry->write_await = writes ? (double) writeMs / writes : 0.0;
+      entry->await = reads + writes ? (double) (readMs + writeMs) / (reads + writes) : 0.0;
+      entry->queue_size = saturatingSub(stats[10], entry->queue_ms) / (double) timeDelta;
+      entry->utilization = (float) MINIMUM(100.0, saturatingSub(stats[9], entry->io_ms) * 100.0 / timeDelta);
+   }
+
+   entry->reads = stats[0];
+   entry->sectors_read = stats[2];
+   entry->read_ms = stats[3];
+   entry->writes = stats[4];
+   entry->sectors_written = stats[6];
+   entry->write_ms = stats[7];
+   entry->inflight = stats[8];
+   entry->io_ms = stats[9];
+   entry->queue_ms = stats[10];
+}
+
+static void DiskTable_iterateEntries(Table* super) {
+   DiskTable* this = (DiskTable*) super;
+   const Machine* host = super->host;
+
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/diskstats"), 0));
+   if (!content)
+      return;
+
+   /* partitions are listed directly after their disk */
+   int disk = 0;
+
+   do {
+      unsigned long long major = DataSource_nextNumber(&content);
+      unsigned long long minor = DataSource_nextNumber(&content);
+
+      const char* name;
+      size_t nameLen = DataSource_nextWord(&content, &name);
+      if (nameLen == 0 || nameLen >= sizeof(((DiskEntry*)NULL)->name))
+         continue;
+
+      /* reads, merged, sectors, ms, writes, merged, sectors, ms, in flight, io ms, weighted io ms */
+      unsigned long long stats[11];
+      for (size_t i = 0; i < ARRAYSIZE(stats); i++)
+         stats[i] = DataSource_nextNumber(&content);
+
+      /* loop and ram devices are only of interest once used */
+      if (stats[0] == 0 && stats[4] == 0 &&
+          ((nameLen > 4 && strncmp(name, "loop", 4) == 0) || (nameLen > 3 && strncmp(name, "ram", 3) == 0)))
+         continue;
+
+      int id = (int) (((major & 0x7ff) << 20) | (minor & 0xfffff));
+
+      bool preExisting;
+      DiskEntry* entry = DiskTable_getEntry(this, id, name, nameLen, &preExisting);
+      DiskTable_updateRates(entry, host, stats);
+
+      Row* row = &entry->super;
+      if (!entry->isPartition)
+         disk = id;
+      row->parent = entry->isPartition ? disk : 0;
+      row->isRoot = row->parent == 0;
+
+      if (!preExisting)
+         Table_add(super, row);
+      row->updated = true;
+      row->show = true;
+   } while (DataSource_skipLine(&content));
+}
+
+const TableClass DiskTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = DiskTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = DiskTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,28 @@
+#ifndef HEADER_DiskTable
+#define HEADER_DiskTable
+/*
+htop - linux/DiskTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Table.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+typedef struct DiskTable_ {
+   Table super;
+} DiskTable;
+
+extern const TableClass DiskTable_class;
+
+extern const LinuxDynamicScreenDefaults DiskTable_screen;
+
+Table* DiskTable_new(Machine* host);
+
+void DiskTable_done(DiskTable* this);
+
+#endif
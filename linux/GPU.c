@@ -13,6 +13,7 @@ in the source distribution for its full text.
 #include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
+#include <limits.h>
 #include <sys/types.h>
 
 #include "XUtils.h"
@@ -102,8 +103,8 @@ void GPU_readProcessData(LinuxProcessTable* lpt, LinuxProcess* lp, openat_arg_t
    fdinfoFd = -1;
 
 #ifndef HAVE_OPENAT
-   char fdinfoPathBuf[32];
-   xSnprintf(fdinfoPathBuf, sizeof(fdinfoPathBuf), PROCDIR "/%u/fdinfo", Process_getPid(&lp->super));
+   char fdinfoPathBuf[PATH_MAX];
+   LinuxMachine_procPath(fdinfoPathBuf, sizeof(fdinfoPathBuf), "/%u/fdinfo", Process_getPid(&lp->super));
 #endif
 
    while (true) {
@@ -0,0 +1,169 @@
+/*
+htop - linux/InterruptEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/InterruptEntry.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+InterruptEntry* InterruptEntry_new(const Machine* host, const Table* table) {
+   InterruptEntry* this = xCalloc(1, sizeof(InterruptEntry));
+   Object_setClass(this, Class(InterruptEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+
+   this->table = table;
+   this->hard_rate = NAN;
+   this->soft_rate = NAN;
+   this->share = NAN;
+
+   return this;
+}
+
+void InterruptEntry_done(InterruptEntry* this) {
+   Row_done(&this->super);
+}
+
+static void InterruptEntry_delete(Object* cast) {
+   InterruptEntry* this = (InterruptEntry*) cast;
+   InterruptEntry_done(this);
+   free(this);
+}
+
+static double InterruptEntry_rate(const InterruptEntry* this) {
+   if (isnan(this->hard_rate))
+      return this->soft_rate;
+   if (isnan(this->soft_rate))
+      return this->hard_rate;
+   return this->hard_rate + this->soft_rate;
+}
+
+static void InterruptEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const InterruptEntry* this = (const InterruptEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+   uint8_t width = column ? (uint8_t) MINIMUM(abs(column->width), DYNAMIC_MAX_COLUMN_WIDTH) : 5;
+
+   int local = LinuxDynamicColumn_field(settings, this->table, field);
+   switch (local) {
+   case INTERRUPT_NAME: Row_printLeftAlignedField(str, this->isCPU ? CRT_colors[PROCESS_BASENAME] : attr, this->name, width); return;
+   case INTERRUPT_CPU: xSnprintf(buffer, n, "%*d ", width, this->cpu); break;
+   case INTERRUPT_RATE: Row_printDecimal(InterruptEntry_rate(this), buffer, n, width, &attr); break;
+   case INTERRUPT_HARD_RATE: Row_printDecimal(this->hard_rate, buffer, n, width, &attr); break;
+   case INTERRUPT_SOFT_RATE: Row_printDecimal(this->soft_rate, buffer, n, width, &attr); break;
+   case INTERRUPT_SHARE: Row_printPercentage(this->share, buffer, n, width, &attr); break;
+   case INTERRUPT_COUNT: Row_printCount(str, this->count, coloring); return;
+   case INTERRUPT_DESCRIPTION:
+      Row_printLeftAlignedField(str, this->isCPU ? CRT_colors[PROCESS_SHADOW] : attr, this->description ? this->description : "", width);
+      return;
+   default:
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static const char* InterruptEntry_sortKeyString(Row* super) {
+   const InterruptEntry* this = (const InterruptEntry*) super;
+   return this->name;
+}
+
+static bool InterruptEntry_matchesFilter(const Row* super, const Table* table) {
+   const InterruptEntry* this = (const InterruptEntry*) super;
+   const char* incFilter = table->incFilter;
+   if (!incFilter)
+      return false;
+
+   return !String_contains_i(this->name, incFilter, true) &&
+          !(this->description && String_contains_i(this->description, incFilter, true));
+}
+
+static int InterruptEntry_compareByKey(const InterruptEntry* e1, const InterruptEntry* e2, int local) {
+   switch (local) {
+   case INTERRUPT_NAME:
+      return SPACESHIP_NULLSTR(e1->name, e2->name);
+   case INTERRUPT_CPU:
+      return SPACESHIP_NUMBER(e1->cpu, e2->cpu);
+   case INTERRUPT_RATE:
+      return compareRealNumbers(InterruptEntry_rate(e1), InterruptEntry_rate(e2));
+   case INTERRUPT_HARD_RATE:
+      return compareRealNumbers(e1->hard_rate, e2->hard_rate);
+   case INTERRUPT_SOFT_RATE:
+      return compareRealNumbers(e1->soft_rate, e2->soft_rate);
+   case INTERRUPT_SHARE:
+      return compareRealNumbers(e1->share, e2->share);
+   case INTERRUPT_COUNT:
+      return SPACESHIP_NUMBER(e1->count, e2->count);
+   case INTERRUPT_DESCRIPTION:
+      return SPACESHIP_NULLSTR(e1->description, e2->description);
+   default:
+      return 0;
+   }
+}
+
+static int InterruptEntry_compare(const void* v1, const void* v2) {
+   const InterruptEntry* e1 = (const InterruptEntry*)v1;
+   const InterruptEntry* e2 = (const InterruptEntry*)v2;
+   const Settings* settings = e1->super.host->settings;
+   const ScreenSettings* ss = settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int local = LinuxDynamicColumn_field(settings, e1->table, key);
+   int result = InterruptEntry_compareByKey(e1, e2, local);
+
+   // Implement tie-breaker (needed to make the sort order stable)
+   if (!result)
+      return SPACESHIP_NUMBER(e1->super.id, e2->super.id);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+/* In tree view, the sources of each CPU are ordered by the sort key as well */
+static int InterruptEntry_compareByParent(const Row* r1, const Row* r2) {
+   int result = SPACESHIP_NUMBER(
+      r1->isRoot ? 0 : Row_getGroupOrParent(r1),
+      r2->isRoot ? 0 : Row_getGroupOrParent(r2)
+   );
+
+   if (result != 0)
+      return result;
+
+   return InterruptEntry_compare(r1, r2);
+}
+
+const RowClass InterruptEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = InterruptEntry_delete,
+      .compare = InterruptEntry_compare,
+   },
+   .matchesFilter = InterruptEntry_matchesFilter,
+   .sortKeyString = InterruptEntry_sortKeyString,
+   .writeField = InterruptEntry_writeField,
+   .compareByParent = InterruptEntry_compareByParent,
+};
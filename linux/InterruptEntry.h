@@ -0,0 +1,57 @@
+#ifndef HEADER_InterruptEntry
+#define HEADER_InterruptEntry
+/*
+htop - linux/InterruptEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "Machine.h"
+#include "Row.h"
+
+
+/* Table-local fields, in the order of InterruptTable_columns[] */
+typedef enum InterruptField_ {
+   INTERRUPT_NAME = 0,
+   INTERRUPT_CPU,
+   INTERRUPT_RATE,
+   INTERRUPT_HARD_RATE,
+   INTERRUPT_SOFT_RATE,
+   INTERRUPT_SHARE,
+   INTERRUPT_COUNT,
+   INTERRUPT_DESCRIPTION,
+   INTERRUPT_LAST_FIELD
+} InterruptField;
+
+/*
+ * A row per CPU, with a child row for each interrupt source the CPU
+ * handled since boot: the tree view lists the top sources of each CPU.
+ */
+typedef struct InterruptEntry_ {
+   Row super;
+
+   const struct Table_* table;       /* owning table, to resolve sort keys */
+   int cpu;
+   bool isCPU;                       /* row of a CPU, summing all of its sources */
+   bool soft;                        /* softirq source, from /proc/softirqs */
+   char name[16];                    /* "CPU<n>", IRQ number or name, softirq name */
+   const char* description;          /* owned by the table: controller and devices, top source of a CPU */
+
+   unsigned long long count;         /* since boot */
+
+   /* over the last interval, NAN until two samples were taken */
+   double hard_rate;                 /* interrupts per second */
+   double soft_rate;
+   float share;                      /* of the source's interrupts; of all interrupts for a CPU */
+} InterruptEntry;
+
+extern const RowClass InterruptEntry_class;
+
+InterruptEntry* InterruptEntry_new(const Machine* host, const struct Table_* table);
+
+void InterruptEntry_done(InterruptEntry* this);
+
+#endif
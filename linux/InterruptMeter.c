@@ -0,0 +1,185 @@
+/*
+htop - linux/InterruptMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/InterruptMeter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Object.h"
+#include "ProvideCurses.h"
+#include "RichString.h"
+#include "XUtils.h"
+
+#include "linux/InterruptTable.h"
+#include "linux/LinuxDynamicScreen.h"
+
+
+/*
+ * A heatmap of the interrupt and softirq rates of each CPU, one line each.
+ * Every cell is a CPU, shaded relative to the busiest CPU of the line; with
+ * more CPUs than cells, a cell shows the busiest of several adjacent CPUs.
+ */
+
+#define INTERRUPT_METER_CAPTION_WIDTH 5
+#define INTERRUPT_METER_PEAK_WIDTH 7
+#define INTERRUPT_METER_LEVELS 4
+
+static const char* const InterruptMeter_glyphsAscii[INTERRUPT_METER_LEVELS + 1] = { ".", ":", "+", "*", "#" };
+#ifdef HAVE_LIBNCURSESW
+static const char* const InterruptMeter_glyphsUtf8[INTERRUPT_METER_LEVELS + 1] = { ".", "\xe2\x96\x91", "\xe2\x96\x92", "\xe2\x96\x93", "\xe2\x96\x88" };
+#endif
+
+static const int InterruptMeter_levelColors[INTERRUPT_METER_LEVELS + 1] = {
+   METER_SHADOW,
+   METER_VALUE_OK,
+   METER_VALUE_NOTICE,
+   METER_VALUE_WARN,
+   METER_VALUE_ERROR,
+};
+
+static const InterruptTable* InterruptMeter_table(void) {
+   const InterruptTable* table = (const InterruptTable*) LinuxDynamicScreens_table("interrupts");
+   return (table && table->nCPUs > 0) ? table : NULL;
+}
+
+/* Compact rate like "950", "12.3k" or "4.1M" */
+static int InterruptMeter_formatRate(char* buffer, size_t size, double rate) {
+   if (rate < 1000.0)
+      return xSnprintf(buffer, size, "%.0f", rate);
+   if (rate < 1000.0 * 1000.0)
+      return xSnprintf(buffer, size, "%.1fk", rate / 1000.0);
+   return xSnprintf(buffer, size, "%.1fM", rate / (1000.0 * 1000.0));
+}
+
+static void InterruptMeter_updateValues(Meter* this) {
+   const InterruptTable* table = InterruptMeter_table();
+   if (!table) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
+   }
+   if (isnan(table->hardRate)) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "init");
+      return;
+   }
+
+   char hard[16];
+   char soft[16];
+   InterruptMeter_formatRate(hard, sizeof(hard), table->hardRate);
+   InterruptMeter_formatRate(soft, sizeof(soft), table->softRate);
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "irq %s/s softirq %s/s", hard, soft);
+}
+
+static double InterruptMeter_cpuRate(const InterruptCPU* data, bool soft) {
+   double rate = soft ? data->softRate : data->hardRate;
+   return isNonnegative(rate) ? rate : 0.0;
+}
+
+static void InterruptMeter_drawLine(const InterruptTable* table, bool soft, int x, int y, int w) {
+   const char* const* glyphs = InterruptMeter_glyphsAscii;
+#ifdef HAVE_LIBNCURSESW
+   if (CRT_utf8)
+      glyphs = InterruptMeter_glyphsUtf8;
+#endif
+
+   attrset(CRT_colors[METER_TEXT]);
+   mvaddnstr(y, x, soft ? "SIRQ " : "IRQ  ", w);
+   int cells = w - INTERRUPT_METER_CAPTION_WIDTH - INTERRUPT_METER_PEAK_WIDTH;
+   if (cells <= 0) {
+      attrset(CRT_colors[RESET_COLOR]);
+      return;
+   }
+
+   unsigned int listed = 0;
+   double peak = 0.0;
+   for (unsigned int cpu = 0; cpu < table->nCPUs; cpu++) {
+      const InterruptCPU* data = &table->cpus[cpu];
+      if (!data->listed)
+         continue;
+      listed++;
+      peak = MAXIMUM(peak, InterruptMeter_cpuRate(data, soft));
+   }
+
+   unsigned int perCell = (listed + (unsigned int)cells - 1) / (unsigned int)cells;
+   if (perCell == 0)
+      perCell = 1;
+
+   int xx = x + INTERRUPT_METER_CAPTION_WIDTH;
+   unsigned int cpu = 0;
+   for (unsigned int cell = 0; cell * perCell < listed; cell++) {
+      double rate = 0.0;
+      for (unsigned int i = 0; i < perCell && cpu < table->nCPUs; cpu++) {
+         const InterruptCPU* data = &table->cpus[cpu];
+         if (!data->listed)
+            continue;
+         rate = MAXIMUM(rate, InterruptMeter_cpuRate(data, soft));
+         i++;
+      }
+
+      int level = peak > 0.0 ? (int) ceil(rate / peak * INTERRUPT_METER_LEVELS) : 0;
+      level = CLAMP(level, 0, INTERRUPT_METER_LEVELS);
+      attrset(CRT_colors[InterruptMeter_levelColors[level]]);
+      mvaddstr(y, xx++, glyphs[level]);
+   }
+
+   char buffer[16];
+   int len = InterruptMeter_formatRate(buffer, sizeof(buffer), peak);
+   attrset(CRT_colors[METER_VALUE]);
+   mvaddnstr(y, x + w - len, buffer, len);
+   attrset(CRT_colors[RESET_COLOR]);
+}
+
+static void InterruptMeter_draw(Meter* this, int x, int y, int w) {
+   const InterruptTable* table = InterruptMeter_table();
+   if (!table || isnan(table->hardRate)) {
+      attrset(CRT_colors[METER_TEXT]);
+      mvaddnstr(y, x, "IRQ  ", w);
+      if (w > INTERRUPT_METER_CAPTION_WIDTH) {
+         attrset(CRT_colors[table ? METER_VALUE : METER_VALUE_ERROR]);
+         mvaddnstr(y, x + INTERRUPT_METER_CAPTION_WIDTH, table ? "initializing..." : this->txtBuffer, w - INTERRUPT_METER_CAPTION_WIDTH);
+      }
+      attrset(CRT_colors[RESET_COLOR]);
+      return;
+   }
+
+   InterruptMeter_drawLine(table, false, x, y, w);
+   InterruptMeter_drawLine(table, true, x, y + 1, w);
+}
+
+static void InterruptMeter_updateMode(Meter* this, MeterModeId mode) {
+   this->mode = mode;
+   this->h = 2;
+}
+
+static void InterruptMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+   RichString_writeAscii(out, CRT_colors[METER_VALUE], this->txtBuffer);
+}
+
+const MeterClass InterruptMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = InterruptMeter_display,
+   },
+   .updateValues = InterruptMeter_updateValues,
+   .updateMode = InterruptMeter_updateMode,
+   .draw = InterruptMeter_draw,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 0,
+   .total = 0.0,
+   .name = "Interrupts",
+   .uiName = "Interrupts",
+   .description = "Interrupt and softirq rates of each CPU as a heatmap",
+   .caption = "IRQ",
+};
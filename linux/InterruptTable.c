@@ -0,0 +1,415 @@
+/*
+htop - linux/InterruptTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/InterruptTable.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/InterruptEntry.h"
+#include "linux/LinuxMachine.h"
+
+
+/* Row ids of the sources of a CPU carry the CPU id in their low bits */
+#define INTERRUPT_CPU_BITS 13
+#define INTERRUPT_MAX_CPUS (1U << INTERRUPT_CPU_BITS)
+#define INTERRUPT_MAX_SOURCES ((size_t)INT_MAX >> INTERRUPT_CPU_BITS)
+
+/* Indexed by InterruptField */
+static const LinuxDynamicColumnDefaults InterruptTable_columns[] = {
+   [INTERRUPT_NAME] = { .name = "name", .heading = "SOURCE", .description = "CPU, IRQ number or name from /proc/interrupts, softirq from /proc/softirqs", .width = -10, .enabled = true, },
+   [INTERRUPT_CPU] = { .name = "cpu", .heading = "CPU", .description = "CPU handling the interrupts", .width = 4, .enabled = true, },
+   [INTERRUPT_RATE] = { .name = "rate", .heading = "RATE/S", .description = "Interrupts and softirqs handled per second", .width = 9, .enabled = true, },
+   [INTERRUPT_HARD_RATE] = { .name = "irq_rate", .heading = "IRQ/S", .description = "Hardware interrupts handled per second", .width = 9, .enabled = true, },
+   [INTERRUPT_SOFT_RATE] = { .name = "softirq_rate", .heading = "SOFTIRQ/S", .description = "Softirqs handled per second", .width = 9, .enabled = true, },
+   [INTERRUPT_SHARE] = { .name = "share", .heading = "SHARE%", .description = "Percentage of the source's interrupts handled by the CPU; of all interrupts for a CPU", .width = 6, .enabled = true, },
+   [INTERRUPT_COUNT] = { .name = "count", .heading = "COUNT", .description = "Interrupts handled since boot", .width = 6, .enabled = false, },
+   [INTERRUPT_DESCRIPTION] = { .name = "description", .heading = "DESCRIPTION", .description = "Interrupt controller and devices; the busiest source for a CPU", .width = -32, .enabled = true, },
+};
+
+static_assert(ARRAYSIZE(InterruptTable_columns) == INTERRUPT_LAST_FIELD, "InterruptTable_columns must match InterruptField");
+
+const LinuxDynamicScreenDefaults InterruptTable_screen = {
+   .name = "interrupts",
+   .heading = "IRQs",
+   .caption = "Interrupts and softirqs per CPU, the busiest sources below their CPU in tree view (/proc/interrupts, /proc/softirqs)",
+   .sortKey = "rate",
+   .direction = -1,
+   .columns = InterruptTable_columns,
+   .totalColumns = ARRAYSIZE(InterruptTable_columns),
+   .newTable = InterruptTable_new,
+};
+
+Table* InterruptTable_new(Machine* host) {
+   InterruptTable* this = xCalloc(1, sizeof(InterruptTable));
+   Object_setClass(this, Class(InterruptTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(InterruptEntry), host);
+
+   char path[PATH_MAX];
+   this->interruptsSource = DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/interrupts"), 0);
+   this->softirqsSource = DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/softirqs"), 0);
+   this->hardRate = NAN;
+   this->softRate = NAN;
+
+   return super;
+}
+
+void InterruptTable_done(InterruptTable* this) {
+   Table_done(&this->super);
+
+   for (size_t i = 0; i < this->nSources; i++) {
+      InterruptSource* source = this->sources[i];
+      free(source->description);
+      free(source->counts);
+      free(source->rates);
+      free(source);
+   }
+   free(this->sources);
+   free(this->cpus);
+   free(this->columns);
+}
+
+static void InterruptTable_delete(Object* cast) {
+   InterruptTable* this = (InterruptTable*) cast;
+   InterruptTable_done(this);
+   free(this);
+}
+
+static void InterruptTable_ensureCPUs(InterruptTable* this, unsigned int count) {
+   if (count <= this->nCPUs)
+      return;
+
+   this->cpus = xReallocArrayZero(this->cpus, this->nCPUs, count, sizeof(InterruptCPU));
+   for (size_t i = 0; i < this->nSources; i++) {
+      InterruptSource* source = this->sources[i];
+      source->counts = xReallocArrayZero(source->counts, this->nCPUs, count, sizeof(*source->counts));
+      source->rates = xReallocArrayZero(source->rates, this->nCPUs, count, sizeof(*source->rates));
+   }
+   this->nCPUs = count;
+}
+
+/* Maps the columns of the header line "CPU0 CPU1 ..." to CPU ids, offline CPUs are left out */
+static size_t InterruptTable_readHeader(InterruptTable* this, const char** content) {
+   size_t nColumns = 0;
+   const char* word;
+   size_t len;
+
+   while ((len = DataSource_nextWord(content, &word)) > 0) {
+      if (len < 4 || strncmp(word, "CPU", 3) != 0)
+         continue;
+
+      unsigned long id = strtoul(word + 3, NULL, 10);
+      if (id >= INTERRUPT_MAX_CPUS)
+         continue;
+
+      if (nColumns == this->columnsCapacity) {
+         this->columnsCapacity = this->columnsCapacity ? this->columnsCapacity * 2 : 64;
+         this->columns = xReallocArray(this->columns, this->columnsCapacity, sizeof(*this->columns));
+      }
+      this->columns[nColumns++] = (unsigned int) id;
+      InterruptTable_ensureCPUs(this, (unsigned int) id + 1);
+   }
+
+   return nColumns;
+}
+
+static InterruptSource* InterruptTable_getSource(InterruptTable* this, const char* name, size_t len, bool soft, size_t* hint) {
+   /* the files list their sources in the same order each time */
+   for (size_t i = 0; i < this->nSources; i++) {
+      size_t at = (*hint + i) % this->nSources;
+      InterruptSource* source = this->sources[at];
+      if (source->soft == soft && strncmp(source->name, name, len) == 0 && source->name[len] == '\0') {
+         *hint = at + 1;
+         return source;
+      }
+   }
+
+   if (this->nSources >= INTERRUPT_MAX_SOURCES)
+      return NULL;
+
+   InterruptSource* source = xCalloc(1, sizeof(InterruptSource));
+   memcpy(source->name, name, len);
+   source->name[len] = '\0';
+   source->soft = soft;
+   source->counts = xCalloc(this->nCPUs, sizeof(*source->counts));
+   source->rates = xCalloc(this->nCPUs, sizeof(*source->rates));
+
+   this->sources = xReallocArray(this->sources, this->nSources + 1, sizeof(*this->sources));
+   this->sources[this->nSources++] = source;
+   *hint = this->nSources;
+   return source;
+}
+
+/* Rest of the line, with single blanks between the words */
+static void InterruptTable_updateDescription(InterruptSource* source, const char** content) {
+   char description[256];
+   size_t used = 0;
+   const char* word;
+   size_t len;
+
+   while ((len = DataSource_nextWord(content, &word)) > 0 && used < sizeof(description) - 1) {
+      if (used > 0)
+         description[used++] = ' ';
+      len = MINIMUM(len, sizeof(description) - 1 - used);
+      memcpy(description + used, word, len);
+      used += len;
+   }
+   description[used] = '\0';
+
+   if (!source->description || !String_eq(source->description, description))
+      free_and_xStrdup(&source->description, description);
+}
+
+/*
+ * Parses "  24:   1234   5678   PCI-MSI 327680-edge   eth0-rx-0" for each
+ * source; lines like "ERR:" with a single machine-wide counter are skipped.
+ */
+static void InterruptTable_readFile(InterruptTable* this, const char* content, bool soft, double seconds) {
+   size_t nColumns = InterruptTable_readHeader(this, &content);
+   if (nColumns == 0 || !DataSource_skipLine(&content))
+      return;
+
+   for (size_t c = 0; c < nColumns; c++)
+      this->cpus[this->columns[c]].listed = true;
+
+   size_t hint = 0;
+   do {
+      const char* name;
+      size_t len = DataSource_nextWord(&content, &name);
+      if (len < 2 || name[len - 1] != ':' || len - 1 >= sizeof(((InterruptSource*)NULL)->name))
+         continue;
+
+      const char* counters = content;
+      size_t found = 0;
+      const char* word;
+      while (found < nColumns && DataSource_nextWord(&content, &word) > 0 && isdigit((unsigned char)word[0]))
+         found++;
+      if (found < nColumns)
+         continue;
+
+      InterruptSource* source = InterruptTable_getSource(this, name, len - 1, soft, &hint);
+      if (!source)
+         continue;
+
+      content = counters;
+      for (size_t c = 0; c < nColumns; c++) {
+         unsigned int cpu = this->columns[c];
+         unsigned long long count = DataSource_nextNumber(&content);
+         source->rates[cpu] = (source->sampled && seconds > 0.0) ? saturatingSub(count, source->counts[cpu]) / seconds : NAN;
+         source->counts[cpu] = count;
+      }
+      source->sampled = true;
+      source->listed = true;
+
+      if (!soft)
+         InterruptTable_updateDescription(source, &content);
+   } while (DataSource_skipLine(&content));
+}
+
+/* Whether a source keeps a CPU busier than another, by rate or before the first interval by count */
+static bool InterruptTable_busier(const InterruptSource* source, const InterruptSource* other, unsigned int cpu) {
+   double rate = isNonnegative(source->rates[cpu]) ? source->rates[cpu] : -1.0;
+   double otherRate = isNonnegative(other->rates[cpu]) ? other->rates[cpu] : -1.0;
+   if (rate > otherRate || rate < otherRate)
+      return rate > otherRate;
+   return source->counts[cpu] > other->counts[cpu];
+}
+
+/* Keeps the INTERRUPT_SOURCES_PER_CPU busiest sources of a CPU */
+static void InterruptTable_rankSource(const InterruptTable* this, InterruptCPU* data, unsigned int cpu, size_t index) {
+   const InterruptSource* source = this->sources[index];
+   size_t at = data->nSources;
+   while (at > 0 && InterruptTable_busier(source, this->sources[data->sources[at - 1]], cpu))
+      at--;
+   if (at >= INTERRUPT_SOURCES_PER_CPU)
+      return;
+
+   size_t last = MINIMUM(data->nSources, INTERRUPT_SOURCES_PER_CPU - 1);
+   memmove(&data->sources[at + 1], &data->sources[at], (last - at) * sizeof(*data->sources));
+   data->sources[at] = index;
+   if (data->nSources < INTERRUPT_SOURCES_PER_CPU)
+      data->nSources++;
+}
+
+static void InterruptTable_aggregate(InterruptTable* this, bool haveRates) {
+   for (unsigned int cpu = 0; cpu < this->nCPUs; cpu++) {
+      InterruptCPU* data = &this->cpus[cpu];
+      data->count = 0;
+      data->hardRate = haveRates ? 0.0 : NAN;
+      data->softRate = haveRates ? 0.0 : NAN;
+      data->top = NULL;
+      data->nSources = 0;
+   }
+   this->hardRate = haveRates ? 0.0 : NAN;
+   this->softRate = haveRates ? 0.0 : NAN;
+
+   for (size_t i = 0; i < this->nSources; i++) {
+      InterruptSource* source = this->sources[i];
+      source->rate = 0.0;
+
+      /* gone from the file (e.g. a device unplugged): no rates, and no
+         delta against its old counts should it come back */
+      if (!source->listed) {
+         source->sampled = false;
+         continue;
+      }
+
+      for (unsigned int cpu = 0; cpu < this->nCPUs; cpu++) {
+         InterruptCPU* data = &this->cpus[cpu];
+         if (!data->listed)
+            continue;
+
+         data->count += source->counts[cpu];
+         if (source->counts[cpu] > 0)
+            InterruptTable_rankSource(this, data, cpu, i);
+
+         double rate = source->rates[cpu];
+         if (!haveRates || !isNonnegative(rate))
+            continue;
+
+         source->rate += rate;
+         if (source->soft)
+            data->softRate += rate;
+         else
+            data->hardRate += rate;
+
+         if (rate > 0.0 && (!data->top || rate > data->top->rates[cpu]))
+            data->top = source;
+      }
+
+      if (source->soft)
+         this->softRate += source->rate;
+      else
+         this->hardRate += source->rate;
+   }
+}
+
+static InterruptEntry* InterruptTable_getEntry(InterruptTable* this, int id, bool* preExisting) {
+   Table* super = &this->super;
+   InterruptEntry* entry = (InterruptEntry*) Hashtable_get(super->table, id);
+   *preExisting = entry != NULL;
+   if (entry) {
+      assert(Vector_indexOf(super->rows, entry, Row_idEqualCompare) != -1);
+      assert(entry->super.id == id);
+   } else {
+      entry = InterruptEntry_new(super->host, super);
+      entry->super.id = id;
+   }
+   return entry;
+}
+
+static void InterruptTable_addEntry(InterruptTable* this, InterruptEntry* entry, bool preExisting) {
+   Row* row = &entry->super;
+   if (!preExisting)
+      Table_add(&this->super, row);
+   row->updated = true;
+   row->show = true;
+}
+
+static void InterruptTable_iterateEntries(Table* super) {
+   InterruptTable* this = (InterruptTable*) super;
+   const Machine* host = super->host;
+
+   uint64_t timeDelta = this->lastScanMs ? saturatingSub(host->realtimeMs, this->lastScanMs) : 0;
+   double seconds = timeDelta / 1000.0;
+   this->lastScanMs = host->realtimeMs;
+
+   for (unsigned int cpu = 0; cpu < this->nCPUs; cpu++)
+      this->cpus[cpu].listed = false;
+   for (size_t i = 0; i < this->nSources; i++)
+      this->sources[i]->listed = false;
+
+   const char* content = DataSource_read(this->interruptsSource);
+   if (content)
+      InterruptTable_readFile(this, content, false, seconds);
+
+   content = DataSource_read(this->softirqsSource);
+   if (content)
+      InterruptTable_readFile(this, content, true, seconds);
+
+   InterruptTable_aggregate(this, timeDelta > 0);
+
+   const double totalRate = this->hardRate + this->softRate;
+
+   for (unsigned int cpu = 0; cpu < this->nCPUs; cpu++) {
+      const InterruptCPU* data = &this->cpus[cpu];
+      if (!data->listed)
+         continue;
+
+      bool preExisting;
+      InterruptEntry* entry = InterruptTable_getEntry(this, (int) cpu + 1, &preExisting);
+      if (!preExisting) {
+         entry->cpu = (int) cpu;
+         entry->isCPU = true;
+         xSnprintf(entry->name, sizeof(entry->name), "CPU%u", cpu);
+      }
+      entry->count = data->count;
+      entry->hard_rate = data->hardRate;
+      entry->soft_rate = data->softRate;
+      entry->share = totalRate > 0.0 ? (float) ((data->hardRate + data->softRate) * 100.0 / totalRate) : NAN;
+      entry->description = data->top ? data->top->name : NULL;
+      entry->super.parent = 0;
+      entry->super.isRoot = true;
+      InterruptTable_addEntry(this, entry, preExisting);
+   }
+
+   /* hosts with hundreds of CPUs would otherwise list tens of thousands of pairs */
+   for (unsigned int cpu = 0; cpu < this->nCPUs; cpu++) {
+      const InterruptCPU* data = &this->cpus[cpu];
+      if (!data->listed)
+         continue;
+
+      for (size_t k = 0; k < data->nSources; k++) {
+         size_t i = data->sources[k];
+         const InterruptSource* source = this->sources[i];
+
+         bool preExisting;
+         InterruptEntry* entry = InterruptTable_getEntry(this, (int) (((i + 1) << INTERRUPT_CPU_BITS) | cpu), &preExisting);
+         if (!preExisting) {
+            entry->cpu = (int) cpu;
+            entry->soft = source->soft;
+            memcpy(entry->name, source->name, sizeof(entry->name));
+         }
+
+         double rate = source->rates[cpu];
+         double other = isnan(rate) ? NAN : 0.0;
+         entry->count = source->counts[cpu];
+         entry->hard_rate = source->soft ? other : rate;
+         entry->soft_rate = source->soft ? rate : other;
+         entry->share = source->rate > 0.0 ? (float) (rate * 100.0 / source->rate) : NAN;
+         entry->description = source->description;
+         entry->super.parent = (int) cpu + 1;
+         entry->super.isRoot = false;
+         InterruptTable_addEntry(this, entry, preExisting);
+      }
+   }
+}
+
+const TableClass InterruptTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = InterruptTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = InterruptTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,75 @@
+#ifndef HEADER_InterruptTable
+#define HEADER_InterruptTable
+/*
+htop - linux/InterruptTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Table.h"
+
+#include "linux/DataSource.h"
+#include "linux/LinuxDynamicScreen.h"
+
+
+/* A line of /proc/interrupts or /proc/softirqs with its counters per CPU */
+typedef struct InterruptSource_ {
+   char name[16];
+   char* description;                /* controller and devices, NULL for softirqs */
+   bool soft;
+   bool sampled;                     /* counts hold a previous sample */
+   bool listed;                      /* a line in the last read */
+   unsigned long long* counts;       /* cumulative, indexed by CPU id */
+   double* rates;                    /* per second over the last interval, indexed by CPU id */
+   double rate;                      /* summed over all CPUs */
+} InterruptSource;
+
+/* Sources listed below each CPU, the others only count towards its totals */
+#define INTERRUPT_SOURCES_PER_CPU 8
+
+typedef struct InterruptCPU_ {
+   bool listed;                      /* a column in the last read */
+   unsigned long long count;         /* since boot, all sources */
+   double hardRate;                  /* per second, NAN until two samples were taken */
+   double softRate;
+   const InterruptSource* top;       /* busiest source over the last interval */
+   size_t sources[INTERRUPT_SOURCES_PER_CPU];  /* indexes of its busiest sources, by decreasing rate */
+   size_t nSources;
+} InterruptCPU;
+
+typedef struct InterruptTable_ {
+   Table super;
+
+   DataSource* interruptsSource;     /* kept open between reads */
+   DataSource* softirqsSource;
+
+   InterruptSource** sources;        /* in order of their first appearance, never removed but skipped while not listed */
+   size_t nSources;
+
+   /* indexed by CPU id, nCPUs is the highest CPU id seen plus one */
+   InterruptCPU* cpus;
+   unsigned int nCPUs;
+
+   unsigned int* columns;            /* CPU id of each column of the file being parsed */
+   size_t columnsCapacity;
+
+   double hardRate;                  /* per second, all CPUs */
+   double softRate;
+   uint64_t lastScanMs;              /* realtime of the previous sample, 0 if none */
+} InterruptTable;
+
+extern const TableClass InterruptTable_class;
+
+extern const LinuxDynamicScreenDefaults InterruptTable_screen;
+
+Table* InterruptTable_new(Machine* host);
+
+void InterruptTable_done(InterruptTable* this);
+
+#endif
@@ -0,0 +1,586 @@
+/*
+htop - linux/LibBpf.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#ifndef HAVE_BPF
+#error Compiling this file requires HAVE_BPF
+#endif
+
+#include "linux/LibBpf.h"
+
+#include <assert.h>
+#include <dlfcn.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/bpf.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#include "Macros.h"
+#include "Process.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/LinuxMachine.h"
+#include "linux/LinuxProcess.h"
+
+
+/*
+ * Scheduler latency collector: small BPF programs on the sched_switch,
+ * sched_wakeup and sched_wakeup_new tracepoints keep a log2 histogram of
+ * the run queue delay and of the time off the CPU of each thread group.
+ * The programs are assembled here, with the tracepoint field offsets read
+ * from tracefs, so neither a BPF compiler nor BTF is needed; libbpf is only
+ * used for its low-level map and program API, which is declared here to
+ * need no headers at build time.
+ */
+
+static void* libbpfHandle;
+
+static int (*sym_bpf_map_create)(enum bpf_map_type, const char*, uint32_t, uint32_t, uint32_t, const void*);
+static int (*sym_bpf_prog_load)(enum bpf_prog_type, const char*, const char*, const struct bpf_insn*, size_t, const void*);
+static int (*sym_bpf_map_lookup_elem)(int, const void*, void*);
+static int (*sym_bpf_map_delete_elem)(int, const void*);
+static int (*sym_bpf_map_get_next_key)(int, const void*, void*);
+
+static void unload_libbpf(void) {
+   sym_bpf_map_create = NULL;
+   sym_bpf_prog_load = NULL;
+   sym_bpf_map_lookup_elem = NULL;
+   sym_bpf_map_delete_elem = NULL;
+   sym_bpf_map_get_next_key = NULL;
+
+   if (libbpfHandle) {
+      dlclose(libbpfHandle);
+      libbpfHandle = NULL;
+   }
+}
+
+static int load_libbpf(void) {
+   if (libbpfHandle)
+      return 0;
+
+   libbpfHandle = dlopen("libbpf.so.1", RTLD_LAZY);
+   if (!libbpfHandle) {
+      libbpfHandle = dlopen("libbpf.so", RTLD_LAZY);
+      if (!libbpfHandle) {
+         goto dlfailure;
+      }
+   }
+
+   /* Clear any errors */
+   dlerror();
+
+   #define resolve(symbolname) do {                                      \
+      *(void **)(&sym_##symbolname) = dlsym(libbpfHandle, #symbolname);  \
+      if (!sym_##symbolname || dlerror() != NULL) {                      \
+         goto dlfailure;                                                 \
+      }                                                                  \
+   } while(0)
+
+   resolve(bpf_map_create);
+   resolve(bpf_prog_load);
+   resolve(bpf_map_lookup_elem);
+   resolve(bpf_map_delete_elem);
+   resolve(bpf_map_get_next_key);
+
+   #undef resolve
+
+   return 0;
+
+dlfailure:
+   unload_libbpf();
+   return -1;
+}
+
+/* log2 buckets of microseconds; the last one also holds everything longer */
+#define SCHED_LATENCY_SLOTS 32
+
+/* Thread groups and tasks tracked between two reads */
+#define SCHED_LATENCY_MAX_GROUPS 4096
+#define SCHED_LATENCY_MAX_TASKS 65536
+
+typedef struct SchedTask_ {
+   uint64_t queuedNs;                /* woken up or preempted, 0 while blocked or running */
+   uint64_t offNs;                   /* switched out, 0 while running */
+   uint32_t tgid;
+   uint32_t pad;
+} SchedTask;
+
+typedef struct SchedHistogram_ {
+   uint64_t runq[SCHED_LATENCY_SLOTS];
+   uint64_t offcpu[SCHED_LATENCY_SLOTS];
+} SchedHistogram;
+
+typedef struct SchedLatency_ {
+   bool failed;                      /* not available, not tried again */
+   int tasksFd;                      /* tid -> SchedTask */
+   int histogramsFd;                 /* tgid -> SchedHistogram */
+   int zeroFd;                       /* one zeroed SchedHistogram to create entries from */
+   int switchFd;
+   int wakeupFd;
+   int* eventFds;                    /* tracepoint events on each CPU the programs are attached to */
+   size_t nEventFds;
+   uint32_t* keys;                   /* thread groups of the current read */
+} SchedLatency;
+
+/* Tracepoint fields the programs read */
+typedef struct SchedFormat_ {
+   int prevPid;
+   int prevState;
+   int prevStateSize;
+   int nextPid;
+   int wakeupPid;
+} SchedFormat;
+
+#define BPF_MAX_INSNS 160
+
+typedef struct BpfProgram_ {
+   struct bpf_insn insns[BPF_MAX_INSNS];
+   size_t count;
+} BpfProgram;
+
+static size_t BpfProgram_emit(BpfProgram* this, uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+   assert(this->count < BPF_MAX_INSNS);
+   struct bpf_insn* insn = &this->insns[this->count];
+   memset(insn, 0, sizeof(*insn));
+   insn->code = code;
+   insn->dst_reg = dst & 0xf;
+   insn->src_reg = src & 0xf;
+   insn->off = off;
+   insn->imm = imm;
+   return this->count++;
+}
+
+/* Lets a forward jump emitted earlier land on the next instruction */
+static void BpfProgram_land(BpfProgram* this, size_t jump) {
+   this->insns[jump].off = (int16_t) (this->count - jump - 1);
+}
+
+#define EMIT_MOV(p, dst, src)        BpfProgram_emit(p, BPF_ALU64 | BPF_MOV | BPF_X, dst, src, 0, 0)
+#define EMIT_MOV_IMM(p, dst, imm)    BpfProgram_emit(p, BPF_ALU64 | BPF_MOV | BPF_K, dst, 0, 0, imm)
+#define EMIT_ALU(p, op, dst, src)    BpfProgram_emit(p, BPF_ALU64 | (op) | BPF_X, dst, src, 0, 0)
+#define EMIT_ALU_IMM(p, op, dst, imm) BpfProgram_emit(p, BPF_ALU64 | (op) | BPF_K, dst, 0, 0, imm)
+#define EMIT_LOAD(p, size, dst, src, off) BpfProgram_emit(p, BPF_LDX | (size) | BPF_MEM, dst, src, off, 0)
+#define EMIT_STORE(p, size, dst, src, off) BpfProgram_emit(p, BPF_STX | (size) | BPF_MEM, dst, src, off, 0)
+#define EMIT_STORE_IMM(p, size, dst, off, imm) BpfProgram_emit(p, BPF_ST | (size) | BPF_MEM, dst, 0, off, imm)
+#define EMIT_ATOMIC_ADD(p, dst, src, off) BpfProgram_emit(p, BPF_STX | BPF_DW | BPF_XADD, dst, src, off, BPF_ADD)
+#define EMIT_JUMP_IMM(p, op, dst, imm, off) BpfProgram_emit(p, BPF_JMP | (op) | BPF_K, dst, 0, off, imm)
+#define EMIT_CALL(p, func)           BpfProgram_emit(p, BPF_JMP | BPF_CALL, 0, 0, 0, func)
+#define EMIT_EXIT(p)                 BpfProgram_emit(p, BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+
+static void BpfProgram_loadMap(BpfProgram* this, uint8_t dst, int fd) {
+   BpfProgram_emit(this, BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, fd);
+   BpfProgram_emit(this, 0, 0, 0, 0, 0);
+}
+
+/* r2 = r10 + off, the address of a key on the stack */
+static void BpfProgram_stackAddress(BpfProgram* this, uint8_t dst, int16_t off) {
+   EMIT_MOV(this, dst, BPF_REG_10);
+   EMIT_ALU_IMM(this, BPF_ADD, dst, off);
+}
+
+/* Counts the nanoseconds in r1 into the log2 bucket of microseconds at byte offset base of the histogram in r8; clobbers r1 to r3 */
+static void BpfProgram_countInto(BpfProgram* this, int16_t base) {
+   EMIT_ALU_IMM(this, BPF_DIV, BPF_REG_1, 1000);
+   EMIT_MOV_IMM(this, BPF_REG_3, 0);
+
+   /* floor(log2(r1)) by halving the remaining bits */
+   static const int32_t shifts[] = { 32, 16, 8, 4, 2, 1 };
+   for (size_t i = 0; i < ARRAYSIZE(shifts); i++) {
+      EMIT_MOV(this, BPF_REG_2, BPF_REG_1);
+      EMIT_ALU_IMM(this, BPF_RSH, BPF_REG_2, shifts[i]);
+      EMIT_JUMP_IMM(this, BPF_JEQ, BPF_REG_2, 0, 2);
+      EMIT_MOV(this, BPF_REG_1, BPF_REG_2);
+      EMIT_ALU_IMM(this, BPF_ADD, BPF_REG_3, shifts[i]);
+   }
+
+   EMIT_JUMP_IMM(this, BPF_JLE, BPF_REG_3, SCHED_LATENCY_SLOTS - 1, 1);
+   EMIT_MOV_IMM(this, BPF_REG_3, SCHED_LATENCY_SLOTS - 1);
+   EMIT_ALU_IMM(this, BPF_LSH, BPF_REG_3, 3);
+   EMIT_MOV(this, BPF_REG_2, BPF_REG_8);
+   EMIT_ALU(this, BPF_ADD, BPF_REG_2, BPF_REG_3);
+   EMIT_MOV_IMM(this, BPF_REG_1, 1);
+   EMIT_ATOMIC_ADD(this, BPF_REG_2, BPF_REG_1, base);
+}
+
+/* sched_wakeup and sched_wakeup_new: the task is queued from now on */
+static void SchedLatency_assembleWakeup(BpfProgram* p, const SchedLatency* this, const SchedFormat* format) {
+   EMIT_LOAD(p, BPF_W, BPF_REG_1, BPF_REG_1, (int16_t) format->wakeupPid);
+   EMIT_STORE(p, BPF_W, BPF_REG_10, BPF_REG_1, -4);
+   BpfProgram_loadMap(p, BPF_REG_1, this->tasksFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -4);
+   EMIT_CALL(p, BPF_FUNC_map_lookup_elem);
+   size_t unknown = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_0, 0, 0);
+
+   EMIT_MOV(p, BPF_REG_6, BPF_REG_0);
+   EMIT_CALL(p, BPF_FUNC_ktime_get_ns);
+   EMIT_STORE(p, BPF_DW, BPF_REG_6, BPF_REG_0, offsetof(SchedTask, queuedNs));
+
+   BpfProgram_land(p, unknown);
+   EMIT_MOV_IMM(p, BPF_REG_0, 0);
+   EMIT_EXIT(p);
+}
+
+/*
+ * sched_switch: the previous task, the current one, goes off the CPU and
+ * is queued again right away unless it blocks; the next one has its delays
+ * counted into the histogram of its thread group.
+ *
+ * Stack: SchedTask at -24, tid key at -28, tgid key at -32, zero key at -36
+ */
+static void SchedLatency_assembleSwitch(BpfProgram* p, const SchedLatency* this, const SchedFormat* format) {
+   size_t done[4];
+   size_t nDone = 0;
+
+   EMIT_MOV(p, BPF_REG_6, BPF_REG_1);
+   EMIT_CALL(p, BPF_FUNC_ktime_get_ns);
+   EMIT_MOV(p, BPF_REG_7, BPF_REG_0);
+
+   EMIT_CALL(p, BPF_FUNC_get_current_pid_tgid);
+   EMIT_ALU_IMM(p, BPF_RSH, BPF_REG_0, 32);
+   EMIT_STORE(p, BPF_W, BPF_REG_10, BPF_REG_0, -24 + (int16_t) offsetof(SchedTask, tgid));
+   EMIT_STORE_IMM(p, BPF_W, BPF_REG_10, -24 + (int16_t) offsetof(SchedTask, pad), 0);
+   EMIT_STORE(p, BPF_DW, BPF_REG_10, BPF_REG_7, -24 + (int16_t) offsetof(SchedTask, offNs));
+   EMIT_STORE_IMM(p, BPF_DW, BPF_REG_10, -24 + (int16_t) offsetof(SchedTask, queuedNs), 0);
+
+   /* still runnable (TASK_RUNNING is 0): preempted; the kernel reports a
+      preemption as TASK_REPORT_MAX (0x100), above the state bits */
+   EMIT_LOAD(p, format->prevStateSize == 8 ? BPF_DW : BPF_W, BPF_REG_1, BPF_REG_6, (int16_t) format->prevState);
+   EMIT_ALU_IMM(p, BPF_AND, BPF_REG_1, 0xff);
+   size_t blocked = EMIT_JUMP_IMM(p, BPF_JNE, BPF_REG_1, 0, 0);
+   EMIT_STORE(p, BPF_DW, BPF_REG_10, BPF_REG_7, -24 + (int16_t) offsetof(SchedTask, queuedNs));
+   BpfProgram_land(p, blocked);
+
+   EMIT_LOAD(p, BPF_W, BPF_REG_1, BPF_REG_6, (int16_t) format->prevPid);
+   size_t idle = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_1, 0, 0);
+   EMIT_STORE(p, BPF_W, BPF_REG_10, BPF_REG_1, -28);
+   BpfProgram_loadMap(p, BPF_REG_1, this->tasksFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -28);
+   BpfProgram_stackAddress(p, BPF_REG_3, -24);
+   EMIT_MOV_IMM(p, BPF_REG_4, BPF_ANY);
+   EMIT_CALL(p, BPF_FUNC_map_update_elem);
+   BpfProgram_land(p, idle);
+
+   /* the next task, if it was seen going off the CPU before */
+   EMIT_LOAD(p, BPF_W, BPF_REG_1, BPF_REG_6, (int16_t) format->nextPid);
+   EMIT_STORE(p, BPF_W, BPF_REG_10, BPF_REG_1, -28);
+   BpfProgram_loadMap(p, BPF_REG_1, this->tasksFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -28);
+   EMIT_CALL(p, BPF_FUNC_map_lookup_elem);
+   done[nDone++] = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_0, 0, 0);
+   EMIT_MOV(p, BPF_REG_9, BPF_REG_0);
+
+   EMIT_LOAD(p, BPF_W, BPF_REG_1, BPF_REG_9, offsetof(SchedTask, tgid));
+   EMIT_STORE(p, BPF_W, BPF_REG_10, BPF_REG_1, -32);
+   BpfProgram_loadMap(p, BPF_REG_1, this->histogramsFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -32);
+   EMIT_CALL(p, BPF_FUNC_map_lookup_elem);
+   size_t found = EMIT_JUMP_IMM(p, BPF_JNE, BPF_REG_0, 0, 0);
+
+   /* first event of the thread group since the last read */
+   EMIT_STORE_IMM(p, BPF_W, BPF_REG_10, -36, 0);
+   BpfProgram_loadMap(p, BPF_REG_1, this->zeroFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -36);
+   EMIT_CALL(p, BPF_FUNC_map_lookup_elem);
+   done[nDone++] = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_0, 0, 0);
+   EMIT_MOV(p, BPF_REG_3, BPF_REG_0);
+   BpfProgram_loadMap(p, BPF_REG_1, this->histogramsFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -32);
+   EMIT_MOV_IMM(p, BPF_REG_4, BPF_NOEXIST);
+   EMIT_CALL(p, BPF_FUNC_map_update_elem);
+   BpfProgram_loadMap(p, BPF_REG_1, this->histogramsFd);
+   BpfProgram_stackAddress(p, BPF_REG_2, -32);
+   EMIT_CALL(p, BPF_FUNC_map_lookup_elem);
+   done[nDone++] = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_0, 0, 0);
+
+   BpfProgram_land(p, found);
+   EMIT_MOV(p, BPF_REG_8, BPF_REG_0);
+
+   EMIT_LOAD(p, BPF_DW, BPF_REG_2, BPF_REG_9, offsetof(SchedTask, queuedNs));
+   size_t notQueued = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_2, 0, 0);
+   EMIT_MOV(p, BPF_REG_1, BPF_REG_7);
+   EMIT_ALU(p, BPF_SUB, BPF_REG_1, BPF_REG_2);
+   BpfProgram_countInto(p, offsetof(SchedHistogram, runq));
+   BpfProgram_land(p, notQueued);
+
+   EMIT_LOAD(p, BPF_DW, BPF_REG_2, BPF_REG_9, offsetof(SchedTask, offNs));
+   size_t notOff = EMIT_JUMP_IMM(p, BPF_JEQ, BPF_REG_2, 0, 0);
+   EMIT_MOV(p, BPF_REG_1, BPF_REG_7);
+   EMIT_ALU(p, BPF_SUB, BPF_REG_1, BPF_REG_2);
+   BpfProgram_countInto(p, offsetof(SchedHistogram, offcpu));
+   BpfProgram_land(p, notOff);
+
+   EMIT_STORE_IMM(p, BPF_DW, BPF_REG_9, offsetof(SchedTask, queuedNs), 0);
+   EMIT_STORE_IMM(p, BPF_DW, BPF_REG_9, offsetof(SchedTask, offNs), 0);
+
+   for (size_t i = 0; i < nDone; i++)
+      BpfProgram_land(p, done[i]);
+   EMIT_MOV_IMM(p, BPF_REG_0, 0);
+   EMIT_EXIT(p);
+}
+
+static const char* SchedLatency_tracefs(void) {
+   static const char* const roots[] = { "/sys/kernel/tracing", "/sys/kernel/debug/tracing" };
+   for (size_t i = 0; i < ARRAYSIZE(roots); i++) {
+      char path[64];
+      xSnprintf(path, sizeof(path), "%s/events/sched", roots[i]);
+      if (access(path, R_OK) == 0)
+         return roots[i];
+   }
+   return NULL;
+}
+
+/* Reads the id and format of a tracepoint */
+static int SchedLatency_readEvent(const char* tracefs, const char* event, char* format, size_t size) {
+   char path[128];
+   char buffer[32];
+
+   xSnprintf(path, sizeof(path), "%s/events/sched/%s/id", tracefs, event);
+   if (xReadfile(path, buffer, sizeof(buffer)) <= 0)
+      return -1;
+   int id = atoi(buffer);
+
+   xSnprintf(path, sizeof(path), "%s/events/sched/%s/format", tracefs, event);
+   if (format && xReadfile(path, format, size) <= 0)
+      return -1;
+
+   return id;
+}
+
+/* Finds "<type> <name>;\toffset:N;\tsize:M;" in a tracepoint format */
+static bool SchedLatency_field(const char* format, const char* name, int* offset, int* size) {
+   char pattern[32];
+   xSnprintf(pattern, sizeof(pattern), " %s;", name);
+
+   const char* field = strstr(format, pattern);
+   if (!field)
+      return false;
+
+   int fieldSize;
+   if (sscanf(field + strlen(pattern), " offset:%d; size:%d;", offset, &fieldSize) != 2)
+      return false;
+
+   if (size)
+      *size = fieldSize;
+   return *offset > 0 && *offset < INT16_MAX;
+}
+
+static bool SchedLatency_attach(SchedLatency* this, const Machine* host, int id, int programFd) {
+   for (unsigned int cpu = 0; cpu < host->existingCPUs; cpu++) {
+      if (!Machine_isCPUonline(host, cpu))
+         continue;
+
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_TRACEPOINT;
+      attr.config = (uint64_t) id;
+      attr.sample_period = 1;
+      attr.wakeup_events = 1;
+
+      int fd = (int) syscall(SYS_perf_event_open, &attr, -1, (int) cpu, -1, PERF_FLAG_FD_CLOEXEC);
+      if (fd < 0)
+         return false;
+
+      this->eventFds = xReallocArray(this->eventFds, this->nEventFds + 1, sizeof(*this->eventFds));
+      this->eventFds[this->nEventFds++] = fd;
+
+      if (ioctl(fd, PERF_EVENT_IOC_SET_BPF, programFd) != 0 || ioctl(fd, PERF_EVENT_IOC_ENABLE, 0) != 0)
+         return false;
+   }
+
+   return true;
+}
+
+static void SchedLatency_close(SchedLatency* this) {
+   for (size_t i = 0; i < this->nEventFds; i++)
+      close(this->eventFds[i]);
+   free(this->eventFds);
+   this->eventFds = NULL;
+   this->nEventFds = 0;
+
+   int* fds[] = { &this->switchFd, &this->wakeupFd, &this->tasksFd, &this->histogramsFd, &this->zeroFd };
+   for (size_t i = 0; i < ARRAYSIZE(fds); i++) {
+      if (*fds[i] >= 0)
+         close(*fds[i]);
+      *fds[i] = -1;
+   }
+
+   free(this->keys);
+   this->keys = NULL;
+}
+
+static bool SchedLatency_start(SchedLatency* this, const Machine* host) {
+   if (load_libbpf() != 0)
+      return false;
+
+   const char* tracefs = SchedLatency_tracefs();
+   if (!tracefs)
+      return false;
+
+   char format[4096];
+   SchedFormat fields;
+
+   int wakeupNewId = SchedLatency_readEvent(tracefs, "sched_wakeup_new", NULL, 0);
+   int wakeupId = SchedLatency_readEvent(tracefs, "sched_wakeup", format, sizeof(format));
+   if (wakeupId < 0 || wakeupNewId < 0 || !SchedLatency_field(format, "pid", &fields.wakeupPid, NULL))
+      return false;
+
+   int switchId = SchedLatency_readEvent(tracefs, "sched_switch", format, sizeof(format));
+   if (switchId < 0 ||
+       !SchedLatency_field(format, "prev_pid", &fields.prevPid, NULL) ||
+       !SchedLatency_field(format, "prev_state", &fields.prevState, &fields.prevStateSize) ||
+       !SchedLatency_field(format, "next_pid", &fields.nextPid, NULL))
+      return false;
+
+   this->tasksFd = sym_bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "htop_sched_task", sizeof(uint32_t), sizeof(SchedTask), SCHED_LATENCY_MAX_TASKS, NULL);
+   this->histogramsFd = sym_bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "htop_sched_hist", sizeof(uint32_t), sizeof(SchedHistogram), SCHED_LATENCY_MAX_GROUPS, NULL);
+   this->zeroFd = sym_bpf_map_create(BPF_MAP_TYPE_ARRAY, "htop_sched_zero", sizeof(uint32_t), sizeof(SchedHistogram), 1, NULL);
+   if (this->tasksFd < 0 || this->histogramsFd < 0 || this->zeroFd < 0)
+      return false;
+
+   BpfProgram program = { .count = 0 };
+   SchedLatency_assembleWakeup(&program, this, &fields);
+   this->wakeupFd = sym_bpf_prog_load(BPF_PROG_TYPE_TRACEPOINT, "htop_wakeup", "GPL", program.insns, program.count, NULL);
+
+   program.count = 0;
+   SchedLatency_assembleSwitch(&program, this, &fields);
+   this->switchFd = sym_bpf_prog_load(BPF_PROG_TYPE_TRACEPOINT, "htop_switch", "GPL", program.insns, program.count, NULL);
+   if (this->wakeupFd < 0 || this->switchFd < 0)
+      return false;
+
+   return SchedLatency_attach(this, host, switchId, this->switchFd) &&
+          SchedLatency_attach(this, host, wakeupId, this->wakeupFd) &&
+          SchedLatency_attach(this, host, wakeupNewId, this->wakeupFd);
+}
+
+/* Percentile of a log2 histogram of microseconds, interpolated within its bucket, in nanoseconds */
+static double SchedLatency_percentile(const uint64_t* slots, uint64_t total, double fraction) {
+   if (total == 0)
+      return NAN;
+
+   double target = fraction * (double) total;
+   double below = 0.0;
+   for (size_t i = 0; i < SCHED_LATENCY_SLOTS; i++) {
+      if (slots[i] == 0 || below + (double) slots[i] < target) {
+         below += (double) slots[i];
+         continue;
+      }
+
+      double low = i == 0 ? 0.0 : ldexp(1.0, (int) i);
+      double high = ldexp(1.0, (int) i + 1);
+      return (low + (high - low) * (target - below) / (double) slots[i]) * 1000.0;
+   }
+
+   return ldexp(1.0, SCHED_LATENCY_SLOTS) * 1000.0;
+}
+
+static void SchedLatency_assign(LinuxProcess* process, const SchedHistogram* histogram) {
+   uint64_t runq = 0;
+   uint64_t offcpu = 0;
+   for (size_t i = 0; i < SCHED_LATENCY_SLOTS; i++) {
+      runq += histogram->runq[i];
+      offcpu += histogram->offcpu[i];
+   }
+
+   process->runq_p50 = SchedLatency_percentile(histogram->runq, runq, 0.50);
+   process->runq_p99 = SchedLatency_percentile(histogram->runq, runq, 0.99);
+   process->offcpu_p50 = SchedLatency_percentile(histogram->offcpu, offcpu, 0.50);
+   process->offcpu_p99 = SchedLatency_percentile(histogram->offcpu, offcpu, 0.99);
+}
+
+void LibBpf_readSchedLatency(LinuxProcessTable* this) {
+   Table* table = &this->super.super;
+
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(table->rows, i);
+      lp->runq_p50 = NAN;
+      lp->runq_p99 = NAN;
+      lp->offcpu_p50 = NAN;
+      lp->offcpu_p99 = NAN;
+   }
+
+   if (!this->schedLatency) {
+      SchedLatency* sl = xCalloc(1, sizeof(SchedLatency));
+      sl->tasksFd = sl->histogramsFd = sl->zeroFd = sl->switchFd = sl->wakeupFd = -1;
+      this->schedLatency = sl;
+
+      /* not permitted without CAP_BPF and CAP_PERFMON, or without BPF support in the kernel */
+      if (!SchedLatency_start(sl, table->host)) {
+         SchedLatency_close(sl);
+         sl->failed = true;
+      }
+   }
+
+   SchedLatency* sl = this->schedLatency;
+   if (sl->failed)
+      return;
+
+   /* collect the keys first, deleting while iterating restarts the walk */
+   if (!sl->keys)
+      sl->keys = xMallocArray(SCHED_LATENCY_MAX_GROUPS, sizeof(*sl->keys));
+
+   size_t nKeys = 0;
+   uint32_t key;
+   const uint32_t* previous = NULL;
+   while (nKeys < SCHED_LATENCY_MAX_GROUPS && sym_bpf_map_get_next_key(sl->histogramsFd, previous, &key) == 0) {
+      sl->keys[nKeys] = key;
+      previous = &sl->keys[nKeys];
+      nKeys++;
+   }
+
+   /* each read covers the time since the previous one */
+   for (size_t i = 0; i < nKeys; i++) {
+      SchedHistogram histogram;
+      if (sym_bpf_map_lookup_elem(sl->histogramsFd, &sl->keys[i], &histogram) != 0)
+         continue;
+      sym_bpf_map_delete_elem(sl->histogramsFd, &sl->keys[i]);
+
+      LinuxProcess* lp = (LinuxProcess*) Table_findRow(table, (int) sl->keys[i]);
+      if (lp)
+         SchedLatency_assign(lp, &histogram);
+   }
+
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(table->rows, i);
+      if (!Process_isUserlandThread(&lp->super))
+         continue;
+
+      const LinuxProcess* mainTask = (const LinuxProcess*) Table_findRow(table, Process_getThreadGroup(&lp->super));
+      if (!mainTask)
+         continue;
+
+      lp->runq_p50 = mainTask->runq_p50;
+      lp->runq_p99 = mainTask->runq_p99;
+      lp->offcpu_p50 = mainTask->offcpu_p50;
+      lp->offcpu_p99 = mainTask->offcpu_p99;
+   }
+}
+
+void LibBpf_stopSchedLatency(LinuxProcessTable* this) {
+   /* a collector that failed to start is not tried again */
+   if (this->schedLatency && !this->schedLatency->failed)
+      LibBpf_destroySchedLatency(this);
+}
+
+void LibBpf_destroySchedLatency(LinuxProcessTable* this) {
+   if (!this->schedLatency)
+      return;
+
+   SchedLatency_close(this->schedLatency);
+   free(this->schedLatency);
+   this->schedLatency = NULL;
+}
@@ -0,0 +1,21 @@
+#ifndef HEADER_LibBpf
+#define HEADER_LibBpf
+/*
+htop - linux/LibBpf.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "linux/LinuxProcessTable.h"
+
+
+/* Reads and resets the scheduler latency histograms, attaching the collector on first use */
+void LibBpf_readSchedLatency(LinuxProcessTable* this);
+
+/* Detaches the collector while its columns are hidden */
+void LibBpf_stopSchedLatency(LinuxProcessTable* this);
+
+void LibBpf_destroySchedLatency(LinuxProcessTable* this);
+
+#endif /* HEADER_LibBpf */
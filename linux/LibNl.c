@@ -14,25 +14,37 @@ in the source distribution for its full text.
 #include "linux/LibNl.h"
 
 #include <dlfcn.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/time.h>
 
 #include <linux/netlink.h>
 #include <linux/taskstats.h>
 
 #include <netlink/attr.h>
+#include <netlink/errno.h>
 #include <netlink/handlers.h>
 #include <netlink/msg.h>
 
+#include "XUtils.h"
+
 
 static void* libnlHandle;
 static void* libnlGenlHandle;
 
 static void (*sym_nl_close)(struct nl_sock*);
 static int (*sym_nl_connect)(struct nl_sock*, int);
+static int (*sym_nl_socket_get_fd)(const struct nl_sock*);
 static int (*sym_nl_recvmsgs_default)(struct nl_sock*);
-static int (*sym_nl_send_sync)(struct nl_sock*, struct nl_msg*);
+static int (*sym_nl_send_auto)(struct nl_sock*, struct nl_msg*);
 static struct nl_sock* (*sym_nl_socket_alloc)(void);
+static void (*sym_nl_socket_disable_auto_ack)(struct nl_sock*);
+static void (*sym_nl_socket_disable_seq_check)(struct nl_sock*);
 static void (*sym_nl_socket_free)(struct nl_sock*);
+static int (*sym_nl_socket_set_buffer_size)(struct nl_sock*, int, int);
 static int (*sym_nl_socket_modify_cb)(struct nl_sock*, enum nl_cb_type, enum nl_cb_kind, nl_recvmsg_msg_cb_t, void*);
+static int (*sym_nl_socket_modify_err_cb)(struct nl_sock*, enum nl_cb_kind, nl_recvmsg_err_cb_t, void*);
 static void* (*sym_nla_data)(const struct nlattr*);
 static struct nlattr* (*sym_nla_next)(const struct nlattr*, int*);
 static int (*sym_nla_put_u32)(struct nl_msg*, int, uint32_t);
@@ -48,11 +60,16 @@ static void* (*sym_genlmsg_put)(struct nl_msg*, uint32_t, uint32_t, int, int, in
 static void unload_libnl(void) {
    sym_nl_close = NULL;
    sym_nl_connect = NULL;
+   sym_nl_socket_get_fd = NULL;
    sym_nl_recvmsgs_default = NULL;
-   sym_nl_send_sync = NULL;
+   sym_nl_send_auto = NULL;
    sym_nl_socket_alloc = NULL;
+   sym_nl_socket_disable_auto_ack = NULL;
+   sym_nl_socket_disable_seq_check = NULL;
    sym_nl_socket_free = NULL;
+   sym_nl_socket_set_buffer_size = NULL;
    sym_nl_socket_modify_cb = NULL;
+   sym_nl_socket_modify_err_cb = NULL;
    sym_nla_data = NULL;
    sym_nla_next = NULL;
    sym_nla_put_u32 = NULL;
@@ -106,11 +123,16 @@ static int load_libnl(void) {
 
    resolve(libnlHandle, nl_close);
    resolve(libnlHandle, nl_connect);
+   resolve(libnlHandle, nl_socket_get_fd);
    resolve(libnlHandle, nl_recvmsgs_default);
-   resolve(libnlHandle, nl_send_sync);
+   resolve(libnlHandle, nl_send_auto);
    resolve(libnlHandle, nl_socket_alloc);
+   resolve(libnlHandle, nl_socket_disable_auto_ack);
+   resolve(libnlHandle, nl_socket_disable_seq_check);
    resolve(libnlHandle, nl_socket_free);
+   resolve(libnlHandle, nl_socket_set_buffer_size);
    resolve(libnlHandle, nl_socket_modify_cb);
+   resolve(libnlHandle, nl_socket_modify_err_cb);
    resolve(libnlHandle, nla_data);
    resolve(libnlHandle, nla_next);
    resolve(libnlHandle, nla_put_u32);
@@ -131,6 +153,31 @@ dlfailure:
    return -1;
 }
 
+/*
+ * Taskstats requests are pipelined: up to this many are sent back-to-back
+ * before the replies are read.  A reply is a few hundred bytes, but takes
+ * up to LIBNL_REPLY_SIZE of the receive buffer; libnl's default of 32 KiB
+ * would overflow, so the buffer is raised to LIBNL_RCVBUF_SIZE and the
+ * batch is cut down to what the kernel actually granted.
+ */
+#define LIBNL_MAX_PENDING 64
+#define LIBNL_REPLY_SIZE 2048
+#define LIBNL_RCVBUF_SIZE (256 * 1024)
+
+/* Times the missing requests are sent again after replies were dropped */
+#define LIBNL_MAX_RESENDS 2
+
+/* Replies are queued while the requests are sent, so they never take long */
+#define LIBNL_RECV_TIMEOUT_US 100000
+
+typedef struct LibNlRequest_ {
+   uint32_t seq;   /* replies and errors carry the sequence number of their request */
+   pid_t pid;
+} LibNlRequest;
+
+static int handleNetlinkMsg(struct nl_msg* nlmsg, void* linuxProcessTable);
+static int handleNetlinkError(struct sockaddr_nl* nla, struct nlmsgerr* nlerr, void* linuxProcessTable);
+
 static void initNetlinkSocket(LinuxProcessTable* this) {
    if (load_libnl() < 0) {
       return;
@@ -140,10 +187,37 @@ static void initNetlinkSocket(LinuxProcessTable* this) {
    if (this->netlink_socket == NULL) {
       return;
    }
+   this->netlink_requests = xCalloc(LIBNL_MAX_PENDING, sizeof(LibNlRequest));
+   this->netlink_pending = 0;
+   this->netlink_batch = 1;
+
    if (sym_nl_connect(this->netlink_socket, NETLINK_GENERIC) < 0) {
       return;
    }
    this->netlink_family = sym_genl_ctrl_resolve(this->netlink_socket, TASKSTATS_GENL_NAME);
+
+   /* capped by net.core.rmem_max; overflows are handled by resending */
+   sym_nl_socket_set_buffer_size(this->netlink_socket, LIBNL_RCVBUF_SIZE, 0);
+
+   int fd = sym_nl_socket_get_fd(this->netlink_socket);
+   int rcvbuf = 0;
+   socklen_t optlen = sizeof(rcvbuf);
+   if (getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, &optlen) < 0)
+      rcvbuf = 0;
+   this->netlink_batch = CLAMP((size_t) MAXIMUM(rcvbuf, 0) / LIBNL_REPLY_SIZE, 1, LIBNL_MAX_PENDING);
+
+   /* a reply dropped while the socket was congested is not reported */
+   const struct timeval timeout = { .tv_sec = 0, .tv_usec = LIBNL_RECV_TIMEOUT_US };
+   setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+   /* replies are matched by sequence number, several requests are in flight at once */
+   sym_nl_socket_disable_seq_check(this->netlink_socket);
+   /* each reply or error answers its request, acks would only fill the buffer */
+   sym_nl_socket_disable_auto_ack(this->netlink_socket);
+   if (sym_nl_socket_modify_cb(this->netlink_socket, NL_CB_VALID, NL_CB_CUSTOM, handleNetlinkMsg, this) < 0 ||
+       sym_nl_socket_modify_err_cb(this->netlink_socket, NL_CB_CUSTOM, handleNetlinkError, this) < 0) {
+      LibNl_destroyNetlinkSocket(this);
+   }
 }
 
 void LibNl_destroyNetlinkSocket(LinuxProcessTable* this) {
@@ -154,27 +228,82 @@ void LibNl_destroyNetlinkSocket(LinuxProcessTable* this) {
       sym_nl_socket_free(this->netlink_socket);
       this->netlink_socket = NULL;
    }
+   free(this->netlink_requests);
+   this->netlink_requests = NULL;
+   this->netlink_pending = 0;
 
    unload_libnl();
 }
 
-static int handleNetlinkMsg(struct nl_msg* nlmsg, void* linuxProcess) {
+/* Forgets the request answered by a reply or error, false if none was pending */
+static bool answerRequest(LinuxProcessTable* this, uint32_t seq) {
+   for (size_t i = 0; i < this->netlink_pending; i++) {
+      if (this->netlink_requests[i].seq == seq) {
+         this->netlink_requests[i] = this->netlink_requests[--this->netlink_pending];
+         return true;
+      }
+   }
+   return false;
+}
+
+static bool sendRequest(LinuxProcessTable* this, pid_t pid, uint32_t* seq) {
+   struct nl_msg* msg;
+
+   if (! (msg = sym_nlmsg_alloc())) {
+      return false;
+   }
+
+   bool sent = false;
+   if (sym_genlmsg_put(msg, NL_AUTO_PID, NL_AUTO_SEQ, this->netlink_family, 0, NLM_F_REQUEST, TASKSTATS_CMD_GET, TASKSTATS_VERSION) &&
+       sym_nla_put_u32(msg, TASKSTATS_CMD_ATTR_PID, (uint32_t) pid) >= 0 &&
+       sym_nl_send_auto(this->netlink_socket, msg) >= 0) {
+      *seq = sym_nlmsg_hdr(msg)->nlmsg_seq;
+      sent = true;
+   }
+
+   sym_nlmsg_free(msg);
+   return sent;
+}
+
+/* The socket dropped replies (ENOBUFS): asks again for the tasks still unanswered */
+static void resendRequests(LinuxProcessTable* this) {
+   size_t i = 0;
+   while (i < this->netlink_pending) {
+      LibNlRequest* request = &this->netlink_requests[i];
+      if (sendRequest(this, request->pid, &request->seq)) {
+         i++;
+      } else {
+         *request = this->netlink_requests[--this->netlink_pending];
+      }
+   }
+}
+
+static int handleNetlinkMsg(struct nl_msg* nlmsg, void* linuxProcessTable) {
    struct nlmsghdr* nlhdr;
    struct nlattr* nlattrs[TASKSTATS_TYPE_MAX + 1];
    const struct nlattr* nlattr;
    struct taskstats stats;
    int rem;
-   LinuxProcess* lp = (LinuxProcess*) linuxProcess;
+   LinuxProcessTable* this = (LinuxProcessTable*) linuxProcessTable;
 
    nlhdr = sym_nlmsg_hdr(nlmsg);
 
+   /* a late reply to a request sent again */
+   if (!answerRequest(this, nlhdr->nlmsg_seq)) {
+      return NL_SKIP;
+   }
+
    if (sym_genlmsg_parse(nlhdr, 0, nlattrs, TASKSTATS_TYPE_MAX, NULL) < 0) {
       return NL_SKIP;
    }
 
    if ((nlattr = nlattrs[TASKSTATS_TYPE_AGGR_PID]) || (nlattr = nlattrs[TASKSTATS_TYPE_NULL])) {
       memcpy(&stats, sym_nla_data(sym_nla_next(sym_nla_data(nlattr), &rem)), sizeof(stats));
-      assert(Process_getPid(&lp->super) == (pid_t)stats.ac_pid);
+
+      /* the task may have gone while its request was in flight */
+      LinuxProcess* lp = (LinuxProcess*) Table_findRow(&this->super.super, (int)stats.ac_pid);
+      if (!lp)
+         return NL_OK;
 
       // The xxx_delay_total values wrap around on overflow.
       // (Linux Kernel "Documentation/accounting/taskstats-struct.rst")
@@ -193,47 +322,80 @@ static int handleNetlinkMsg(struct nl_msg* nlmsg, void* linuxProcess) {
    return NL_OK;
 }
 
+/* a request failed, e.g. the task exited; its delay values stay unavailable */
+static int handleNetlinkError(ATTR_UNUSED struct sockaddr_nl* nla, struct nlmsgerr* nlerr, void* linuxProcessTable) {
+   LinuxProcessTable* this = (LinuxProcessTable*) linuxProcessTable;
+
+   answerRequest(this, nlerr->msg.nlmsg_seq);
+
+   return NL_SKIP;
+}
+
 /*
- * Gather delay-accounting information (thread-specific data)
+ * Receive and dispatch the replies of all requests in flight
  */
-void LibNl_readDelayAcctData(LinuxProcessTable* this, LinuxProcess* process) {
-   struct nl_msg* msg;
-
-   if (!this->netlink_socket) {
-      initNetlinkSocket(this);
-      if (!this->netlink_socket) {
-         goto delayacct_failure;
+void LibNl_flushDelayAcctData(LinuxProcessTable* this) {
+   unsigned int resends = 0;
+
+   while (this->netlink_socket && this->netlink_pending > 0) {
+      size_t pending = this->netlink_pending;
+      int err = sym_nl_recvmsgs_default(this->netlink_socket);
+
+      if (err == -NLE_AGAIN) {
+         /*
+          * nothing answered before the receive timeout: the socket is fine,
+          * their delay values stay unavailable for this refresh and late
+          * replies are skipped
+          */
+         this->netlink_pending = 0;
+         break;
       }
-   }
 
-   if (sym_nl_socket_modify_cb(this->netlink_socket, NL_CB_VALID, NL_CB_CUSTOM, handleNetlinkMsg, process) < 0) {
-      goto delayacct_failure;
-   }
+      if (err < 0 && err != -NLE_NOMEM) {
+         /* replies are out of sync now, start over with a new socket */
+         LibNl_destroyNetlinkSocket(this);
+         break;
+      }
 
-   if (! (msg = sym_nlmsg_alloc())) {
-      goto delayacct_failure;
+      /* ENOBUFS: the socket is fine, but some replies were dropped and will never arrive */
+      if (err < 0 || this->netlink_pending == pending) {
+         if (resends++ < LIBNL_MAX_RESENDS) {
+            resendRequests(this);
+         } else {
+            /* their delay values stay unavailable for this refresh */
+            this->netlink_pending = 0;
+         }
+      }
    }
+}
 
-   if (! sym_genlmsg_put(msg, NL_AUTO_PID, NL_AUTO_SEQ, this->netlink_family, 0, NLM_F_REQUEST, TASKSTATS_CMD_GET, TASKSTATS_VERSION)) {
-      sym_nlmsg_free(msg);
-   }
+/*
+ * Request delay-accounting information (thread-specific data); the reply
+ * is applied by a later LibNl_flushDelayAcctData call
+ */
+void LibNl_readDelayAcctData(LinuxProcessTable* this, LinuxProcess* process) {
+   /* unavailable unless a reply gets dispatched */
+   process->swapin_delay_percent = NAN;
+   process->blkio_delay_percent = NAN;
+   process->cpu_delay_percent = NAN;
 
-   if (sym_nla_put_u32(msg, TASKSTATS_CMD_ATTR_PID, Process_getPid(&process->super)) < 0) {
-      sym_nlmsg_free(msg);
+   if (!this->netlink_socket) {
+      initNetlinkSocket(this);
+      if (!this->netlink_socket) {
+         return;
+      }
    }
 
-   if (sym_nl_send_sync(this->netlink_socket, msg) < 0) {
-      goto delayacct_failure;
+   if (this->netlink_pending >= this->netlink_batch) {
+      LibNl_flushDelayAcctData(this);
+      if (!this->netlink_socket) {
+         return;
+      }
    }
 
-   if (sym_nl_recvmsgs_default(this->netlink_socket) < 0) {
-      goto delayacct_failure;
+   LibNlRequest* request = &this->netlink_requests[this->netlink_pending];
+   request->pid = Process_getPid(&process->super);
+   if (sendRequest(this, request->pid, &request->seq)) {
+      this->netlink_pending++;
    }
-
-   return;
-
-delayacct_failure:
-   process->swapin_delay_percent = NAN;
-   process->blkio_delay_percent = NAN;
-   process->cpu_delay_percent = NAN;
 }
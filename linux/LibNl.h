@@ -15,4 +15,6 @@ void LibNl_destroyNetlinkSocket(LinuxProcessTable* this);
 
 void LibNl_readDelayAcctData(LinuxProcessTable* this, LinuxProcess* process);
 
+void LibNl_flushDelayAcctData(LinuxProcessTable* this);
+
 #endif /* HEADER_LibNl */
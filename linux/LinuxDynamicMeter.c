@@ -0,0 +1,281 @@
+/*
+htop - linux/LinuxDynamicMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/LinuxDynamicMeter.h"
+
+#include <dirent.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Row.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/DataSource.h"
+#include "linux/DiskEntry.h"
+#include "linux/LinuxDynamicScreen.h"
+#include "linux/LinuxMachine.h"
+#include "linux/NetworkEntry.h"
+
+
+static const char* const LinuxDynamicMeter_prefixes[] = {
+   [LINUX_METER_DISK] = "disk",
+   [LINUX_METER_NETWORK] = "net",
+   [LINUX_METER_NUMA] = "numa",
+};
+
+static LinuxDynamicMeter* LinuxDynamicMeters_add(Hashtable* meters, ht_key_t* count, LinuxDynamicMeterKind kind, const char* device, size_t len) {
+   const char* prefix = LinuxDynamicMeter_prefixes[kind];
+
+   /* names longer than this are not parsed back from htoprc */
+   if (len >= sizeof(((LinuxDynamicMeter*)NULL)->device) || strlen(prefix) + 1 + len > 30)
+      return NULL;
+
+   LinuxDynamicMeter* this = xCalloc(1, sizeof(LinuxDynamicMeter));
+   this->kind = kind;
+   memcpy(this->device, device, len);
+   this->device[len] = '\0';
+
+   DynamicMeter* super = &this->super;
+   xSnprintf(super->name, sizeof(super->name), "%s:%s", prefix, this->device);
+   xAsprintf(&super->caption, "%s: ", this->device);
+   switch (kind) {
+      case LINUX_METER_DISK:
+         xAsprintf(&super->description, "Disk IO of %s", this->device);
+         break;
+      case LINUX_METER_NETWORK:
+         xAsprintf(&super->description, "Network traffic of %s", this->device);
+         break;
+      case LINUX_METER_NUMA:
+         xAsprintf(&super->description, "Memory of NUMA %s", this->device);
+         break;
+   }
+   super->maximum = 100.0;
+
+   Hashtable_put(meters, ++*count, this);
+   return this;
+}
+
+Hashtable* LinuxDynamicMeters_new(void) {
+   Hashtable* meters = Hashtable_new(0, true);
+   ht_key_t count = 0;
+   char path[PATH_MAX];
+
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/diskstats"), 0));
+   if (content) {
+      do {
+         (void) DataSource_nextNumber(&content);  /* major */
+         (void) DataSource_nextNumber(&content);  /* minor */
+
+         const char* name;
+         size_t len = DataSource_nextWord(&content, &name);
+         if (len == 0)
+            continue;
+
+         /* as in the disk screen, loop and ram devices are only of interest once used */
+         unsigned long long reads = DataSource_nextNumber(&content);
+         for (int i = 0; i < 3; i++)
+            (void) DataSource_nextNumber(&content);
+         unsigned long long writes = DataSource_nextNumber(&content);
+         if (reads == 0 && writes == 0 && (strncmp(name, "loop", 4) == 0 || strncmp(name, "ram", 3) == 0))
+            continue;
+
+         LinuxDynamicMeters_add(meters, &count, LINUX_METER_DISK, name, len);
+      } while (DataSource_skipLine(&content));
+   }
+
+   content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/net/dev"), 0));
+   if (content) {
+      do {
+         const char* name;
+         size_t len = DataSource_nextWord(&content, &name);
+         const char* colon = memchr(name, ':', len);
+         if (colon && colon > name)
+            LinuxDynamicMeters_add(meters, &count, LINUX_METER_NETWORK, name, (size_t) (colon - name));
+      } while (DataSource_skipLine(&content));
+   }
+
+   DIR* dir = opendir(LinuxMachine_sysPath(path, sizeof(path), "/devices/system/node"));
+   if (dir) {
+      const struct dirent* entry;
+      while ((entry = readdir(dir)) != NULL) {
+         if (!String_startsWith(entry->d_name, "node"))
+            continue;
+
+         char* endp;
+         unsigned long int id = strtoul(entry->d_name + 4, &endp, 10);
+         if (endp == entry->d_name + 4 || *endp != '\0')
+            continue;
+
+         LinuxDynamicMeter* this = LinuxDynamicMeters_add(meters, &count, LINUX_METER_NUMA, entry->d_name, strlen(entry->d_name));
+         if (this)
+            this->node = id;
+      }
+      closedir(dir);
+   }
+
+   return meters;
+}
+
+static void LinuxDynamicMeters_free(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   LinuxDynamicMeter* this = (LinuxDynamicMeter*) value;
+   free(this->super.caption);
+   free(this->super.description);
+}
+
+void LinuxDynamicMeters_done(Hashtable* meters) {
+   Hashtable_foreach(meters, LinuxDynamicMeters_free, NULL);
+}
+
+static const Row* LinuxDynamicMeter_findRow(const LinuxDynamicMeter* this, const Table* table) {
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      const Row* row = (const Row*) Vector_get(table->rows, i);
+      const char* name = this->kind == LINUX_METER_DISK ? ((const DiskEntry*) row)->name : ((const NetworkEntry*) row)->name;
+      if (String_eq(name, this->device))
+         return row;
+   }
+   return NULL;
+}
+
+static void LinuxDynamicMeter_updateNumaValues(LinuxDynamicMeter* this, Meter* meter) {
+   const LinuxMachine* lhost = (const LinuxMachine*) meter->host;
+   const NumaNodeData* node = this->node < lhost->numaNodes ? &lhost->numaNodeData[this->node] : NULL;
+
+   this->found = node && node->present && node->totalMem > 0;
+   if (!this->found) {
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "no data");
+      return;
+   }
+
+   this->totalMem = node->totalMem;
+   this->usedMem = node->usedMem;
+   this->cachedMem = node->cachedMem;
+   this->freeMem = node->freeMem;
+
+   char usedStr[6];
+   char totalStr[6];
+   Meter_humanUnit(usedStr, this->usedMem, sizeof(usedStr));
+   Meter_humanUnit(totalStr, this->totalMem, sizeof(totalStr));
+   xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "%s/%s", usedStr, totalStr);
+}
+
+void LinuxDynamicMeter_updateValues(LinuxDynamicMeter* this, Meter* meter) {
+   if (this->kind == LINUX_METER_NUMA) {
+      LinuxDynamicMeter_updateNumaValues(this, meter);
+      return;
+   }
+
+   const Table* table = LinuxDynamicScreens_table(this->kind == LINUX_METER_DISK ? "disk" : "network");
+   const Row* row = table ? LinuxDynamicMeter_findRow(this, table) : NULL;
+
+   this->found = row != NULL;
+   if (!row) {
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "no data");
+      return;
+   }
+
+   if (this->kind == LINUX_METER_DISK) {
+      const DiskEntry* entry = (const DiskEntry*) row;
+      this->readRate = entry->read_rate;
+      this->writeRate = entry->write_rate;
+      this->await = entry->await;
+      this->utilization = entry->utilization;
+   } else {
+      const NetworkEntry* entry = (const NetworkEntry*) row;
+      this->readRate = entry->rx_rate;
+      this->writeRate = entry->tx_rate;
+      this->packetRate = entry->rx_packets_rate + entry->tx_packets_rate;
+      this->utilization = entry->utilization;
+   }
+
+   if (isnan(this->readRate)) {
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "init");
+      return;
+   }
+
+   char readStr[6];
+   char writeStr[6];
+   Meter_humanUnit(readStr, this->readRate / ONE_K, sizeof(readStr));
+   Meter_humanUnit(writeStr, this->writeRate / ONE_K, sizeof(writeStr));
+
+   if (this->kind == LINUX_METER_DISK)
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "r:%siB/s w:%siB/s %.1f%%", readStr, writeStr, this->utilization);
+   else
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "rx:%siB/s tx:%siB/s", readStr, writeStr);
+}
+
+static void LinuxDynamicMeter_displayNuma(const LinuxDynamicMeter* this, RichString* out) {
+   char buffer[6];
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], "used:");
+   Meter_humanUnit(buffer, this->usedMem, sizeof(buffer));
+   RichString_appendAscii(out, CRT_colors[MEMORY_USED], buffer);
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " cache:");
+   Meter_humanUnit(buffer, this->cachedMem, sizeof(buffer));
+   RichString_appendAscii(out, CRT_colors[MEMORY_CACHE], buffer);
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " free:");
+   Meter_humanUnit(buffer, this->freeMem, sizeof(buffer));
+   RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], " total:");
+   Meter_humanUnit(buffer, this->totalMem, sizeof(buffer));
+   RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+}
+
+void LinuxDynamicMeter_display(const LinuxDynamicMeter* this, RichString* out) {
+   if (!this->found) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
+      return;
+   }
+   if (this->kind == LINUX_METER_NUMA) {
+      LinuxDynamicMeter_displayNuma(this, out);
+      return;
+   }
+   if (isnan(this->readRate)) {
+      RichString_writeAscii(out, CRT_colors[METER_VALUE], "initializing...");
+      return;
+   }
+
+   char buffer[64];
+   int len;
+
+   if (this->kind == LINUX_METER_DISK) {
+      int color = this->utilization > 40.0F ? METER_VALUE_NOTICE : METER_VALUE;
+      len = xSnprintf(buffer, sizeof(buffer), "%.1f%%", this->utilization);
+      RichString_appendnAscii(out, CRT_colors[color], buffer, len);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " read: ");
+   } else {
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], "rx: ");
+   }
+
+   Meter_humanUnit(buffer, this->readRate / ONE_K, 6);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
+
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], this->kind == LINUX_METER_DISK ? " write: " : " tx: ");
+   Meter_humanUnit(buffer, this->writeRate / ONE_K, 6);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
+
+   if (this->kind == LINUX_METER_DISK) {
+      len = xSnprintf(buffer, sizeof(buffer), " await: %.1fms", this->await);
+   } else if (isNonnegative(this->utilization)) {
+      len = xSnprintf(buffer, sizeof(buffer), " (%.0f pkts/s, %.1f%%)", this->packetRate, this->utilization);
+   } else {
+      len = xSnprintf(buffer, sizeof(buffer), " (%.0f pkts/s)", this->packetRate);
+   }
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
+}
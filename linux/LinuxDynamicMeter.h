@@ -0,0 +1,60 @@
+#ifndef HEADER_LinuxDynamicMeter
+#define HEADER_LinuxDynamicMeter
+/*
+htop - linux/LinuxDynamicMeter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "DynamicMeter.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Meter.h"
+#include "RichString.h"
+
+
+/*
+ * A meter for each block device and network interface present at startup,
+ * named "disk:<device>" and "net:<interface>".  The values come from the
+ * rows of the built-in "disk" and "network" screens.  NUMA nodes get a
+ * memory meter each, named "numa:node<N>", fed by the machine scan.
+ */
+typedef enum LinuxDynamicMeterKind_ {
+   LINUX_METER_DISK,
+   LINUX_METER_NETWORK,
+   LINUX_METER_NUMA,
+} LinuxDynamicMeterKind;
+
+typedef struct LinuxDynamicMeter_ {
+   DynamicMeter super;
+   LinuxDynamicMeterKind kind;
+   char device[32];
+
+   /* values of the last update, shared by all meters of the device */
+   bool found;
+   double readRate;        /* bytes per second read or received */
+   double writeRate;       /* bytes per second written or transmitted */
+   double await;           /* disk only, milliseconds per request */
+   double packetRate;      /* network only, packets per second in both directions */
+   float utilization;
+
+   /* NUMA only, in kB */
+   unsigned int node;
+   memory_t totalMem;
+   memory_t usedMem;
+   memory_t cachedMem;
+   memory_t freeMem;
+} LinuxDynamicMeter;
+
+Hashtable* LinuxDynamicMeters_new(void);
+
+void LinuxDynamicMeters_done(Hashtable* meters);
+
+void LinuxDynamicMeter_updateValues(LinuxDynamicMeter* this, Meter* meter);
+
+void LinuxDynamicMeter_display(const LinuxDynamicMeter* this, RichString* out);
+
+#endif
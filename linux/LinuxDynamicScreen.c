@@ -0,0 +1,246 @@
+/*
+htop - linux/LinuxDynamicScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/LinuxDynamicScreen.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ListItem.h"
+#include "Macros.h"
+#include "Object.h"
+#include "RowField.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/CGroupTable.h"
+#include "linux/DiskTable.h"
+#include "linux/InterruptTable.h"
+#include "linux/NetnsTable.h"
+#include "linux/NetworkTable.h"
+
+
+/* Built-in screens; none are enabled by default, add them via Setup */
+static const LinuxDynamicScreenDefaults* const LinuxDynamicScreen_builtins[] = {
+   &CGroupTable_screen,
+   &DiskTable_screen,
+   &NetworkTable_screen,
+   &NetnsTable_screen,
+   &InterruptTable_screen,
+   NULL
+};
+
+static Hashtable* LinuxDynamicScreens_columnsTable;
+static Hashtable* LinuxDynamicScreens_screensTable;
+static size_t LinuxDynamicScreens_screenCount;
+static size_t LinuxDynamicScreens_columnCount;
+
+static char* LinuxDynamicScreen_formatFields(const LinuxDynamicScreenDefaults* defaults) {
+   char* columns = xStrdup("");
+
+   for (size_t i = 0; i < defaults->totalColumns; i++) {
+      const LinuxDynamicColumnDefaults* column = &defaults->columns[i];
+      if (!column->enabled)
+         continue;
+      char* prefix = columns;
+      xAsprintf(&columns, "%s%sDynamic(%s:%s)", prefix, prefix[0] ? " " : "", defaults->name, column->name);
+      free(prefix);
+   }
+
+   return columns;
+}
+
+static void LinuxDynamicScreens_appendColumns(const LinuxDynamicScreenDefaults* defaults) {
+   Hashtable* columns = LinuxDynamicScreens_columnsTable;
+
+   for (size_t i = 0; i < defaults->totalColumns; i++) {
+      const LinuxDynamicColumnDefaults* from = &defaults->columns[i];
+
+      LinuxDynamicColumn* column = xCalloc(1, sizeof(LinuxDynamicColumn));
+      xSnprintf(column->super.name, sizeof(column->super.name), "%s:%s", defaults->name, from->name);
+      column->super.heading = xStrdup(from->heading);
+      column->super.description = xStrdup(from->description);
+      column->super.width = from->width;
+      column->super.enabled = true;
+      column->field = (unsigned int) i;
+
+      ht_key_t key = (ht_key_t) (ROW_DYNAMIC_FIELDS + LinuxDynamicScreens_columnCount);
+      Hashtable_put(columns, key, column);
+      LinuxDynamicScreens_columnCount++;
+   }
+}
+
+void LinuxDynamicScreens_init(void) {
+   if (LinuxDynamicScreens_screensTable)
+      return;
+
+   LinuxDynamicScreens_columnsTable = Hashtable_new(0, true);
+   LinuxDynamicScreens_screensTable = Hashtable_new(0, true);
+
+   for (size_t i = 0; LinuxDynamicScreen_builtins[i]; i++) {
+      const LinuxDynamicScreenDefaults* defaults = LinuxDynamicScreen_builtins[i];
+
+      LinuxDynamicScreen* screen = xCalloc(1, sizeof(LinuxDynamicScreen));
+      String_safeStrncpy(screen->super.name, defaults->name, sizeof(screen->super.name));
+      screen->super.heading = xStrdup(defaults->heading);
+      screen->super.caption = xStrdup(defaults->caption);
+      screen->super.columnKeys = LinuxDynamicScreen_formatFields(defaults);
+      screen->super.direction = defaults->direction;
+      if (defaults->sortKey)
+         xAsprintf(&screen->super.sortKey, "%s:%s", defaults->name, defaults->sortKey);
+      screen->defaults = defaults;
+
+      LinuxDynamicScreens_appendColumns(defaults);
+
+      Hashtable_put(LinuxDynamicScreens_screensTable, (ht_key_t) LinuxDynamicScreens_screenCount, screen);
+      LinuxDynamicScreens_screenCount++;
+   }
+}
+
+Hashtable* LinuxDynamicScreens_columns(void) {
+   return LinuxDynamicScreens_columnsTable;
+}
+
+Hashtable* LinuxDynamicScreens_screens(void) {
+   return LinuxDynamicScreens_screensTable;
+}
+
+typedef struct {
+   const LinuxDynamicScreen* screen;
+   Table* table;
+} LinuxDynamicScreenIterator;
+
+static void LinuxDynamicScreens_bindColumn(ATTR_UNUSED ht_key_t key, void* value, void* data) {
+   LinuxDynamicColumn* column = (LinuxDynamicColumn*) value;
+   const LinuxDynamicScreenIterator* iter = (const LinuxDynamicScreenIterator*) data;
+   const char* name = iter->screen->super.name;
+   size_t len = strlen(name);
+
+   if (strncmp(column->super.name, name, len) == 0 && column->super.name[len] == ':')
+      column->super.table = iter->table;
+}
+
+void LinuxDynamicScreens_appendTables(Machine* host) {
+   for (ht_key_t i = 0; i < LinuxDynamicScreens_screenCount; i++) {
+      LinuxDynamicScreen* screen = Hashtable_get(LinuxDynamicScreens_screensTable, i);
+      if (!screen || screen->table)
+         continue;
+
+      screen->table = screen->defaults->newTable(host);
+
+      LinuxDynamicScreenIterator iter = { .screen = screen, .table = screen->table };
+      Hashtable_foreach(LinuxDynamicScreens_columnsTable, LinuxDynamicScreens_bindColumn, &iter);
+   }
+}
+
+/* called when htoprc .dynamic line is parsed for a dynamic screen */
+void LinuxDynamicScreens_addDynamicScreen(ScreenSettings* ss) {
+   for (ht_key_t i = 0; i < LinuxDynamicScreens_screenCount; i++) {
+      const LinuxDynamicScreen* screen = Hashtable_get(LinuxDynamicScreens_screensTable, i);
+      if (!screen || !String_eq(ss->dynamic, screen->super.name))
+         continue;
+      ss->table = screen->table;
+   }
+}
+
+Table* LinuxDynamicScreens_table(const char* name) {
+   for (ht_key_t i = 0; i < LinuxDynamicScreens_screenCount; i++) {
+      LinuxDynamicScreen* screen = Hashtable_get(LinuxDynamicScreens_screensTable, i);
+      if (!screen || !screen->table || !String_eq(name, screen->super.name))
+         continue;
+
+      Table* table = screen->table;
+      Machine* host = table->host;
+
+      /* tables of configured screens are scanned along with all others */
+      for (size_t j = 0; j < host->tableCount; j++)
+         if (host->tables[j] == table)
+            return table;
+
+      if (screen->scanMs != host->monotonicMs) {
+         screen->scanMs = host->monotonicMs;
+         Table_scanPrepare(table);
+         Table_scanIterate(table);
+         Table_scanCleanup(table);
+      }
+      return table;
+   }
+   return NULL;
+}
+
+typedef struct {
+   Panel* panel;
+   const char* screen;
+   size_t len;
+} LinuxDynamicColumnIterator;
+
+static void LinuxDynamicScreens_addAvailableColumn(ht_key_t key, void* value, void* data) {
+   const LinuxDynamicColumn* column = (const LinuxDynamicColumn*) value;
+   const LinuxDynamicColumnIterator* iter = (const LinuxDynamicColumnIterator*) data;
+
+   if (strncmp(column->super.name, iter->screen, iter->len) != 0 || column->super.name[iter->len] != ':')
+      return;
+
+   const char* title = column->super.heading ? column->super.heading : column->super.name;
+   char description[256];
+   if (column->super.description)
+      xSnprintf(description, sizeof(description), "%s - %s", title, column->super.description);
+   else
+      xSnprintf(description, sizeof(description), "%s", title);
+   Panel_add(iter->panel, (Object*) ListItem_new(description, key));
+}
+
+void LinuxDynamicScreens_addAvailableColumns(Panel* availableColumns, const char* screen) {
+   Vector_prune(availableColumns->items);
+
+   if (!DynamicScreen_search(LinuxDynamicScreens_screensTable, screen, NULL))
+      return;
+
+   LinuxDynamicColumnIterator iter = { .panel = availableColumns, .screen = screen, .len = strlen(screen) };
+   Hashtable_foreach(LinuxDynamicScreens_columnsTable, LinuxDynamicScreens_addAvailableColumn, &iter);
+}
+
+static void LinuxDynamicColumns_free(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   LinuxDynamicColumn* column = (LinuxDynamicColumn*) value;
+   DynamicColumn_done(&column->super);
+}
+
+void LinuxDynamicColumns_done(Hashtable* columns) {
+   Hashtable_foreach(columns, LinuxDynamicColumns_free, NULL);
+   if (columns == LinuxDynamicScreens_columnsTable) {
+      LinuxDynamicScreens_columnsTable = NULL;
+      LinuxDynamicScreens_columnCount = 0;
+   }
+}
+
+static void LinuxDynamicScreens_free(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   LinuxDynamicScreen* screen = (LinuxDynamicScreen*) value;
+   DynamicScreen_done(&screen->super);
+   if (screen->table)
+      Object_delete(screen->table);
+}
+
+void LinuxDynamicScreens_done(Hashtable* screens) {
+   Hashtable_foreach(screens, LinuxDynamicScreens_free, NULL);
+   if (screens == LinuxDynamicScreens_screensTable) {
+      LinuxDynamicScreens_screensTable = NULL;
+      LinuxDynamicScreens_screenCount = 0;
+   }
+}
+
+int LinuxDynamicColumn_field(const Settings* settings, const Table* table, RowField key) {
+   if (key < ROW_DYNAMIC_FIELDS)
+      return -1;
+
+   const LinuxDynamicColumn* column = Hashtable_get(settings->dynamicColumns, (ht_key_t) key);
+   if (!column || column->super.table != table)
+      return -1;
+
+   return (int) column->field;
+}
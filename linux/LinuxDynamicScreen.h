@@ -0,0 +1,82 @@
+#ifndef HEADER_LinuxDynamicScreen
+#define HEADER_LinuxDynamicScreen
+/*
+htop - linux/LinuxDynamicScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "DynamicColumn.h"
+#include "DynamicScreen.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "Panel.h"
+#include "Settings.h"
+#include "Table.h"
+
+
+/* Static description of a column provided by a built-in screen */
+typedef struct LinuxDynamicColumnDefaults_ {
+   const char* name;         /* short name, unique within its screen */
+   const char* heading;      /* displayed in main screen */
+   const char* description;  /* displayed in setup menu */
+   int width;                /* display width +/- for value alignment */
+   bool enabled;             /* included in the screen by default */
+} LinuxDynamicColumnDefaults;
+
+typedef Table* (*LinuxDynamicScreen_NewTable)(Machine* host);
+
+/* Static description of a built-in (non-process) screen */
+typedef struct LinuxDynamicScreenDefaults_ {
+   const char* name;         /* unique name, cannot contain any spaces */
+   const char* heading;      /* default tab name */
+   const char* caption;      /* explanatory text for screen */
+   const char* sortKey;      /* short name of the default sort column */
+   int direction;
+   const LinuxDynamicColumnDefaults* columns;
+   size_t totalColumns;      /* column index is the table-local field */
+   LinuxDynamicScreen_NewTable newTable;
+} LinuxDynamicScreenDefaults;
+
+typedef struct LinuxDynamicColumn_ {
+   DynamicColumn super;
+   unsigned int field;       /* table-local field identifier */
+} LinuxDynamicColumn;
+
+typedef struct LinuxDynamicScreen_ {
+   DynamicScreen super;
+   const LinuxDynamicScreenDefaults* defaults;
+   Table* table;
+   uint64_t scanMs;          /* monotonic time of the last scan outside Machine_scanTables */
+} LinuxDynamicScreen;
+
+void LinuxDynamicScreens_init(void);
+
+Hashtable* LinuxDynamicScreens_columns(void);
+
+Hashtable* LinuxDynamicScreens_screens(void);
+
+void LinuxDynamicScreens_appendTables(Machine* host);
+
+void LinuxDynamicScreens_appendScreens(Settings* settings);
+
+void LinuxDynamicScreens_addDynamicScreen(ScreenSettings* ss);
+
+/* Table of the named screen, scanned for the current update even if no screen shows it; NULL if unknown */
+Table* LinuxDynamicScreens_table(const char* name);
+
+void LinuxDynamicScreens_addAvailableColumns(Panel* availableColumns, const char* screen);
+
+void LinuxDynamicColumns_done(Hashtable* columns);
+
+void LinuxDynamicScreens_done(Hashtable* screens);
+
+/* Maps a RowField of the active screen to the field of the given table, or -1 */
+int LinuxDynamicColumn_field(const Settings* settings, const Table* table, RowField key);
+
+#endif
@@ -15,6 +15,7 @@ in the source distribution for its full text.
 #include <fcntl.h>
 #include <limits.h>
 #include <math.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,16 +33,61 @@ in the source distribution for its full text.
 #include "UsersTable.h"
 #include "XUtils.h"
 
+#include "linux/DataSource.h"
+#include "linux/LinuxDynamicScreen.h"
 #include "linux/Platform.h" // needed for GNU/hurd to get PATH_MAX  // IWYU pragma: keep
+#include "linux/Snapshot.h"
 
 #ifdef HAVE_SENSORS_SENSORS_H
 #include "LibSensors.h"
 #endif
 
+/* scaling_cur_freq and cpuinfo are not re-read more often than this (ms) */
+#define CPU_FREQUENCY_MIN_INTERVAL 1000
+
 #ifndef O_PATH
 #define O_PATH         010000000 // declare for ancient glibc versions
 #endif
 
+const char* LinuxMachine_procDir = PROCDIR;
+const char* LinuxMachine_sysDir = SYSDIR;
+
+ATTR_FORMAT(printf, 4, 0)
+static char* LinuxMachine_vpath(char* buffer, size_t size, const char* root, const char* fmt, va_list ap) {
+   int n = xSnprintf(buffer, size, "%s", root);
+   int r = vsnprintf(buffer + n, size - n, fmt, ap);
+   if (r < 0 || (size_t)r >= size - n)
+      fail();
+
+   return buffer;
+}
+
+char* LinuxMachine_procPath(char* buffer, size_t size, const char* fmt, ...) {
+   va_list ap;
+   va_start(ap, fmt);
+   LinuxMachine_vpath(buffer, size, LinuxMachine_procDir, fmt, ap);
+   va_end(ap);
+   return buffer;
+}
+
+/* Exits naming the file as opened, under the procfs given at runtime */
+ATTR_NORETURN
+static void LinuxMachine_fatalFileError(const char* note, const char* path) {
+   int error = errno;
+   char message[PATH_MAX + 64];
+   xSnprintf(message, sizeof(message), "%s %s", note, path);
+   errno = error;
+   CRT_fatalError(message);
+}
+
+char* LinuxMachine_sysPath(char* buffer, size_t size, const char* fmt, ...) {
+   va_list ap;
+   va_start(ap, fmt);
+   LinuxMachine_vpath(buffer, size, LinuxMachine_sysDir, fmt, ap);
+   va_end(ap);
+   return buffer;
+}
+
 /* Similar to get_nprocs_conf(3) / _SC_NPROCESSORS_CONF
  * https://sourceware.org/git/?p=glibc.git;a=blob;f=sysdeps/unix/sysv/linux/getsysstats.c;hb=HEAD
  */
@@ -58,7 +104,8 @@ static void LinuxMachine_updateCPUcount(LinuxMachine* this) {
       super->existingCPUs = 1;
    }
 
-   DIR* dir = opendir("/sys/devices/system/cpu");
+   char cpuDir[PATH_MAX];
+   DIR* dir = opendir(LinuxMachine_sysPath(cpuDir, sizeof(cpuDir), "/devices/system/cpu"));
    if (!dir)
       return;
 
@@ -83,7 +130,7 @@ static void LinuxMachine_updateCPUcount(LinuxMachine* this) {
          continue;
 #else
       char cpuDirFd[4096];
-      xSnprintf(cpuDirFd, sizeof(cpuDirFd), "/sys/devices/system/cpu/%s", entry->d_name);
+      xSnprintf(cpuDirFd, sizeof(cpuDirFd), "%s/%s", cpuDir, entry->d_name);
 #endif
 
       existing++;
@@ -142,12 +189,13 @@ static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
    memory_t zswapCompMem = 0;
    memory_t zswapOrigMem = 0;
 
-   FILE* file = fopen(PROCMEMINFOFILE, "r");
-   if (!file)
-      CRT_fatalError("Cannot open " PROCMEMINFOFILE);
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), PROCMEMINFOFILE), 0));
+   if (!content)
+      LinuxMachine_fatalFileError("Cannot open", path);
 
    char buffer[128];
-   while (fgets(buffer, sizeof(buffer), file)) {
+   while (DataSource_nextLine(&content, buffer, sizeof(buffer))) {
 
       #define tryRead(label, variable)                                       \
          if (String_startsWith(buffer, label)) {                             \
@@ -194,8 +242,6 @@ static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
       #undef tryRead
    }
 
-   fclose(file);
-
    /*
     * Compute memory partition like procps(free)
     *  https://gitlab.com/procps-ng/procps/-/blob/master/proc/sysinfo.c
@@ -224,7 +270,8 @@ static void LinuxMachine_scanHugePages(LinuxMachine* this) {
       this->usedHugePageMem[i] = MEMORY_MAX;
    }
 
-   DIR* dir = opendir("/sys/kernel/mm/hugepages");
+   char hugePageDir[PATH_MAX];
+   DIR* dir = opendir(LinuxMachine_sysPath(hugePageDir, sizeof(hugePageDir), "/kernel/mm/hugepages"));
    if (!dir)
       return;
 
@@ -244,22 +291,21 @@ static void LinuxMachine_scanHugePages(LinuxMachine* this) {
       if (!endptr || *endptr != 'k')
          continue;
 
-      char content[64];
-      char hugePagePath[128];
-      ssize_t r;
+      const char* content;
+      char hugePagePath[PATH_MAX];
 
-      xSnprintf(hugePagePath, sizeof(hugePagePath), "/sys/kernel/mm/hugepages/%s/nr_hugepages", name);
-      r = xReadfile(hugePagePath, content, sizeof(content));
-      if (r <= 0)
+      xSnprintf(hugePagePath, sizeof(hugePagePath), "%s/%s/nr_hugepages", hugePageDir, name);
+      content = DataSource_read(DataSource_get(hugePagePath, 0));
+      if (!content || !*content)
          continue;
 
       memory_t total = strtoull(content, NULL, 10);
       if (total == 0)
          continue;
 
-      xSnprintf(hugePagePath, sizeof(hugePagePath), "/sys/kernel/mm/hugepages/%s/free_hugepages", name);
-      r = xReadfile(hugePagePath, content, sizeof(content));
-      if (r <= 0)
+      xSnprintf(hugePagePath, sizeof(hugePagePath), "%s/%s/free_hugepages", hugePageDir, name);
+      content = DataSource_read(DataSource_get(hugePagePath, 0));
+      if (!content || !*content)
          continue;
 
       memory_t free = strtoull(content, NULL, 10);
@@ -279,42 +325,31 @@ static void LinuxMachine_scanZramInfo(LinuxMachine* this) {
    memory_t usedZramComp = 0;
    memory_t usedZramOrig = 0;
 
-   char mm_stat[34];
-   char disksize[34];
+   char mm_stat[PATH_MAX];
+   char disksize[PATH_MAX];
 
    unsigned int i = 0;
    for (;;) {
-      xSnprintf(mm_stat, sizeof(mm_stat), "/sys/block/zram%u/mm_stat", i);
-      xSnprintf(disksize, sizeof(disksize), "/sys/block/zram%u/disksize", i);
+      LinuxMachine_sysPath(mm_stat, sizeof(mm_stat), "/block/zram%u/mm_stat", i);
+      LinuxMachine_sysPath(disksize, sizeof(disksize), "/block/zram%u/disksize", i);
       i++;
-      FILE* disksize_file = fopen(disksize, "r");
-      FILE* mm_stat_file = fopen(mm_stat, "r");
-      if (disksize_file == NULL || mm_stat_file == NULL) {
-         if (disksize_file) {
-            fclose(disksize_file);
-         }
-         if (mm_stat_file) {
-            fclose(mm_stat_file);
-         }
+      const char* disksize_content = DataSource_read(DataSource_get(disksize, 0));
+      const char* mm_stat_content = disksize_content ? DataSource_read(DataSource_get(mm_stat, 0)) : NULL;
+      if (disksize_content == NULL || mm_stat_content == NULL)
          break;
-      }
+
       memory_t size = 0;
       memory_t orig_data_size = 0;
       memory_t compr_data_size = 0;
 
-      if (1 != fscanf(disksize_file, "%llu\n", &size) ||
-          2 != fscanf(mm_stat_file, "    %llu       %llu", &orig_data_size, &compr_data_size)) {
-         fclose(disksize_file);
-         fclose(mm_stat_file);
+      if (1 != sscanf(disksize_content, "%llu\n", &size) ||
+          2 != sscanf(mm_stat_content, "    %llu       %llu", &orig_data_size, &compr_data_size)) {
          break;
       }
 
       totalZram += size;
       usedZramComp += compr_data_size;
       usedZramOrig += orig_data_size;
-
-      fclose(disksize_file);
-      fclose(mm_stat_file);
    }
 
    this->zram.totalZram = totalZram / 1024;
@@ -325,18 +360,152 @@ static void LinuxMachine_scanZramInfo(LinuxMachine* this) {
    }
 }
 
+static void LinuxMachine_scanNumaNodes(LinuxMachine* this) {
+   for (unsigned int i = 0; i < this->numaNodes; i++) {
+      NumaNodeData* node = &this->numaNodeData[i];
+      if (!node->present)
+         continue;
+
+      const char* content = DataSource_read(node->meminfoSource);
+      if (!content)
+         continue;
+
+      memory_t totalMem = 0;
+      memory_t freeMem = 0;
+      memory_t filePages = 0;
+      memory_t sharedMem = 0;
+      memory_t sreclaimableMem = 0;
+
+      /* "Node 0 MemTotal:       32768 kB" */
+      do {
+         const char* label;
+         (void) DataSource_nextWord(&content, &label);  /* Node */
+         (void) DataSource_nextNumber(&content);        /* id */
+         size_t len = DataSource_nextWord(&content, &label);
+
+         memory_t* variable = NULL;
+         if (len == 9 && String_startsWith(label, "MemTotal:"))
+            variable = &totalMem;
+         else if (len == 8 && String_startsWith(label, "MemFree:"))
+            variable = &freeMem;
+         else if (len == 10 && String_startsWith(label, "FilePages:"))
+            variable = &filePages;
+         else if (len == 6 && String_startsWith(label, "Shmem:"))
+            variable = &sharedMem;
+         else if (len == 13 && String_startsWith(label, "SReclaimable:"))
+            variable = &sreclaimableMem;
+
+         if (variable)
+            *variable = DataSource_nextNumber(&content);
+      } while (DataSource_skipLine(&content));
+
+      /* same partition as the memory meter, FilePages is Cached plus Buffers */
+      const memory_t usedDiff = freeMem + filePages + sreclaimableMem;
+      node->totalMem = totalMem;
+      node->freeMem = freeMem;
+      node->sharedMem = sharedMem;
+      node->cachedMem = saturatingSub(filePages + sreclaimableMem, sharedMem);
+      node->usedMem = (totalMem >= usedDiff) ? totalMem - usedDiff : totalMem - freeMem;
+   }
+}
+
+/* Assigns node to the CPUs of a sysfs cpulist like "0-3,8-11" */
+static void LinuxMachine_assignCPUList(LinuxMachine* this, const char* list, int node) {
+   while (*list) {
+      char* end;
+      unsigned long first = strtoul(list, &end, 10);
+      if (end == list)
+         break;
+
+      unsigned long last = first;
+      if (*end == '-')
+         last = strtoul(end + 1, &end, 10);
+
+      for (unsigned long cpu = first; cpu <= last && cpu < this->cpuNodeCount; cpu++)
+         this->cpuNode[cpu] = node;
+
+      if (*end != ',')
+         break;
+      list = end + 1;
+   }
+}
+
+static void LinuxMachine_fetchNumaTopology(LinuxMachine* this) {
+   Machine* super = &this->super;
+
+   char nodeDir[PATH_MAX];
+   DIR* dir = opendir(LinuxMachine_sysPath(nodeDir, sizeof(nodeDir), "/devices/system/node"));
+   if (!dir)
+      return;
+
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      if (!String_startsWith(entry->d_name, "node"))
+         continue;
+
+      char* endp;
+      unsigned long int id = strtoul(entry->d_name + 4, &endp, 10);
+      if (endp == entry->d_name + 4 || *endp != '\0' || id >= 4096)
+         continue;
+
+      if (id >= this->numaNodes) {
+         this->numaNodeData = xReallocArrayZero(this->numaNodeData, this->numaNodes, id + 1, sizeof(NumaNodeData));
+         this->numaNodes = id + 1;
+      }
+
+      char path[PATH_MAX];
+      xSnprintf(path, sizeof(path), "%s/%s/meminfo", nodeDir, entry->d_name);
+      this->numaNodeData[id].present = true;
+      this->numaNodeData[id].meminfoSource = DataSource_get(path, 0);
+   }
+
+   closedir(dir);
+
+   if (this->numaNodes == 0)
+      return;
+
+   this->cpuNodeCount = super->existingCPUs;
+   this->cpuNode = xMallocArray(this->cpuNodeCount, sizeof(int));
+   for (unsigned int i = 0; i < this->cpuNodeCount; i++)
+      this->cpuNode[i] = -1;
+
+   #ifdef HAVE_LIBHWLOC
+   /* hwloc describes the running system, not an alternative sysfs root */
+   if (super->topologyOk && String_eq(LinuxMachine_sysDir, SYSDIR)) {
+      for (unsigned int i = 0; i < this->cpuNodeCount; i++) {
+         hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(super->topology, i);
+         if (pu && pu->nodeset)
+            this->cpuNode[i] = hwloc_bitmap_first(pu->nodeset);
+      }
+      return;
+   }
+   #endif
+
+   for (unsigned int id = 0; id < this->numaNodes; id++) {
+      if (!this->numaNodeData[id].present)
+         continue;
+
+      char path[PATH_MAX];
+      char buffer[1024];
+      xSnprintf(path, sizeof(path), "%s/node%u/cpulist", nodeDir, id);
+      if (xReadfile(path, buffer, sizeof(buffer)) > 0)
+         LinuxMachine_assignCPUList(this, buffer, (int)id);
+   }
+}
+
 static void LinuxMachine_scanZfsArcstats(LinuxMachine* this) {
    memory_t dbufSize = 0;
    memory_t dnodeSize = 0;
    memory_t bonusSize = 0;
 
-   FILE* file = fopen(PROCARCSTATSFILE, "r");
-   if (file == NULL) {
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), PROCARCSTATSFILE), 0));
+   if (content == NULL) {
       this->zfs.enabled = 0;
       return;
    }
    char buffer[128];
-   while (fgets(buffer, 128, file)) {
+   while (DataSource_nextLine(&content, buffer, sizeof(buffer))) {
       #define tryRead(label, variable)                                         \
          if (String_startsWith(buffer, label)) {                               \
             sscanf(buffer + strlen(label), " %*2u %32llu", variable);          \
@@ -382,7 +551,6 @@ static void LinuxMachine_scanZfsArcstats(LinuxMachine* this) {
       #undef tryRead
       #undef tryReadFlag
    }
-   fclose(file);
 
    this->zfs.enabled = (this->zfs.size > 0 ? 1 : 0);
    this->zfs.size   /= 1024;
@@ -404,9 +572,10 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
 
    LinuxMachine_updateCPUcount(this);
 
-   FILE* file = fopen(PROCSTATFILE, "r");
-   if (!file)
-      CRT_fatalError("Cannot open " PROCSTATFILE);
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), PROCSTATFILE), 0));
+   if (!content)
+      LinuxMachine_fatalFileError("Cannot open", path);
 
    // Add an extra phantom thread for a later loop
    bool adjCpuIdProcessed[super->existingCPUs+2];
@@ -417,8 +586,7 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
       unsigned long long int usertime, nicetime, systemtime, idletime;
       unsigned long long int ioWait = 0, irq = 0, softIrq = 0, steal = 0, guest = 0, guestnice = 0;
 
-      const char* ok = fgets(buffer, sizeof(buffer), file);
-      if (!ok)
+      if (!DataSource_nextLine(&content, buffer, sizeof(buffer)))
          break;
 
       // cpu fields are sorted first
@@ -497,17 +665,9 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
 
    this->period = (double)this->cpuData[0].totalPeriod / super->activeCPUs;
 
-   if (!ferror(file) && !feof(file)) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      while (fgets(buffer, sizeof(buffer), file)) {
-         if (String_startsWith(buffer, "procs_running")) {
-            this->runningTasks = (unsigned int) strtoul(buffer + strlen("procs_running"), NULL, 10);
-            break;
-         }
-      }
-   }
-
-   fclose(file);
+   const char* procsRunning = strstr(content, "\nprocs_running");
+   if (procsRunning)
+      this->runningTasks = (unsigned int) strtoul(procsRunning + strlen("\nprocs_running"), NULL, 10);
 }
 
 static int scanCPUFrequencyFromSysCPUFreq(LinuxMachine* this) {
@@ -533,28 +693,30 @@ static int scanCPUFrequencyFromSysCPUFreq(LinuxMachine* this) {
       if (!Machine_isCPUonline(super, i))
          continue;
 
-      char pathBuffer[64];
-      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", i);
+      CPUData* cpuData = &this->cpuData[i + 1];
+      if (!cpuData->frequencySource) {
+         char pathBuffer[PATH_MAX];
+         LinuxMachine_sysPath(pathBuffer, sizeof(pathBuffer), "/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", i);
+         cpuData->frequencySource = DataSource_get(pathBuffer, CPU_FREQUENCY_MIN_INTERVAL);
+      }
 
       struct timespec start;
       if (i == 0)
          clock_gettime(CLOCK_MONOTONIC, &start);
 
-      FILE* file = fopen(pathBuffer, "r");
-      if (!file)
+      const char* content = DataSource_read(cpuData->frequencySource);
+      if (!content)
          return -errno;
 
       unsigned long frequency;
-      if (fscanf(file, "%lu", &frequency) == 1) {
+      if (sscanf(content, "%lu", &frequency) == 1) {
          /* convert kHz to MHz */
          frequency = frequency / 1000;
-         this->cpuData[i + 1].frequency = frequency;
+         cpuData->frequency = frequency;
          numCPUsWithFrequency++;
          totalFrequency += frequency;
       }
 
-      fclose(file);
-
       if (i == 0) {
          struct timespec end;
          clock_gettime(CLOCK_MONOTONIC, &end);
@@ -575,19 +737,20 @@ static int scanCPUFrequencyFromSysCPUFreq(LinuxMachine* this) {
 static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
    const Machine* super = &this->super;
 
-   FILE* file = fopen(PROCCPUINFOFILE, "r");
-   if (file == NULL)
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), PROCCPUINFOFILE), CPU_FREQUENCY_MIN_INTERVAL));
+   if (content == NULL)
       return;
 
    int numCPUsWithFrequency = 0;
    double totalFrequency = 0;
    int cpuid = -1;
 
-   while (!feof(file)) {
+   for (;;) {
       double frequency;
       char buffer[PROC_LINE_LENGTH];
 
-      if (fgets(buffer, PROC_LINE_LENGTH, file) == NULL)
+      if (!DataSource_nextLine(&content, buffer, sizeof(buffer)))
          break;
 
       if (
@@ -616,7 +779,6 @@ static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
          cpuid = -1;
       }
    }
-   fclose(file);
 
    if (numCPUsWithFrequency > 0) {
       this->cpuData[0].frequency = totalFrequency / numCPUsWithFrequency;
@@ -627,7 +789,8 @@ static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
 static void LinuxMachine_fetchCPUTopologyFromCPUinfo(LinuxMachine* this) {
    const Machine* super = &this->super;
 
-   FILE* file = fopen(PROCCPUINFOFILE, "r");
+   char path[PATH_MAX];
+   FILE* file = fopen(LinuxMachine_procPath(path, sizeof(path), PROCCPUINFOFILE), "r");
    if (file == NULL)
       return;
 
@@ -732,10 +895,16 @@ static void LinuxMachine_scanCPUFrequency(LinuxMachine* this) {
 void Machine_scan(Machine* super) {
    LinuxMachine* this = (LinuxMachine*) super;
 
+   if (Snapshot_reader) {
+      SnapshotReader_scanMachine(Snapshot_reader, this);
+      return;
+   }
+
    LinuxMachine_scanMemoryInfo(this);
    LinuxMachine_scanHugePages(this);
    LinuxMachine_scanZfsArcstats(this);
    LinuxMachine_scanZramInfo(this);
+   LinuxMachine_scanNumaNodes(this);
    LinuxMachine_scanCPUTime(this);
 
    const Settings* settings = super->settings;
@@ -768,9 +937,10 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
       CRT_fatalError("Cannot get clock ticks by sysconf(_SC_CLK_TCK)");
 
    // Read btime (the kernel boot time, as number of seconds since the epoch)
-   FILE* statfile = fopen(PROCSTATFILE, "r");
+   char statPath[PATH_MAX];
+   FILE* statfile = fopen(LinuxMachine_procPath(statPath, sizeof(statPath), PROCSTATFILE), "r");
    if (statfile == NULL)
-      CRT_fatalError("Cannot open " PROCSTATFILE);
+      LinuxMachine_fatalFileError("Cannot open", statPath);
 
    this->boottime = -1;
 
@@ -782,15 +952,18 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
          continue;
       if (sscanf(buffer, "btime %lld\n", &this->boottime) == 1)
          break;
-      CRT_fatalError("Failed to parse btime from " PROCSTATFILE);
+      LinuxMachine_fatalFileError("Failed to parse btime from", statPath);
    }
    fclose(statfile);
 
    if (this->boottime == -1)
-      CRT_fatalError("No btime in " PROCSTATFILE);
+      LinuxMachine_fatalFileError("No btime in", statPath);
 
-   // Initialize CPU count
-   LinuxMachine_updateCPUcount(this);
+   // Initialize CPU count, from the collector when attached to its snapshots
+   if (Snapshot_reader)
+      SnapshotReader_scanMachine(Snapshot_reader, this);
+   if (super->existingCPUs == 0)
+      LinuxMachine_updateCPUcount(this);
 
    #ifdef HAVE_SENSORS_SENSORS_H
    // Fetch CPU topology
@@ -799,6 +972,13 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    LinuxMachine_assignCCDs(this, ccds);
    #endif
 
+   // NUMA nodes and their CPUs, not part of the collector's snapshots
+   if (!Snapshot_reader)
+      LinuxMachine_fetchNumaTopology(this);
+
+   // Create tables backing the built-in dynamic screens; scanned only once in use
+   LinuxDynamicScreens_appendTables(super);
+
    return super;
 }
 
@@ -815,6 +995,8 @@ void Machine_delete(Machine* super) {
       gpuEngineData = next;
    }
 
+   free(this->numaNodeData);
+   free(this->cpuNode);
    free(this->cpuData);
    free(this);
 }
@@ -8,8 +8,10 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "Machine.h"
+#include "Macros.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
 #include "zfs/ZfsArcStats.h"
@@ -45,6 +47,7 @@ typedef struct CPUData_ {
    unsigned long long int guestPeriod;
 
    double frequency;
+   struct DataSource_* frequencySource;  /* scaling_cur_freq, owned by the DataSource registry */
 
    #ifdef HAVE_SENSORS_SENSORS_H
    double temperature;
@@ -63,6 +66,16 @@ typedef struct GPUEngineData_ {
    struct GPUEngineData_* next;
 } GPUEngineData;
 
+typedef struct NumaNodeData_ {
+   bool present;              /* node ids might not be contiguous */
+   memory_t totalMem;
+   memory_t usedMem;
+   memory_t cachedMem;
+   memory_t sharedMem;
+   memory_t freeMem;
+   struct DataSource_* meminfoSource;  /* node<N>/meminfo, owned by the DataSource registry */
+} NumaNodeData;
+
 typedef struct LinuxMachine_ {
    Machine super;
 
@@ -88,6 +101,14 @@ typedef struct LinuxMachine_ {
 
    memory_t availableMem;
 
+   /* indexed by the node id, numaNodes is the highest node id plus one */
+   unsigned int numaNodes;
+   NumaNodeData* numaNodeData;
+
+   /* NUMA node of each CPU id, -1 if unknown */
+   int* cpuNode;
+   unsigned int cpuNodeCount;
+
    unsigned long long int prevGpuTime, curGpuTime;  /* total absolute GPU time in nano seconds */
    GPUEngineData* gpuEngineData;
 
@@ -100,28 +121,50 @@ typedef struct LinuxMachine_ {
 #define PROCDIR "/proc"
 #endif
 
+#ifndef SYSDIR
+#define SYSDIR "/sys"
+#endif
+
+/* Roots of procfs and sysfs, PROCDIR and SYSDIR unless changed on the command line */
+extern const char* LinuxMachine_procDir;
+extern const char* LinuxMachine_sysDir;
+
+/* The following files are relative to LinuxMachine_procDir */
+
 #ifndef PROCCPUINFOFILE
-#define PROCCPUINFOFILE PROCDIR "/cpuinfo"
+#define PROCCPUINFOFILE "/cpuinfo"
 #endif
 
 #ifndef PROCSTATFILE
-#define PROCSTATFILE PROCDIR "/stat"
+#define PROCSTATFILE "/stat"
 #endif
 
 #ifndef PROCMEMINFOFILE
-#define PROCMEMINFOFILE PROCDIR "/meminfo"
+#define PROCMEMINFOFILE "/meminfo"
 #endif
 
 #ifndef PROCARCSTATSFILE
-#define PROCARCSTATSFILE PROCDIR "/spl/kstat/zfs/arcstats"
+#define PROCARCSTATSFILE "/spl/kstat/zfs/arcstats"
 #endif
 
 #ifndef PROCTTYDRIVERSFILE
-#define PROCTTYDRIVERSFILE PROCDIR "/tty/drivers"
+#define PROCTTYDRIVERSFILE "/tty/drivers"
 #endif
 
 #ifndef PROC_LINE_LENGTH
 #define PROC_LINE_LENGTH 4096
 #endif
 
+static inline int LinuxMachine_cpuNode(const LinuxMachine* this, int cpu) {
+   return (cpu >= 0 && (unsigned int)cpu < this->cpuNodeCount) ? this->cpuNode[cpu] : -1;
+}
+
+/* Formats a path below the procfs root into buffer and returns buffer */
+ATTR_FORMAT(printf, 3, 4) ATTR_NONNULL
+char* LinuxMachine_procPath(char* buffer, size_t size, const char* fmt, ...);
+
+/* Formats a path below the sysfs root into buffer and returns buffer */
+ATTR_FORMAT(printf, 3, 4) ATTR_NONNULL
+char* LinuxMachine_sysPath(char* buffer, size_t size, const char* fmt, ...);
+
 #endif
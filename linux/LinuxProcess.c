@@ -11,10 +11,12 @@ in the source distribution for its full text.
 #include "linux/LinuxProcess.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <syscall.h>
 #include <unistd.h>
 
@@ -29,6 +31,7 @@ in the source distribution for its full text.
 #include "XUtils.h"
 #include "linux/IOPriority.h"
 #include "linux/LinuxMachine.h"
+#include "linux/Snapshot.h"
 
 
 const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
@@ -112,15 +115,93 @@ const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
 #endif
    [GPU_TIME] = { .name = "GPU_TIME", .title = "GPU_TIME ", .description = "Total GPU time", .flags = PROCESS_FLAG_LINUX_GPU, .defaultSortDesc = true, },
    [GPU_PERCENT] = { .name = "GPU_PERCENT", .title = " GPU% ", .description = "Percentage of the GPU time the process used in the last sampling", .flags = PROCESS_FLAG_LINUX_GPU, .defaultSortDesc = true, },
+   [PERCENT_RUNQ_WAIT] = { .name = "PERCENT_RUNQ_WAIT", .title = "RUNQ% ", .description = "Percentage of time spent waiting on a CPU run queue since last update (from schedstat)", .flags = PROCESS_FLAG_LINUX_SCHEDSTAT, .defaultSortDesc = true, },
+   [TIMESLICE_RATE] = { .name = "TIMESLICE_RATE", .title = "   SLICES/s ", .description = "Number of timeslices run on a CPU per second (from schedstat)", .flags = PROCESS_FLAG_LINUX_SCHEDSTAT, .defaultSortDesc = true, },
+   [PERCENT_CPU_HISTORY] = { .name = "PERCENT_CPU_HISTORY", .title = "CPU HIST ", .description = "Sparkline of the recent CPU usage, scaled to its peak but at least one full CPU", .flags = PROCESS_FLAG_LINUX_HISTORY, .defaultSortDesc = true, },
+   [M_RESIDENT_HISTORY] = { .name = "M_RESIDENT_HISTORY", .title = "RES HIST ", .description = "Sparkline of the recent resident set size, scaled to its peak", .flags = PROCESS_FLAG_LINUX_HISTORY, .defaultSortDesc = true, },
+   [IO_RATE_HISTORY] = { .name = "IO_RATE_HISTORY", .title = " IO HIST ", .description = "Sparkline of the recent total I/O rate, scaled to its peak", .flags = PROCESS_FLAG_IO | PROCESS_FLAG_LINUX_HISTORY, .defaultSortDesc = true, },
+   [NET_NS] = { .name = "NET_NS", .title = "     NETNS ", .description = "Inode of the network namespace of the process", .flags = PROCESS_FLAG_LINUX_NETNS, },
+   [NET_NS_RX_RATE] = { .name = "NET_NS_RX_RATE", .title = "   NETNS RX ", .description = "Bytes received per second in the network namespace of the process", .flags = PROCESS_FLAG_LINUX_NETNS, .defaultSortDesc = true, },
+   [NET_NS_TX_RATE] = { .name = "NET_NS_TX_RATE", .title = "   NETNS TX ", .description = "Bytes transmitted per second in the network namespace of the process", .flags = PROCESS_FLAG_LINUX_NETNS, .defaultSortDesc = true, },
+   [NUMA_NODE] = { .name = "NUMA_NODE", .title = "NODE ", .description = "NUMA node holding most of the resident memory, marked with * when last run on a CPU of another node", .flags = PROCESS_FLAG_LINUX_NUMA, },
+   [PERCENT_NUMA_REMOTE] = { .name = "PERCENT_NUMA_REMOTE", .title = "RMT% ", .description = "Percentage of the resident memory on other NUMA nodes than the one of the CPU last run on", .flags = PROCESS_FLAG_LINUX_NUMA, .defaultSortDesc = true, },
+   [M_USS] = { .name = "M_USS", .title = "  USS ", .description = "Unique set size: resident memory shared with no other process, estimated from a sample of pages", .flags = PROCESS_FLAG_LINUX_USS, .defaultSortDesc = true, },
+   [M_WSS] = { .name = "M_WSS", .title = "  WSS ", .description = "Working set size: resident memory accessed within the configured window (idle page tracking, requires root)", .flags = PROCESS_FLAG_LINUX_WSS, .defaultSortDesc = true, },
+   [PERF_IPC] = { .name = "PERF_IPC", .title = " IPC ", .description = "Instructions per CPU cycle (perf_event hardware counters)", .flags = PROCESS_FLAG_LINUX_PERF, .defaultSortDesc = true, },
+   [PERF_CACHE_MISS] = { .name = "PERF_CACHE_MISS", .title = "MISS% ", .description = "Percentage of cache references that missed (perf_event hardware counters)", .flags = PROCESS_FLAG_LINUX_PERF, .defaultSortDesc = true, },
+   [PERF_CSW_RATE] = { .name = "PERF_CSW_RATE", .title = "      CSW/s ", .description = "Context switches per second (perf_event software counter)", .flags = PROCESS_FLAG_LINUX_PERF, .defaultSortDesc = true, },
+   [PERF_FAULT_RATE] = { .name = "PERF_FAULT_RATE", .title = "   FAULTS/s ", .description = "Page faults per second (perf_event software counter)", .flags = PROCESS_FLAG_LINUX_PERF, .defaultSortDesc = true, },
+#ifdef HAVE_BPF
+   [RUNQ_P50] = { .name = "RUNQ_P50", .title = "RUNQ P50 ", .description = "Median run queue delay of the thread group since the last update (eBPF, requires root)", .flags = PROCESS_FLAG_LINUX_SCHEDLAT, .defaultSortDesc = true, },
+   [RUNQ_P99] = { .name = "RUNQ_P99", .title = "RUNQ P99 ", .description = "99th percentile of the run queue delay of the thread group since the last update (eBPF, requires root)", .flags = PROCESS_FLAG_LINUX_SCHEDLAT, .defaultSortDesc = true, },
+   [OFFCPU_P50] = { .name = "OFFCPU_P50", .title = " OFF P50 ", .description = "Median time off the CPU between two runs of a task of the thread group since the last update (eBPF, requires root)", .flags = PROCESS_FLAG_LINUX_SCHEDLAT, .defaultSortDesc = true, },
+   [OFFCPU_P99] = { .name = "OFFCPU_P99", .title = " OFF P99 ", .description = "99th percentile of the time off the CPU between two runs of a task of the thread group since the last update (eBPF, requires root)", .flags = PROCESS_FLAG_LINUX_SCHEDLAT, .defaultSortDesc = true, },
+#endif
+   [M_USS_ERROR] = { .name = "M_USS_ERROR", .title = "USSERR", .description = "Error bound of the unique set size estimate at the configured confidence", .flags = PROCESS_FLAG_LINUX_USS, .defaultSortDesc = true, },
 };
 
 Process* LinuxProcess_new(const Machine* host) {
    LinuxProcess* this = xCalloc(1, sizeof(LinuxProcess));
    Object_setClass(this, Class(LinuxProcess));
    Process_init(&this->super, host);
+   this->netns_rx_rate = NAN;
+   this->netns_tx_rate = NAN;
+   this->numa_node = -1;
+   this->percent_numa_remote = NAN;
+   this->m_uss = NAN;
+   this->m_uss_error = NAN;
+   this->m_wss = NAN;
+   for (size_t i = 0; i < PERF_EVENT_COUNT; i++)
+      this->perf_rates[i] = NAN;
+   #ifdef HAVE_BPF
+   this->runq_p50 = NAN;
+   this->runq_p99 = NAN;
+   this->offcpu_p50 = NAN;
+   this->offcpu_p99 = NAN;
+   #endif
    return (Process*)this;
 }
 
+void LinuxProcess_updateFieldWidths(const LinuxProcess* this, uint32_t flags) {
+   if ((flags & PROCESS_FLAG_LINUX_CGROUP) && this->cgroup) {
+      Row_updateFieldWidth(CGROUP, strlen(this->cgroup));
+      Row_updateFieldWidth(CCGROUP, strlen(this->cgroup_short ? this->cgroup_short : this->cgroup));
+      Row_updateFieldWidth(CONTAINER, this->container_short ? strlen(this->container_short) : strlen("N/A"));
+   }
+   if ((flags & PROCESS_FLAG_LINUX_SECATTR) && this->secattr) {
+      Row_updateFieldWidth(SECATTR, strlen(this->secattr));
+   }
+}
+
+static double LinuxProcess_totalIORate(const LinuxProcess* lp) {
+   double totalRate = NAN;
+   if (isNonnegative(lp->io_rate_read_bps)) {
+      totalRate = lp->io_rate_read_bps;
+      if (isNonnegative(lp->io_rate_write_bps)) {
+         totalRate += lp->io_rate_write_bps;
+      }
+   } else if (isNonnegative(lp->io_rate_write_bps)) {
+      totalRate = lp->io_rate_write_bps;
+   }
+   return totalRate;
+}
+
+void LinuxProcess_updateHistory(LinuxProcess* this, bool enabled) {
+   if (!enabled) {
+      /* keep no samples while no sparkline column is shown */
+      if (this->super.super.history)
+         Row_freeHistory(&this->super.super);
+      return;
+   }
+
+   const double values[ROW_HISTORY_SERIES] = {
+      [ROW_HISTORY_CPU] = this->super.percent_cpu,
+      [ROW_HISTORY_MEMORY] = (double) this->super.m_resident,
+      [ROW_HISTORY_IO] = LinuxProcess_totalIORate(this),
+   };
+   Row_recordHistory(&this->super.super, values);
+}
+
 void Process_delete(Object* cast) {
    LinuxProcess* this = (LinuxProcess*) cast;
    Process_done((Process*)cast);
@@ -131,6 +212,8 @@ void Process_delete(Object* cast) {
    free(this->ctid);
 #endif
    free(this->secattr);
+   free(this->numa_kb);
+   free(this->wss_cgroup);
    free(this);
 }
 
@@ -184,16 +267,17 @@ bool LinuxProcess_rowSetIOPriority(Row* super, Arg ioprio) {
 }
 
 bool LinuxProcess_isAutogroupEnabled(void) {
+   char path[PATH_MAX];
    char buf[16];
-   if (xReadfile(PROCDIR "/sys/kernel/sched_autogroup_enabled", buf, sizeof(buf)) < 0)
+   if (xReadfile(LinuxMachine_procPath(path, sizeof(path), "/sys/kernel/sched_autogroup_enabled"), buf, sizeof(buf)) < 0)
       return false;
    return buf[0] == '1';
 }
 
 static bool LinuxProcess_changeAutogroupPriorityBy(Process* p, Arg delta) {
-   char buffer[256];
+   char buffer[PATH_MAX];
    pid_t pid = Process_getPid(p);
-   xSnprintf(buffer, sizeof(buffer), PROCDIR "/%d/autogroup", pid);
+   LinuxMachine_procPath(buffer, sizeof(buffer), "/%d/autogroup", pid);
 
    FILE* file = fopen(buffer, "r+");
    if (!file)
@@ -218,18 +302,15 @@ bool LinuxProcess_rowChangeAutogroupPriorityBy(Row* super, Arg delta) {
    return LinuxProcess_changeAutogroupPriorityBy(p, delta);
 }
 
-static double LinuxProcess_totalIORate(const LinuxProcess* lp) {
-   double totalRate = NAN;
-   if (isNonnegative(lp->io_rate_read_bps)) {
-      totalRate = lp->io_rate_read_bps;
-      if (isNonnegative(lp->io_rate_write_bps)) {
-         totalRate += lp->io_rate_write_bps;
-      }
-   } else if (isNonnegative(lp->io_rate_write_bps)) {
-      totalRate = lp->io_rate_write_bps;
+#ifdef HAVE_BPF
+static void LinuxProcess_printLatency(RichString* str, double nanoseconds, bool coloring) {
+   if (isNonnegative(nanoseconds)) {
+      Row_printNanoseconds(str, (unsigned long long) nanoseconds, coloring);
+   } else {
+      RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], "     N/A ");
    }
-   return totalRate;
 }
+#endif
 
 static void LinuxProcess_rowWriteField(const Row* super, RichString* str, ProcessField field) {
    const Process* this = (const Process*) super;
@@ -242,10 +323,21 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
    int attr = CRT_colors[DEFAULT_COLOR];
    size_t n = sizeof(buffer) - 1;
 
+   /* data the collector does not gather is unavailable, not stale or zero */
+   if (Snapshot_reader && field < LAST_PROCESSFIELD && !SnapshotReader_hasFlags(Snapshot_reader, Process_fields[field].flags)) {
+      const char* title = RowField_alignedTitle(host->settings, field);
+      int width = MAXIMUM((int) strlen(title) - 1, 3);
+      xSnprintf(buffer, n, title[0] == ' ' ? "%*s " : "%-*s ", width, "N/A");
+      RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], buffer);
+      return;
+   }
+
    switch (field) {
    case CMINFLT: Row_printCount(str, lp->cminflt, coloring); return;
    case CMAJFLT: Row_printCount(str, lp->cmajflt, coloring); return;
    case GPU_PERCENT: Row_printPercentage(lp->gpu_percent, buffer, n, 5, &attr); break;
+   case PERCENT_RUNQ_WAIT: Row_printPercentage(lp->sched_wait_percent, buffer, n, 5, &attr); break;
+   case TIMESLICE_RATE: Row_printCount(str, isNonnegative(lp->sched_timeslice_rate) ? (unsigned long long) lp->sched_timeslice_rate : ULLONG_MAX, coloring); return;
    case GPU_TIME: Row_printNanoseconds(str, lp->gpu_time, coloring); return;
    case M_DRS: Row_printBytes(str, lp->m_drs * lhost->pageSize, coloring); return;
    case M_LRS:
@@ -277,6 +369,46 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
    case IO_READ_RATE:  Row_printRate(str, lp->io_rate_read_bps, coloring); return;
    case IO_WRITE_RATE: Row_printRate(str, lp->io_rate_write_bps, coloring); return;
    case IO_RATE: Row_printRate(str, LinuxProcess_totalIORate(lp), coloring); return;
+   case PERCENT_CPU_HISTORY: Row_printHistory(str, super, ROW_HISTORY_CPU, 100.0); return;
+   case M_RESIDENT_HISTORY: Row_printHistory(str, super, ROW_HISTORY_MEMORY, 0.0); return;
+   case IO_RATE_HISTORY: Row_printHistory(str, super, ROW_HISTORY_IO, 0.0); return;
+   case NET_NS:
+      if (lp->net_ns) {
+         xSnprintf(buffer, n, "%10llu ", (unsigned long long) lp->net_ns);
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%10s ", "N/A");
+      }
+      break;
+   case NET_NS_RX_RATE: Row_printRate(str, lp->netns_rx_rate, coloring); return;
+   case NET_NS_TX_RATE: Row_printRate(str, lp->netns_tx_rate, coloring); return;
+   case NUMA_NODE:
+      if (lp->numa_node >= 0) {
+         if (lp->numa_off_node)
+            attr = CRT_colors[PROCESS_HIGH_PRIORITY];
+         xSnprintf(buffer, n, "%3d%c ", lp->numa_node, lp->numa_off_node ? '*' : ' ');
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, " N/A ");
+      }
+      break;
+   case PERCENT_NUMA_REMOTE: Row_printPercentage(lp->percent_numa_remote, buffer, n, 4, &attr); break;
+   case M_USS: Row_printKBytes(str, isnan(lp->m_uss) ? ULLONG_MAX : (unsigned long long) lp->m_uss, coloring); return;
+   case M_WSS: Row_printKBytes(str, isnan(lp->m_wss) ? ULLONG_MAX : (unsigned long long) lp->m_wss, coloring); return;
+   case M_USS_ERROR: Row_printKBytes(str, isnan(lp->m_uss_error) ? ULLONG_MAX : (unsigned long long) lp->m_uss_error, coloring); return;
+   case PERF_IPC: {
+      double ipc = PerfCounters_ratio(lp->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES);
+      if (isNonnegative(ipc)) {
+         xSnprintf(buffer, n, "%4.2f ", MINIMUM(ipc, 9.99));
+      } else {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, " N/A ");
+      }
+      break;
+   }
+   case PERF_CACHE_MISS: Row_printPercentage((float) (100.0 * PerfCounters_ratio(lp->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES)), buffer, n, 5, &attr); break;
+   case PERF_CSW_RATE: Row_printCount(str, isNonnegative(lp->perf_rates[PERF_EVENT_CONTEXT_SWITCHES]) ? (unsigned long long) lp->perf_rates[PERF_EVENT_CONTEXT_SWITCHES] : ULLONG_MAX, coloring); return;
+   case PERF_FAULT_RATE: Row_printCount(str, isNonnegative(lp->perf_rates[PERF_EVENT_PAGE_FAULTS]) ? (unsigned long long) lp->perf_rates[PERF_EVENT_PAGE_FAULTS] : ULLONG_MAX, coloring); return;
    #ifdef HAVE_OPENVZ
    case CTID: xSnprintf(buffer, n, "%-8s ", lp->ctid ? lp->ctid : ""); break;
    case VPID: xSnprintf(buffer, n, "%*d ", Process_pidDigits, lp->vpid); break;
@@ -315,6 +447,12 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
       }
       break;
    }
+   #ifdef HAVE_BPF
+   case RUNQ_P50: LinuxProcess_printLatency(str, lp->runq_p50, coloring); return;
+   case RUNQ_P99: LinuxProcess_printLatency(str, lp->runq_p99, coloring); return;
+   case OFFCPU_P50: LinuxProcess_printLatency(str, lp->offcpu_p50, coloring); return;
+   case OFFCPU_P99: LinuxProcess_printLatency(str, lp->offcpu_p99, coloring); return;
+   #endif
    #ifdef HAVE_DELAYACCT
    case PERCENT_CPU_DELAY: Row_printPercentage(lp->cpu_delay_percent, buffer, n, 5, &attr); break;
    case PERCENT_IO_DELAY: Row_printPercentage(lp->blkio_delay_percent, buffer, n, 5, &attr); break;
@@ -437,6 +575,16 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NULLSTR(p1->container_short, p2->container_short);
    case OOM:
       return SPACESHIP_NUMBER(p1->oom, p2->oom);
+   #ifdef HAVE_BPF
+   case RUNQ_P50:
+      return compareRealNumbers(p1->runq_p50, p2->runq_p50);
+   case RUNQ_P99:
+      return compareRealNumbers(p1->runq_p99, p2->runq_p99);
+   case OFFCPU_P50:
+      return compareRealNumbers(p1->offcpu_p50, p2->offcpu_p50);
+   case OFFCPU_P99:
+      return compareRealNumbers(p1->offcpu_p99, p2->offcpu_p99);
+   #endif
    #ifdef HAVE_DELAYACCT
    case PERCENT_CPU_DELAY:
       return compareRealNumbers(p1->cpu_delay_percent, p2->cpu_delay_percent);
@@ -466,6 +614,43 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NUMBER(p1->gpu_time, p2->gpu_time);
    case ISCONTAINER:
       return SPACESHIP_NUMBER(v1->isRunningInContainer, v2->isRunningInContainer);
+   case PERCENT_RUNQ_WAIT:
+      return compareRealNumbers(p1->sched_wait_percent, p2->sched_wait_percent);
+   case TIMESLICE_RATE:
+      return compareRealNumbers(p1->sched_timeslice_rate, p2->sched_timeslice_rate);
+   /* the sparklines sort by their newest sample */
+   case PERCENT_CPU_HISTORY:
+      return compareRealNumbers(p1->super.percent_cpu, p2->super.percent_cpu);
+   case M_RESIDENT_HISTORY:
+      return SPACESHIP_NUMBER(p1->super.m_resident, p2->super.m_resident);
+   case IO_RATE_HISTORY:
+      return compareRealNumbers(LinuxProcess_totalIORate(p1), LinuxProcess_totalIORate(p2));
+   case NET_NS:
+      return SPACESHIP_NUMBER(p1->net_ns, p2->net_ns);
+   case NET_NS_RX_RATE:
+      return compareRealNumbers(p1->netns_rx_rate, p2->netns_rx_rate);
+   case NET_NS_TX_RATE:
+      return compareRealNumbers(p1->netns_tx_rate, p2->netns_tx_rate);
+   case NUMA_NODE:
+      return SPACESHIP_NUMBER(p1->numa_node, p2->numa_node);
+   case PERCENT_NUMA_REMOTE:
+      return compareRealNumbers(p1->percent_numa_remote, p2->percent_numa_remote);
+   case M_USS:
+      return compareRealNumbers(p1->m_uss, p2->m_uss);
+   case M_USS_ERROR:
+      return compareRealNumbers(p1->m_uss_error, p2->m_uss_error);
+   case M_WSS:
+      return compareRealNumbers(p1->m_wss, p2->m_wss);
+   case PERF_IPC:
+      return compareRealNumbers(PerfCounters_ratio(p1->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES),
+                                PerfCounters_ratio(p2->perf_rates, PERF_EVENT_INSTRUCTIONS, PERF_EVENT_CYCLES));
+   case PERF_CACHE_MISS:
+      return compareRealNumbers(PerfCounters_ratio(p1->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES),
+                                PerfCounters_ratio(p2->perf_rates, PERF_EVENT_CACHE_MISSES, PERF_EVENT_CACHE_REFERENCES));
+   case PERF_CSW_RATE:
+      return compareRealNumbers(p1->perf_rates[PERF_EVENT_CONTEXT_SWITCHES], p2->perf_rates[PERF_EVENT_CONTEXT_SWITCHES]);
+   case PERF_FAULT_RATE:
+      return compareRealNumbers(p1->perf_rates[PERF_EVENT_PAGE_FAULTS], p2->perf_rates[PERF_EVENT_PAGE_FAULTS]);
    default:
       return Process_compareByKey_Base(v1, v2, key);
    }
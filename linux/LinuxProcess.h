@@ -9,6 +9,8 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
 
 #include "Machine.h"
 #include "Object.h"
@@ -16,6 +18,8 @@ in the source distribution for its full text.
 #include "Row.h"
 
 #include "linux/IOPriority.h"
+#include "linux/PerfCounters.h"
+#include "linux/WorkingSet.h"
 
 
 #define PROCESS_FLAG_LINUX_IOPRIO    0x00000100
@@ -27,10 +31,21 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_CTXT      0x00004000
 #define PROCESS_FLAG_LINUX_SECATTR   0x00008000
 #define PROCESS_FLAG_LINUX_LRS_FIX   0x00010000
+#define PROCESS_FLAG_LINUX_SCHEDSTAT 0x00020000
 #define PROCESS_FLAG_LINUX_DELAYACCT 0x00040000
 #define PROCESS_FLAG_LINUX_AUTOGROUP 0x00080000
 #define PROCESS_FLAG_LINUX_GPU       0x00100000
 #define PROCESS_FLAG_LINUX_CONTAINER 0x00200000
+#define PROCESS_FLAG_LINUX_HISTORY   0x00400000
+#define PROCESS_FLAG_LINUX_NETNS     0x00800000
+#define PROCESS_FLAG_LINUX_NUMA      0x01000000
+#define PROCESS_FLAG_LINUX_USS       0x02000000
+#define PROCESS_FLAG_LINUX_WSS       0x04000000
+#define PROCESS_FLAG_LINUX_PERF      0x08000000
+#define PROCESS_FLAG_LINUX_SCHEDLAT  0x10000000
+
+/* Data that is only displayed; read for rows near the viewport unless sorted by */
+#define PROCESS_FLAG_LINUX_DISPLAY_ONLY (PROCESS_FLAG_CWD | PROCESS_FLAG_LINUX_CGROUP | PROCESS_FLAG_LINUX_OOM | PROCESS_FLAG_LINUX_SECATTR | PROCESS_FLAG_LINUX_LRS_FIX | PROCESS_FLAG_LINUX_NUMA | PROCESS_FLAG_LINUX_USS | PROCESS_FLAG_LINUX_WSS)
 
 typedef struct LinuxProcess_ {
    Process super;
@@ -118,6 +133,66 @@ typedef struct LinuxProcess_ {
    /* Autogroup scheduling (CFS) information */
    long int autogroup_id;
    int autogroup_nice;
+
+   /* Time spent waiting on a run queue (in nanoseconds, summed over all threads of a process) */
+   unsigned long long int sched_wait_ns;
+   /* Number of timeslices run on a CPU (summed over all threads of a process) */
+   unsigned long long int sched_timeslices;
+   /* Sums of the above over the threads scanned so far, collected before their process is read */
+   unsigned long long int sched_threads_wait_ns;
+   unsigned long long int sched_threads_timeslices;
+   /* Point in time of last schedstat scan (in milliseconds elapsed since the Epoch) */
+   unsigned long long int sched_last_scan_time_ms;
+   /* Percentage of wall-clock time spent waiting on a run queue since last scan */
+   float sched_wait_percent;
+   /* Timeslices per second since last scan */
+   double sched_timeslice_rate;
+
+   /* Inode of the network namespace (ns/net), 0 if unknown */
+   ino_t net_ns;
+   /* Traffic of the network namespace, summed over its interfaces but the loopback (in bytes per second) */
+   double netns_rx_rate;
+   double netns_tx_rate;
+
+   /* Resident memory on each NUMA node from numa_maps (in kB, indexed by node id), NULL until read */
+   unsigned long long int* numa_kb;
+   /* Point in time of the last numa_maps read (in milliseconds elapsed since the Epoch) and the CPU time back then */
+   uint64_t numa_last_scan_ms;
+   unsigned long long int numa_last_time;
+   /* Node holding most of the resident memory, -1 if unknown */
+   int numa_node;
+   /* Percentage of the resident memory outside the node of the CPU last run on */
+   float percent_numa_remote;
+   /* Last run on a CPU of another node than numa_node */
+   bool numa_off_node;
+
+   /* Unique set size estimated from a sample of pages and the half-width of its confidence interval (in kB), NAN if unknown */
+   double m_uss;
+   double m_uss_error;
+   /* Point in time of the last pagemap sample (in milliseconds elapsed since the Epoch) and the CPU time back then */
+   uint64_t uss_last_scan_ms;
+   unsigned long long int uss_last_time;
+
+   /* Resident memory accessed within the last completed window (in kB), NAN if unknown */
+   double m_wss;
+   /* Progress of the idle page tracking towards the next window */
+   WorkingSetScan wss_scan;
+   /* cgroup v2 path at the end of the last window, to roll the working set up by cgroup */
+   char* wss_cgroup;
+
+   /* Performance counter events per second, summed over the counted tasks of a process, NAN if not counted */
+   double perf_rates[PERF_EVENT_COUNT];
+
+   #ifdef HAVE_BPF
+   /* Percentiles of the run queue delay and off-CPU time of the thread group since the last refresh (in nanoseconds), NAN if unknown */
+   double runq_p50;
+   double runq_p99;
+   double offcpu_p50;
+   double offcpu_p99;
+   #endif
+
+   /* Whether the task/ directory was enumerated in the last scan */
+   bool threadsScanned;
 } LinuxProcess;
 
 extern int pageSize;
@@ -130,6 +205,12 @@ extern const ProcessClass LinuxProcess_class;
 
 Process* LinuxProcess_new(const Machine* host);
 
+/* Accounts the cached strings of the automatically sized columns in flags to their widths */
+void LinuxProcess_updateFieldWidths(const LinuxProcess* this, uint32_t flags);
+
+/* Samples the sparkline columns, or frees their history when disabled */
+void LinuxProcess_updateHistory(LinuxProcess* this, bool enabled);
+
 void Process_delete(Object* cast);
 
 IOPriority LinuxProcess_updateIOPriority(Process* proc);
@@ -40,15 +40,27 @@ in the source distribution for its full text.
 #include "UsersTable.h"
 #include "XUtils.h"
 #include "linux/CGroupUtils.h"
+#include "linux/DataSource.h"
 #include "linux/GPU.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
+#include "linux/NetNamespace.h"
+#include "linux/PageSampler.h"
+#include "linux/PerfCounters.h"
+#include "linux/ProcessMaps.h"
+#include "linux/ScanBudget.h"
+#include "linux/WorkingSet.h"
 #include "linux/Platform.h" // needed for GNU/hurd to get PATH_MAX  // IWYU pragma: keep
+#include "linux/Snapshot.h"
 
 #ifdef HAVE_DELAYACCT
 #include "linux/LibNl.h"
 #endif
 
+#ifdef HAVE_BPF
+#include "linux/LibBpf.h"
+#endif
+
 #if defined(MAJOR_IN_MKDEV)
 #include <sys/mkdev.h>
 #elif defined(MAJOR_IN_SYSMACROS)
@@ -162,8 +174,9 @@ static int sortTtyDrivers(const void* va, const void* vb) {
 static void LinuxProcessTable_initTtyDrivers(LinuxProcessTable* this) {
    TtyDriver* ttyDrivers;
 
+   char driversPath[PATH_MAX];
    char buf[16384];
-   ssize_t r = xReadfile(PROCTTYDRIVERSFILE, buf, sizeof(buf));
+   ssize_t r = xReadfile(LinuxMachine_procPath(driversPath, sizeof(driversPath), PROCTTYDRIVERSFILE), buf, sizeof(buf));
    if (r < 0)
       return;
 
@@ -237,22 +250,129 @@ finish:
    this->ttyDrivers = ttyDrivers;
 }
 
+/* Same 32 bit encoding the kernel uses for tty_nr in /proc/<pid>/stat */
+static inline unsigned int LinuxProcessTable_ttyKey(unsigned int maj, unsigned int min) {
+   return (min & 0xff) | (maj << 8) | ((min & ~0xffU) << 12);
+}
+
+static bool LinuxProcessTable_isTtyMajor(const TtyDriver* ttyDrivers, unsigned int maj) {
+   for (int i = 0; ttyDrivers[i].path; i++) {
+      if (ttyDrivers[i].major == maj)
+         return true;
+   }
+   return false;
+}
+
+static void LinuxProcessTable_scanTtyDir(LinuxProcessTable* this, const char* dirPath) {
+   DIR* dir = opendir(dirPath);
+   if (!dir)
+      return;
+
+   int dfd = dirfd(dir);
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] == '.')
+         continue;
+
+      #ifdef _DIRENT_HAVE_D_TYPE
+      if (entry->d_type != DT_CHR && entry->d_type != DT_UNKNOWN)
+         continue;
+      #endif
+
+      struct stat sb;
+      if (fstatat(dfd, entry->d_name, &sb, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISCHR(sb.st_mode))
+         continue;
+
+      unsigned int maj = major(sb.st_rdev);
+      if (!LinuxProcessTable_isTtyMajor(this->ttyDrivers, maj))
+         continue;
+
+      /* first name wins, the driver directories are scanned before /dev */
+      unsigned int key = LinuxProcessTable_ttyKey(maj, minor(sb.st_rdev));
+      if (Hashtable_get(this->ttyNames, key))
+         continue;
+
+      char* path = NULL;
+      xAsprintf(&path, "%s/%s", dirPath, entry->d_name);
+      Hashtable_put(this->ttyNames, key, path);
+   }
+
+   closedir(dir);
+}
+
+/*
+ * Index all tty device nodes once, so resolving a tty_nr does not need any
+ * stat(2) probing.  Devices created later are resolved by probing on first
+ * use and then added to the index.
+ */
+static void LinuxProcessTable_initTtyNames(LinuxProcessTable* this) {
+   this->ttyNames = Hashtable_new(64, true);
+   if (!this->ttyDrivers)
+      return;
+
+   for (int i = 0; this->ttyDrivers[i].path; i++) {
+      const char* path = this->ttyDrivers[i].path;
+
+      /* skip drivers sharing a directory with a previous one */
+      bool seen = false;
+      for (int j = 0; j < i && !seen; j++)
+         seen = String_eq(this->ttyDrivers[j].path, path);
+
+      struct stat sb;
+      if (!seen && stat(path, &sb) == 0 && S_ISDIR(sb.st_mode))
+         LinuxProcessTable_scanTtyDir(this, path);
+   }
+
+   LinuxProcessTable_scanTtyDir(this, "/dev");
+}
+
+static bool LinuxProcessTable_revealEntries(Table* super);
+
+static const TableClass LinuxProcessTable_class = {
+   .super = {
+      .extends = Class(ProcessTable),
+      .delete = ProcessTable_delete,
+   },
+   .prepare = ProcessTable_prepareEntries,
+   .iterate = ProcessTable_iterateEntries,
+   .cleanup = ProcessTable_cleanupEntries,
+   .reveal = LinuxProcessTable_revealEntries,
+};
+
+/*
+ * The numa_maps reads, USS samples and working set walks of a refresh
+ * together stop after SCAN_BUDGET_MS spent in them; the processes left over
+ * keep their previous values and are due first in the following refreshes.
+ */
+#define SCAN_BUDGET_MS 20
+
 ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
    LinuxProcessTable* this = xCalloc(1, sizeof(LinuxProcessTable));
-   Object_setClass(this, Class(ProcessTable));
+   Object_setClass(this, &LinuxProcessTable_class);
 
    ProcessTable* super = &this->super;
    ProcessTable_init(super, Class(LinuxProcess), host, pidMatchList);
 
    LinuxProcessTable_initTtyDrivers(this);
+   LinuxProcessTable_initTtyNames(this);
+   NetNamespaces_init(&this->netNamespaces);
+   this->numaMapsSize = 16384;
+   this->numaMapsBuffer = xMalloc(this->numaMapsSize);
+   ProcessMaps_init(&this->maps);
+   PageSampler_init(&this->pageSampler, (size_t) ((const LinuxMachine*) host)->pageSize);
+   WorkingSet_init(&this->workingSet);
+   ScanBudget_init(&this->scanBudget, SCAN_BUDGET_MS);
+   PerfCounters_init(&this->perfCounters);
+
+   char path[PATH_MAX];
 
    // Test /proc/PID/smaps_rollup availability (faster to parse, Linux 4.14+)
-   this->haveSmapsRollup = (access(PROCDIR "/self/smaps_rollup", R_OK) == 0);
+   this->haveSmapsRollup = (access(LinuxMachine_procPath(path, sizeof(path), "/self/smaps_rollup"), R_OK) == 0);
 
    // Read PID namespace inode number
    {
       struct stat sb;
-      int r = stat(PROCDIR "/self/ns/pid", &sb);
+      int r = stat(LinuxMachine_procPath(path, sizeof(path), "/self/ns/pid"), &sb);
       if (r == 0) {
          rootPidNs = sb.st_ino;
       } else {
@@ -272,9 +392,19 @@ void ProcessTable_delete(Object* cast) {
       }
       free(this->ttyDrivers);
    }
+   Hashtable_delete(this->ttyNames);
+   NetNamespaces_done(&this->netNamespaces);
+   free(this->numaMapsBuffer);
+   ProcessMaps_done(&this->maps);
+   PageSampler_done(&this->pageSampler);
+   WorkingSet_done(&this->workingSet);
+   PerfCounters_done(&this->perfCounters);
    #ifdef HAVE_DELAYACCT
    LibNl_destroyNetlinkSocket(this);
    #endif
+   #ifdef HAVE_BPF
+   LibBpf_destroySchedLatency(this);
+   #endif
    free(this);
 }
 
@@ -620,7 +750,7 @@ static bool LinuxProcessTable_updateUser(const Machine* host, Process* process,
    if (statok == -1)
       return false;
 
-   if (process->st_uid != sb.st_uid) {
+   if (process->st_uid != sb.st_uid || !process->user) {
       process->st_uid = sb.st_uid;
       process->user = UsersTable_getRef(host->usersTable, sb.st_uid);
    }
@@ -698,139 +828,64 @@ static void LinuxProcessTable_readIoFile(LinuxProcess* lp, openat_arg_t procFd,
    lp->io_last_scan_time_ms = host->realtimeMs;
 }
 
-typedef struct LibraryData_ {
-   uint64_t size;
-   bool exec;
-} LibraryData;
-
-static void LinuxProcessTable_calcLibSize_helper(ATTR_UNUSED ht_key_t key, void* value, void* data) {
-   if (!data)
+/*
+ * Read /proc/<pid>/schedstat (thread-specific data)
+ *
+ * Threads are scanned before their process, so their counters are also added
+ * to the process (mainTask), whose own file only covers the main thread.
+ */
+static void LinuxProcessTable_readSchedstatFile(LinuxProcess* lp, openat_arg_t procFd, LinuxProcess* mainTask) {
+   const Machine* host = lp->super.super.host;
+   char buffer[PROC_LINE_LENGTH + 1];
+
+   unsigned long long int runTime, waitTime, timeslices;
+   ssize_t r = xReadfileat(procFd, "schedstat", buffer, sizeof(buffer));
+   if (r <= 0 || sscanf(buffer, "%llu %llu %llu", &runTime, &waitTime, &timeslices) != 3) {
+      lp->sched_wait_percent = NAN;
+      lp->sched_timeslice_rate = NAN;
+      lp->sched_last_scan_time_ms = host->realtimeMs;
       return;
+   }
 
-   if (!value)
-      return;
+   if (mainTask) {
+      mainTask->sched_threads_wait_ns += waitTime;
+      mainTask->sched_threads_timeslices += timeslices;
+   } else {
+      waitTime += lp->sched_threads_wait_ns;
+      timeslices += lp->sched_threads_timeslices;
+   }
 
-   const LibraryData* v = (const LibraryData*)value;
-   uint64_t* d = (uint64_t*)data;
-   if (!v->exec)
-      return;
+   unsigned long long time_delta = saturatingSub(host->realtimeMs, lp->sched_last_scan_time_ms);
+   if (time_delta && lp->sched_last_scan_time_ms) {
+      /* nanoseconds waited per millisecond elapsed, as percentage */
+      lp->sched_wait_percent = saturatingSub(waitTime, lp->sched_wait_ns) / (double)time_delta / 10000.0;
+      lp->sched_timeslice_rate = saturatingSub(timeslices, lp->sched_timeslices) * /*ms to s*/1000. / time_delta;
+   } else {
+      lp->sched_wait_percent = NAN;
+      lp->sched_timeslice_rate = NAN;
+   }
 
-   *d += v->size;
+   lp->sched_wait_ns = waitTime;
+   lp->sched_timeslices = timeslices;
+   lp->sched_last_scan_time_ms = host->realtimeMs;
 }
 
 /*
  * Read /proc/<pid>/maps (process-shared data)
  */
-static void LinuxProcessTable_readMaps(LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, bool calcSize, bool checkDeletedLib) {
+static void LinuxProcessTable_readMaps(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* host, bool calcSize, bool checkDeletedLib) {
    Process* proc = (Process*)process;
 
-   proc->usesDeletedLib = false;
-
-   FILE* mapsfile = fopenat(procFd, "maps", "r");
-   if (!mapsfile)
+   ProcessMapsInfo info;
+   if (!ProcessMaps_read(&this->maps, procFd, host->super.monotonicMs, &info)) {
+      proc->usesDeletedLib = false;
       return;
-
-   Hashtable* ht = NULL;
-   if (calcSize)
-      ht = Hashtable_new(64, true);
-
-   char buffer[1024];
-   while (fgets(buffer, sizeof(buffer), mapsfile)) {
-      uint64_t map_start;
-      uint64_t map_end;
-      bool map_execute;
-      unsigned int map_devmaj;
-      unsigned int map_devmin;
-      uint64_t map_inode;
-
-      // Short circuit test: Look for a slash
-      if (!strchr(buffer, '/'))
-         continue;
-
-      // Parse format: "%Lx-%Lx %4s %x %2x:%2x %Ld"
-      char* readptr = buffer;
-
-      map_start = fast_strtoull_hex(&readptr, 16);
-      if ('-' != *readptr++)
-         continue;
-
-      map_end = fast_strtoull_hex(&readptr, 16);
-      if (' ' != *readptr++)
-         continue;
-
-      if (!readptr[0] || !readptr[1] || !readptr[2] || !readptr[3])
-         continue;
-
-      map_execute = (readptr[2] == 'x');
-      readptr += 4;
-      if (' ' != *readptr++)
-         continue;
-
-      while (*readptr > ' ')
-         readptr++; // Skip parsing this hex value
-      if (' ' != *readptr++)
-         continue;
-
-      map_devmaj = fast_strtoull_hex(&readptr, 4);
-      if (':' != *readptr++)
-         continue;
-
-      map_devmin = fast_strtoull_hex(&readptr, 4);
-      if (' ' != *readptr++)
-         continue;
-
-      //Minor shortcut: Once we know there's no file for this region, we skip
-      if (!map_devmaj && !map_devmin)
-         continue;
-
-      map_inode = fast_strtoull_dec(&readptr, 0);
-      if (!map_inode)
-         continue;
-
-      if (calcSize) {
-         LibraryData* libdata = Hashtable_get(ht, map_inode);
-         if (!libdata) {
-            libdata = xCalloc(1, sizeof(LibraryData));
-            Hashtable_put(ht, map_inode, libdata);
-         }
-
-         libdata->size += map_end - map_start;
-         libdata->exec |= map_execute;
-      }
-
-      if (checkDeletedLib && map_execute && !proc->usesDeletedLib) {
-         while (*readptr == ' ')
-            readptr++;
-
-         if (*readptr != '/')
-            continue;
-
-         if (String_startsWith(readptr, "/memfd:"))
-            continue;
-
-         /* Virtualbox maps /dev/zero for memory allocation. That results in
-          * false positive, so ignore. */
-         if (String_eq(readptr, "/dev/zero (deleted)\n"))
-            continue;
-
-         if (strstr(readptr, " (deleted)\n")) {
-            proc->usesDeletedLib = true;
-            if (!calcSize)
-               break;
-         }
-      }
    }
 
-   fclose(mapsfile);
-
-   if (calcSize) {
-      uint64_t total_size = 0;
-      Hashtable_foreach(ht, LinuxProcessTable_calcLibSize_helper, &total_size);
-
-      Hashtable_delete(ht);
+   proc->usesDeletedLib = checkDeletedLib && info.usesDeletedLib;
 
-      process->m_lrs = total_size / host->pageSize;
-   }
+   if (calcSize)
+      process->m_lrs = info.libSize / host->pageSize;
 }
 
 /*
@@ -911,7 +966,8 @@ static bool LinuxProcessTable_readSmapsFile(LinuxProcess* process, openat_arg_t
 #ifdef HAVE_OPENVZ
 
 static void LinuxProcessTable_readOpenVZData(LinuxProcess* process, openat_arg_t procFd) {
-   if (access(PROCDIR "/vz", R_OK) != 0) {
+   char path[PATH_MAX];
+   if (access(LinuxMachine_procPath(path, sizeof(path), "/vz"), R_OK) != 0) {
       free(process->ctid);
       process->ctid = NULL;
       process->vpid = Process_getPid(&process->super);
@@ -1181,6 +1237,336 @@ static void LinuxProcessTable_readSecattrData(LinuxProcess* process, openat_arg_
    free_and_xStrdup(&process->secattr, buffer);
 }
 
+/*
+ * Read /proc/<pid>/ns/net (process-shared data)
+ */
+static void LinuxProcessTable_readNetNamespace(LinuxProcess* process, openat_arg_t procFd) {
+   struct stat sb;
+#if defined(HAVE_OPENAT) && defined(HAVE_FSTATAT)
+   int res = fstatat(procFd, "ns/net", &sb, 0);
+#else
+   char path[PATH_MAX];
+   xSnprintf(path, sizeof(path), "%s/ns/net", procFd);
+   int res = stat(path, &sb);
+#endif
+   /* not permitted for processes of other users unless privileged */
+   process->net_ns = res == 0 ? sb.st_ino : 0;
+}
+
+/* Hands the interface rates of each namespace to the processes in it */
+static void LinuxProcessTable_updateNetNamespaces(LinuxProcessTable* this) {
+   Table* table = &this->super.super;
+
+   NetNamespaces_update(&this->netNamespaces, table->host);
+
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(table->rows, i);
+      const NetNamespace* ns = lp->net_ns ? NetNamespaces_get(&this->netNamespaces, lp->net_ns) : NULL;
+      lp->netns_rx_rate = ns ? ns->rx_rate : NAN;
+      lp->netns_tx_rate = ns ? ns->tx_rate : NAN;
+   }
+}
+
+/* Tasks of a process counted at most, as each holds a file descriptor per event */
+#define PERF_MAX_TASKS 64
+
+static int LinuxProcessTable_compareByCpu(const void* v1, const void* v2) {
+   const Process* p1 = *(const Process* const*) v1;
+   const Process* p2 = *(const Process* const*) v2;
+   return compareRealNumbers(p2->percent_cpu, p1->percent_cpu);
+}
+
+/* Attaches counters to the tasks of a process, listed from its task/ directory */
+static void LinuxProcessTable_attachPerfTasks(LinuxProcessTable* this, const LinuxProcess* process) {
+   pid_t pid = Process_getPid(&process->super);
+   char path[PATH_MAX];
+   DIR* dir = opendir(LinuxMachine_procPath(path, sizeof(path), "/%d/task", pid));
+   if (!dir)
+      return;
+
+   unsigned int attached = 0;
+   const struct dirent* entry;
+   while (attached < PERF_MAX_TASKS && (entry = readdir(dir)) != NULL) {
+      char* end;
+      unsigned long tid = strtoul(entry->d_name, &end, 10);
+      if (entry->d_name[0] < '0' || entry->d_name[0] > '9' || *end != '\0')
+         continue;
+
+      if (PerfCounters_attachTask(&this->perfCounters, (pid_t) tid, pid))
+         attached++;
+      else if (this->perfCounters.exhausted)
+         break;
+   }
+   closedir(dir);
+}
+
+/*
+ * Counts events for the processes with the highest CPU usage only, then
+ * hands the rates of each task to its row and their sums to its process.
+ */
+static void LinuxProcessTable_updatePerfCounters(LinuxProcessTable* this) {
+   Table* table = &this->super.super;
+   const Machine* host = table->host;
+   size_t limit = (size_t) host->settings->perfTopProcesses;
+
+   const LinuxProcess** candidates = xMallocArray((size_t) MAXIMUM(Vector_size(table->rows), 1), sizeof(*candidates));
+   size_t nCandidates = 0;
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(table->rows, i);
+      for (size_t e = 0; e < PERF_EVENT_COUNT; e++)
+         lp->perf_rates[e] = NAN;
+
+      const Process* proc = &lp->super;
+      if (proc->super.updated && !Process_isUserlandThread(proc) && !Process_isKernelThread(proc))
+         candidates[nCandidates++] = lp;
+   }
+   qsort(candidates, nCandidates, sizeof(*candidates), LinuxProcessTable_compareByCpu);
+
+   PerfCounters_begin(&this->perfCounters);
+   for (size_t i = 0; i < MINIMUM(nCandidates, limit); i++)
+      LinuxProcessTable_attachPerfTasks(this, candidates[i]);
+   PerfCounters_end(&this->perfCounters, host->monotonicMs);
+   free(candidates);
+
+   for (size_t i = 0; i < this->perfCounters.nTargets; i++) {
+      const PerfTarget* target = this->perfCounters.list[i];
+      LinuxProcess* owner = (LinuxProcess*) Table_findRow(table, (int) target->owner);
+      LinuxProcess* task = target->key != target->owner ? (LinuxProcess*) Table_findRow(table, (int) target->key) : NULL;
+
+      for (size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+         double rate = target->rates[e];
+         if (isnan(rate))
+            continue;
+
+         if (owner)
+            owner->perf_rates[e] = isnan(owner->perf_rates[e]) ? rate : owner->perf_rates[e] + rate;
+         if (task)
+            task->perf_rates[e] = rate;
+      }
+   }
+}
+
+/*
+ * numa_maps walks the page tables of the process, so it is re-read at most
+ * every NUMA_MAPS_MIN_AGE_MS while the process runs and after
+ * NUMA_MAPS_MAX_AGE_MS otherwise, as pages hardly move while it sleeps.
+ */
+#define NUMA_MAPS_MIN_AGE_MS 5000
+#define NUMA_MAPS_MAX_AGE_MS 60000
+
+/* The USS estimate probes pagemap under the same policy */
+#define USS_MIN_AGE_MS 5000
+#define USS_MAX_AGE_MS 60000
+
+static bool LinuxProcessTable_rescanDue(const LinuxProcess* process, uint64_t lastScanMs, unsigned long long lastTime, uint64_t minAge, uint64_t maxAge, uint64_t now) {
+   if (lastScanMs == 0)
+      return true;
+
+   /* spread the re-reads of processes started together over several scans */
+   uint64_t age = now - lastScanMs;
+   uint64_t jitter = (uint64_t)(Process_getPid(&process->super) % 8) * 250;
+   if (age >= maxAge + jitter)
+      return true;
+
+   return age >= minAge + jitter && process->utime + process->stime != lastTime;
+}
+
+static bool LinuxProcessTable_numaMapsDue(const LinuxProcess* process, uint64_t now) {
+   return LinuxProcessTable_rescanDue(process, process->numa_last_scan_ms, process->numa_last_time, NUMA_MAPS_MIN_AGE_MS, NUMA_MAPS_MAX_AGE_MS, now);
+}
+
+static bool LinuxProcessTable_ussDue(const LinuxProcess* process, uint64_t now) {
+   return LinuxProcessTable_rescanDue(process, process->uss_last_scan_ms, process->uss_last_time, USS_MIN_AGE_MS, USS_MAX_AGE_MS, now);
+}
+
+/*
+ * Estimate the USS from /proc/<pid>/pagemap (process-shared data); false if
+ * the budget ran out first, leaving the previous estimate
+ */
+static bool LinuxProcessTable_sampleUss(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* lhost) {
+   const Settings* settings = lhost->super.settings;
+
+   size_t length;
+   const char* maps = ProcessMaps_load(&this->maps, procFd, &length);
+   unsigned long long resident = (unsigned long long) process->super.m_resident / lhost->pageSizeKB;
+
+   PageSample sample;
+   PageSampleStatus status = PAGE_SAMPLE_FAILED;
+   if (maps)
+      status = PageSampler_sample(&this->pageSampler, &this->scanBudget, procFd, maps, length, resident,
+                                  (unsigned int) settings->ussSamplePages, (unsigned int) settings->ussConfidence, &sample);
+
+   switch (status) {
+   case PAGE_SAMPLE_DONE:
+      process->m_uss = sample.uss * lhost->pageSizeKB;
+      process->m_uss_error = sample.error * lhost->pageSizeKB;
+      break;
+   case PAGE_SAMPLE_TRUNCATED:
+      return false;
+   case PAGE_SAMPLE_FAILED:
+      process->m_uss = NAN;
+      process->m_uss_error = NAN;
+      break;
+   }
+
+   return true;
+}
+
+/* Remembers the cgroup v2 path of a process, from the "0::" line of /proc/<pid>/cgroup */
+static void LinuxProcessTable_readWorkingSetCGroup(LinuxProcess* process, openat_arg_t procFd) {
+   char buffer[PROC_LINE_LENGTH + 1];
+   ssize_t r = xReadfileat(procFd, "cgroup", buffer, sizeof(buffer));
+   const char* path = NULL;
+   char* line = buffer;
+   while (r > 0 && !path) {
+      char* eol = String_strchrnul(line, '\n');
+      bool more = *eol != '\0';
+      *eol = '\0';
+      if (String_startsWith(line, "0::"))
+         path = line + 3;
+      else if (!more)
+         break;
+      line = eol + 1;
+   }
+
+   if (!path) {
+      free(process->wss_cgroup);
+      process->wss_cgroup = NULL;
+      return;
+   }
+
+   if (!process->wss_cgroup || !String_eq(process->wss_cgroup, path))
+      free_and_xStrdup(&process->wss_cgroup, path);
+}
+
+/*
+ * Advance the working set estimate by idle page tracking (process-shared data)
+ */
+static void LinuxProcessTable_trackWorkingSet(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* lhost) {
+   const Machine* host = &lhost->super;
+   uint64_t windowMs = (uint64_t) host->settings->wssWindow * 1000;
+
+   if (!WorkingSet_available(&this->workingSet)) {
+      process->m_wss = NAN;
+      return;
+   }
+
+   if (WorkingSet_waiting(&process->wss_scan, host->monotonicMs, windowMs))
+      return;
+
+   if (!ScanBudget_begin(&this->scanBudget, host->monotonicMs))
+      return;
+
+   size_t length;
+   const char* maps = ProcessMaps_load(&this->maps, procFd, &length);
+   if (!maps) {
+      ScanBudget_end(&this->scanBudget);
+      process->m_wss = NAN;
+      return;
+   }
+
+   unsigned long long pages;
+   WorkingSetStatus status = WorkingSet_advance(&this->workingSet, &this->scanBudget, &process->wss_scan, procFd, maps, length, (size_t) lhost->pageSize, host->monotonicMs, windowMs, &pages);
+   ScanBudget_end(&this->scanBudget);
+
+   switch (status) {
+   case WORKING_SET_DONE:
+      process->m_wss = (double) pages * lhost->pageSizeKB;
+      LinuxProcessTable_readWorkingSetCGroup(process, procFd);
+      break;
+   case WORKING_SET_FAILED:
+      process->m_wss = NAN;
+      break;
+   case WORKING_SET_PENDING:
+      break;
+   }
+}
+
+/*
+ * Read /proc/<pid>/numa_maps (process-shared data), the resident pages of each mapping by node:
+ * "7f2c4e000000 default file=/usr/lib/libc.so.6 mapped=352 mapmax=61 N0=300 N1=52 kernelpagesize_kB=4"
+ */
+static void LinuxProcessTable_readNumaMaps(LinuxProcessTable* this, LinuxProcess* process, openat_arg_t procFd, const LinuxMachine* lhost) {
+   const char* content = NULL;
+   for (;;) {
+      ssize_t r = xReadfileat(procFd, "numa_maps", this->numaMapsBuffer, this->numaMapsSize);
+      if (r < 0)
+         break;
+      if ((size_t) r < this->numaMapsSize - 1) {
+         content = this->numaMapsBuffer;
+         break;
+      }
+
+      this->numaMapsSize *= 2;
+      this->numaMapsBuffer = xRealloc(this->numaMapsBuffer, this->numaMapsSize);
+   }
+
+   /* not permitted for processes of other users unless privileged */
+   if (!content) {
+      free(process->numa_kb);
+      process->numa_kb = NULL;
+      return;
+   }
+
+   if (!process->numa_kb)
+      process->numa_kb = xMallocArray(lhost->numaNodes, sizeof(*process->numa_kb));
+   memset(process->numa_kb, 0, lhost->numaNodes * sizeof(*process->numa_kb));
+
+   do {
+      const char* line = content;
+      const char* word;
+      size_t len;
+
+      /* huge page mappings count in pages of their own size, given after the nodes */
+      unsigned long long pageKB = lhost->pageSizeKB;
+      while ((len = DataSource_nextWord(&content, &word)) > 0) {
+         if (len > 18 && String_startsWith(word, "kernelpagesize_kB="))
+            pageKB = strtoull(word + 18, NULL, 10);
+      }
+
+      content = line;
+      while ((len = DataSource_nextWord(&content, &word)) > 0) {
+         if (len < 4 || word[0] != 'N' || !isdigit((unsigned char)word[1]))
+            continue;
+
+         char* end;
+         unsigned long node = strtoul(word + 1, &end, 10);
+         if (*end != '=' || node >= lhost->numaNodes)
+            continue;
+
+         process->numa_kb[node] += strtoull(end + 1, NULL, 10) * pageKB;
+      }
+   } while (DataSource_skipLine(&content));
+}
+
+/* Derives the placement columns from the memory by node and the CPU last run on */
+static void LinuxProcessTable_updateNumaPlacement(LinuxProcess* process, const unsigned long long* numa_kb, const LinuxMachine* lhost) {
+   process->numa_node = -1;
+   process->percent_numa_remote = NAN;
+   process->numa_off_node = false;
+
+   if (!numa_kb)
+      return;
+
+   unsigned long long total = 0;
+   int dominant = -1;
+   for (unsigned int i = 0; i < lhost->numaNodes; i++) {
+      total += numa_kb[i];
+      if (numa_kb[i] > 0 && (dominant < 0 || numa_kb[i] > numa_kb[dominant]))
+         dominant = (int)i;
+   }
+
+   if (dominant < 0)
+      return;
+
+   int running = LinuxMachine_cpuNode(lhost, process->super.processor);
+   int local = (running >= 0 && (unsigned int)running < lhost->numaNodes) ? running : dominant;
+
+   process->numa_node = dominant;
+   process->percent_numa_remote = (double)(total - numa_kb[local]) * 100.0 / (double)total;
+   process->numa_off_node = running >= 0 && running != dominant;
+}
+
 /*
  * Read /proc/<pid>/cwd (process-shared data)
  */
@@ -1452,7 +1838,7 @@ static void LinuxProcessList_readComm(Process* process, openat_arg_t procFd) {
    }
 }
 
-static char* LinuxProcessTable_updateTtyDevice(TtyDriver* ttyDrivers, unsigned long int tty_nr) {
+static char* LinuxProcessTable_probeTtyDevice(const TtyDriver* ttyDrivers, unsigned long int tty_nr) {
    unsigned int maj = major(tty_nr);
    unsigned int min = minor(tty_nr);
 
@@ -1504,6 +1890,24 @@ static char* LinuxProcessTable_updateTtyDevice(TtyDriver* ttyDrivers, unsigned l
       }
    }
 
+   return NULL;
+}
+
+static char* LinuxProcessTable_updateTtyDevice(LinuxProcessTable* this, unsigned long int tty_nr) {
+   unsigned int maj = major(tty_nr);
+   unsigned int min = minor(tty_nr);
+   unsigned int key = LinuxProcessTable_ttyKey(maj, min);
+
+   const char* name = Hashtable_get(this->ttyNames, key);
+   if (name)
+      return xStrdup(name);
+
+   char* path = LinuxProcessTable_probeTtyDevice(this->ttyDrivers, tty_nr);
+   if (path) {
+      Hashtable_put(this->ttyNames, key, xStrdup(path));
+      return path;
+   }
+
    char* out = NULL;
    xAsprintf(&out, "/dev/%u:%u", maj, min);
    return out;
@@ -1526,7 +1930,49 @@ static bool isOlderThan(const Process* proc, unsigned int seconds) {
    return realtime - proc->starttime_ctime > seconds;
 }
 
-static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_arg_t parentFd, const LinuxMachine* lhost, const char* dirname, const LinuxProcess* mainTask) {
+/*
+ * The threads of a process only need to be enumerated when their rows can
+ * end up on screen, or when per-thread data is accounted to the process.
+ * Otherwise they are counted from the num_threads field of its stat file.
+ */
+static bool LinuxProcessTable_needsThreads(const LinuxProcess* lp, bool preExisting, bool shown, const Settings* settings) {
+   const ScreenSettings* ss = settings->ss;
+   const Process* proc = &lp->super;
+
+   if (preExisting && Process_isKernelThread(proc))
+      return false;
+   if (preExisting && settings->hideRunningInContainer && proc->isRunningInContainer == TRI_ON)
+      return false;
+   if (ss->flags & PROCESS_FLAG_LINUX_SCHEDSTAT)
+      return true;
+   if (settings->hideUserlandThreads)
+      return false;
+   if (!ss->treeView || !preExisting)
+      return true;
+
+   /* threads are children of their process in tree view */
+   return shown && proc->super.showChildren;
+}
+
+/*
+ * Rows of threads that are no longer enumerated did not go away, so do not
+ * keep them around as dying rows with "highlight new and old processes".
+ */
+static void LinuxProcessTable_dropUnscannedThreads(LinuxProcessTable* this) {
+   Table* table = &this->super.super;
+
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      Row* row = (Row*) Vector_get(table->rows, i);
+      if (row->updated || row->tombStampMs > 0 || !Process_isUserlandThread((const Process*) row))
+         continue;
+
+      const LinuxProcess* mainTask = (const LinuxProcess*) Table_findRow(table, row->group);
+      if (mainTask && mainTask->super.super.updated && !mainTask->threadsScanned)
+         row->wasShown = false;
+   }
+}
+
+static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_arg_t parentFd, const LinuxMachine* lhost, const char* dirname, LinuxProcess* mainTask) {
    ProcessTable* pt = (ProcessTable*) this;
    const Machine* host = &lhost->super;
    const Settings* settings = host->settings;
@@ -1554,6 +2000,14 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
    const bool hideKernelThreads = settings->hideKernelThreads;
    const bool hideUserlandThreads = settings->hideUserlandThreads;
    const bool hideRunningInContainer = settings->hideRunningInContainer;
+   const bool scanNetNamespaces = (ss->flags & PROCESS_FLAG_LINUX_NETNS) || this->netNamespacesWanted;
+
+   /* Display-only data of the sort key is needed for all rows; all of it without a panel (htop-collector) */
+   uint32_t lazyFlags = pt->super.panel ? PROCESS_FLAG_LINUX_DISPLAY_ONLY : 0;
+   RowField sortKey = ScreenSettings_getActiveSortKey(ss);
+   if (sortKey > 0 && sortKey < LAST_PROCESSFIELD)
+      lazyFlags &= ~Process_fields[sortKey].flags;
+
    while ((entry = readdir(dir)) != NULL) {
       const char* name = entry->d_name;
 
@@ -1608,7 +2062,19 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          // As the list of tasks/threads is presented as a flat view in procfs
          // below each directories main entry, it makes no sense to
          // look for further directories that will not be there.
-         LinuxProcessTable_recurseProcTree(this, procFd, lhost, "task", lp);
+         lp->sched_threads_wait_ns = 0;
+         lp->sched_threads_timeslices = 0;
+
+         bool scanThreads = LinuxProcessTable_needsThreads(lp, preExisting, proc->super.wasShown, settings);
+         if (lp->threadsScanned && !scanThreads)
+            this->threadsDropped = true;
+         lp->threadsScanned = scanThreads;
+
+         if (scanThreads)
+            LinuxProcessTable_recurseProcTree(this, procFd, lhost, "task", lp);
+      } else if (ss->flags & PROCESS_FLAG_LINUX_SCHEDSTAT) {
+         // Accounted to the process even if the thread itself is hidden below
+         LinuxProcessTable_readSchedstatFile(lp, procFd, mainTask);
       }
 
       /*
@@ -1642,6 +2108,12 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
       const bool scanMainThread = !hideUserlandThreads && !Process_isKernelThread(proc) && !mainTask;
 
+      /* Rows far from the viewport keep their display-only data of the last read */
+      const bool offscreen = preExisting && !proc->super.inViewport;
+      const uint32_t flags = offscreen ? ss->flags & ~lazyFlags : ss->flags;
+      if (offscreen)
+         LinuxProcess_updateFieldWidths(lp, ss->flags & lazyFlags);
+
       if (!LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask))
          goto errorReadingProcess;
 
@@ -1656,9 +2128,12 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
             uint64_t recheck = ((uint64_t)rand()) % 2048;
 
-            if (passedTimeInMs > recheck) {
+            /* only the M_LRS sizes are display-only, deleted libraries are still highlighted */
+            bool calcSize = (flags & PROCESS_FLAG_LINUX_LRS_FIX) != 0;
+
+            if (passedTimeInMs > recheck && (calcSize || settings->highlightDeletedExe)) {
                lp->last_mlrs_calctime = host->realtimeMs;
-               LinuxProcessTable_readMaps(lp, procFd, lhost, ss->flags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
+               LinuxProcessTable_readMaps(this, lp, procFd, lhost, calcSize, settings->highlightDeletedExe);
             }
          } else {
             /* Copy from process structure in threads and reset if setting got disabled */
@@ -1682,7 +2157,7 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
       if (last_tty_nr != proc->tty_nr && this->ttyDrivers) {
          free(proc->tty_name);
-         proc->tty_name = LinuxProcessTable_updateTtyDevice(this->ttyDrivers, proc->tty_nr);
+         proc->tty_name = LinuxProcessTable_updateTtyDevice(this, proc->tty_nr);
       }
 
       proc->percent_cpu = NAN;
@@ -1774,7 +2249,7 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CGROUP)
+      if (flags & PROCESS_FLAG_LINUX_CGROUP)
          LinuxProcessTable_readCGroupFile(lp, procFd);
 
       if ((ss->flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
@@ -1794,17 +2269,59 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
+      if ((ss->flags & PROCESS_FLAG_LINUX_NUMA) && lhost->numaNodes > 0 && !Process_isKernelThread(proc)) {
+         if (mainTask) {
+            LinuxProcessTable_updateNumaPlacement(lp, mainTask->numa_kb, lhost);
+         } else {
+            if ((flags & PROCESS_FLAG_LINUX_NUMA) && LinuxProcessTable_numaMapsDue(lp, host->realtimeMs) &&
+                ScanBudget_begin(&this->scanBudget, host->monotonicMs)) {
+               LinuxProcessTable_readNumaMaps(this, lp, procFd, lhost);
+               ScanBudget_end(&this->scanBudget);
+               lp->numa_last_scan_ms = host->realtimeMs;
+               lp->numa_last_time = lp->utime + lp->stime;
+            }
+            LinuxProcessTable_updateNumaPlacement(lp, lp->numa_kb, lhost);
+         }
+      }
+
+      if ((ss->flags & PROCESS_FLAG_LINUX_USS) && !Process_isKernelThread(proc)) {
+         if (mainTask) {
+            lp->m_uss = mainTask->m_uss;
+            lp->m_uss_error = mainTask->m_uss_error;
+         } else if ((flags & PROCESS_FLAG_LINUX_USS) && LinuxProcessTable_ussDue(lp, host->realtimeMs) &&
+                    ScanBudget_begin(&this->scanBudget, host->monotonicMs)) {
+            bool sampled = LinuxProcessTable_sampleUss(this, lp, procFd, lhost);
+            ScanBudget_end(&this->scanBudget);
+            if (sampled) {
+               lp->uss_last_scan_ms = host->realtimeMs;
+               lp->uss_last_time = lp->utime + lp->stime;
+            }
+         }
+      }
+
+      if (((ss->flags & PROCESS_FLAG_LINUX_WSS) || this->workingSetWanted) && !Process_isKernelThread(proc)) {
+         if (mainTask) {
+            lp->m_wss = mainTask->m_wss;
+         } else if ((flags & PROCESS_FLAG_LINUX_WSS) || this->workingSetWanted) {
+            LinuxProcessTable_trackWorkingSet(this, lp, procFd, lhost);
+         }
+      }
+
       if (ss->flags & PROCESS_FLAG_IO) {
          LinuxProcessTable_readIoFile(lp, procFd, scanMainThread);
       }
 
+      if (!mainTask && (ss->flags & PROCESS_FLAG_LINUX_SCHEDSTAT)) {
+         LinuxProcessTable_readSchedstatFile(lp, procFd, NULL);
+      }
+
       #ifdef HAVE_DELAYACCT
       if (ss->flags & PROCESS_FLAG_LINUX_DELAYACCT) {
          LibNl_readDelayAcctData(this, lp);
       }
       #endif
 
-      if (ss->flags & PROCESS_FLAG_LINUX_OOM) {
+      if (flags & PROCESS_FLAG_LINUX_OOM) {
          LinuxProcessTable_readOomData(lp, procFd, mainTask);
       }
 
@@ -1812,11 +2329,11 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          LinuxProcess_updateIOPriority(proc);
       }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_SECATTR) {
+      if (flags & PROCESS_FLAG_LINUX_SECATTR) {
          LinuxProcessTable_readSecattrData(lp, procFd, mainTask);
       }
 
-      if (ss->flags & PROCESS_FLAG_CWD) {
+      if (flags & PROCESS_FLAG_CWD) {
          LinuxProcessTable_readCwd(lp, procFd, mainTask);
       }
 
@@ -1838,6 +2355,18 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
+      if (scanNetNamespaces) {
+         if (mainTask) {
+            lp->net_ns = mainTask->net_ns;
+         } else {
+            LinuxProcessTable_readNetNamespace(lp, procFd);
+            if (lp->net_ns)
+               NetNamespaces_account(&this->netNamespaces, lp->net_ns, pid);
+         }
+      }
+
+      LinuxProcess_updateHistory(lp, ss->flags & PROCESS_FLAG_LINUX_HISTORY);
+
       /*
        * Final section after all data has been gathered
        */
@@ -1859,6 +2388,10 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          pt->kernelThreads++;
       } else if (Process_isUserlandThread(proc)) {
          pt->userlandThreads++;
+      } else if (!lp->threadsScanned && proc->nlwp > 1) {
+         /* threads that were not enumerated still count as tasks */
+         pt->userlandThreads += proc->nlwp - 1;
+         pt->totalTasks += proc->nlwp - 1;
       }
 
       /* Set at the end when we know if a new entry is a thread */
@@ -1900,6 +2433,11 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
    const Settings* settings = host->settings;
    LinuxMachine* lhost = (LinuxMachine*) host;
 
+   if (Snapshot_reader) {
+      SnapshotReader_scanProcesses(Snapshot_reader, this);
+      return;
+   }
+
    if (settings->ss->flags & PROCESS_FLAG_LINUX_AUTOGROUP) {
       // Refer to sched(7) 'autogroup feature' section
       // The kernel feature can be enabled/disabled through procfs at
@@ -1921,13 +2459,103 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
       }
    }
 
-   /* PROCDIR is an absolute path */
-   assert(PROCDIR[0] == '/');
+   /* the procfs root is an absolute path */
+   assert(LinuxMachine_procDir[0] == '/');
 #ifdef HAVE_OPENAT
    openat_arg_t rootFd = AT_FDCWD;
 #else
    openat_arg_t rootFd = "";
 #endif
 
-   LinuxProcessTable_recurseProcTree(this, rootFd, lhost, PROCDIR, NULL);
+   LinuxProcessTable_recurseProcTree(this, rootFd, lhost, LinuxMachine_procDir, NULL);
+
+   /* requested again by the cgroup screen while it shows the working set */
+   this->workingSetWanted = false;
+
+   if (this->threadsDropped) {
+      LinuxProcessTable_dropUnscannedThreads(this);
+      this->threadsDropped = false;
+   }
+
+   if ((settings->ss->flags & PROCESS_FLAG_LINUX_NETNS) || this->netNamespacesWanted)
+      LinuxProcessTable_updateNetNamespaces(this);
+
+   if (settings->ss->flags & PROCESS_FLAG_LINUX_PERF)
+      LinuxProcessTable_updatePerfCounters(this);
+   else
+      PerfCounters_clear(&this->perfCounters);
+
+   #ifdef HAVE_BPF
+   if (settings->ss->flags & PROCESS_FLAG_LINUX_SCHEDLAT)
+      LibBpf_readSchedLatency(this);
+   else
+      LibBpf_stopSchedLatency(this);
+   #endif
+
+   #ifdef HAVE_DELAYACCT
+   LibNl_flushDelayAcctData(this);
+   #endif
+}
+
+/*
+ * Without a scan (updates paused) a view change can reveal rows of threads
+ * that were not enumerated: of a branch expanded in tree view, or of every
+ * process after leaving it.  Read those threads, keeping the task counters
+ * of the last scan, which already included them.
+ */
+static bool LinuxProcessTable_revealEntries(Table* super) {
+   LinuxProcessTable* this = (LinuxProcessTable*) super;
+   ProcessTable* pt = &this->super;
+   const Settings* settings = super->host->settings;
+   const LinuxMachine* lhost = (const LinuxMachine*) super->host;
+
+   if (Snapshot_reader)
+      return false;
+
+   const unsigned int totalTasks = pt->totalTasks;
+   const unsigned int runningTasks = pt->runningTasks;
+   const unsigned int userlandThreads = pt->userlandThreads;
+   const unsigned int kernelThreads = pt->kernelThreads;
+
+   bool revealed = false;
+
+   /* rows of the threads read are appended behind */
+   const int size = Vector_size(super->rows);
+   for (int i = 0; i < size; i++) {
+      LinuxProcess* lp = (LinuxProcess*) Vector_get(super->rows, i);
+      const Process* proc = &lp->super;
+
+      if (!proc->super.updated || lp->threadsScanned || Process_isUserlandThread(proc))
+         continue;
+      if (!LinuxProcessTable_needsThreads(lp, true, proc->super.show, settings))
+         continue;
+
+      lp->threadsScanned = true;
+      revealed = true;
+
+      char path[PATH_MAX];
+      LinuxMachine_procPath(path, sizeof(path), "/%d", Process_getPid(proc));
+#ifdef HAVE_OPENAT
+      int procFd = open(path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+      if (procFd < 0)
+         continue;
+#else
+      const char* procFd = path;
+#endif
+
+      LinuxProcessTable_recurseProcTree(this, procFd, lhost, "task", lp);
+      Compat_openatArgClose(procFd);
+   }
+
+   pt->totalTasks = totalTasks;
+   pt->runningTasks = runningTasks;
+   pt->userlandThreads = userlandThreads;
+   pt->kernelThreads = kernelThreads;
+
+   #ifdef HAVE_DELAYACCT
+   if (revealed)
+      LibNl_flushDelayAcctData(this);
+   #endif
+
+   return revealed;
 }
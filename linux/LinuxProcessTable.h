@@ -8,9 +8,17 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "ProcessTable.h"
 
+#include "linux/NetNamespace.h"
+#include "linux/PageSampler.h"
+#include "linux/PerfCounters.h"
+#include "linux/ProcessMaps.h"
+#include "linux/ScanBudget.h"
+#include "linux/WorkingSet.h"
+
 
 typedef struct TtyDriver_ {
    char* path;
@@ -23,12 +31,34 @@ typedef struct LinuxProcessTable_ {
    ProcessTable super;
 
    TtyDriver* ttyDrivers;
+   Hashtable* ttyNames;   /* encoded tty device number -> device path */
    bool haveSmapsRollup;
    bool haveAutogroup;
+   bool threadsDropped;   /* some process stopped having its threads scanned */
+
+   NetNamespaces netNamespaces;
+   bool netNamespacesWanted;   /* sampled for the netns screen even without netns columns */
+
+   char* numaMapsBuffer;   /* reused for reading numa_maps, grown for large processes */
+   size_t numaMapsSize;
+
+   ProcessMaps maps;   /* maps parser with its per-refresh caches */
+   PageSampler pageSampler;   /* USS estimation from pagemap */
+   WorkingSet workingSet;     /* WSS estimation by idle page tracking */
+   ScanBudget scanBudget;     /* shared by numa_maps, the USS samples and the WSS walks */
+   bool workingSetWanted;     /* tracked for the cgroup screen even without the WSS column */
+   PerfCounters perfCounters; /* counters of the tasks of the processes using the most CPU */
 
    #ifdef HAVE_DELAYACCT
    int netlink_family;
    struct nl_sock* netlink_socket;
+   struct LibNlRequest_* netlink_requests;   /* taskstats requests sent, but not answered yet */
+   size_t netlink_pending;
+   size_t netlink_batch;   /* requests in flight at most, as many replies as the receive buffer holds */
+   #endif
+
+   #ifdef HAVE_BPF
+   struct SchedLatency_* schedLatency;   /* eBPF scheduler latency collector, NULL until first used */
    #endif
 } LinuxProcessTable;
 
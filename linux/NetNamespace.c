@@ -0,0 +1,155 @@
+/*
+htop - linux/NetNamespace.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/NetNamespace.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/DataSource.h"
+#include "linux/LinuxMachine.h"
+
+
+void NetNamespaces_init(NetNamespaces* this) {
+   this->table = Hashtable_new(16, true);
+   this->size = 4096;
+   this->buffer = xMalloc(this->size);
+}
+
+void NetNamespaces_done(NetNamespaces* this) {
+   Hashtable_delete(this->table);
+   free(this->buffer);
+}
+
+static inline ht_key_t NetNamespaces_key(ino_t inode) {
+   /* namespace inodes are allocated from a 32-bit range */
+   return (ht_key_t) inode;
+}
+
+void NetNamespaces_account(NetNamespaces* this, ino_t inode, pid_t pid) {
+   NetNamespace* ns = Hashtable_get(this->table, NetNamespaces_key(inode));
+   if (!ns) {
+      ns = xCalloc(1, sizeof(NetNamespace));
+      ns->inode = inode;
+      ns->rx_rate = NAN;
+      ns->tx_rate = NAN;
+      ns->rx_packets_rate = NAN;
+      ns->tx_packets_rate = NAN;
+      Hashtable_put(this->table, NetNamespaces_key(inode), ns);
+   }
+
+   if (!ns->seen) {
+      ns->seen = true;
+      ns->pid = pid;
+      ns->processes = 0;
+   }
+   ns->processes++;
+}
+
+/* Reads /proc/<pid>/net/dev into the reused buffer, growing it for hosts with many interfaces */
+static const char* NetNamespaces_readDev(NetNamespaces* this, pid_t pid) {
+   char path[PATH_MAX];
+   LinuxMachine_procPath(path, sizeof(path), "/%d/net/dev", pid);
+
+   for (;;) {
+      ssize_t r = xReadfile(path, this->buffer, this->size);
+      if (r < 0)
+         return NULL;
+      if ((size_t) r < this->size - 1)
+         return this->buffer;
+
+      this->size *= 2;
+      this->buffer = xRealloc(this->buffer, this->size);
+   }
+}
+
+static void NetNamespaces_sample(NetNamespaces* this, NetNamespace* ns, const Machine* host) {
+   const char* content = NetNamespaces_readDev(this, ns->pid);
+   if (!content)
+      return;
+
+   unsigned long long rxBytes = 0, rxPackets = 0, txBytes = 0, txPackets = 0;
+   do {
+      const char* name;
+      size_t len = DataSource_nextWord(&content, &name);
+      const char* colon = memchr(name, ':', len);
+      if (!colon || (colon - name == 2 && strncmp(name, "lo", 2) == 0))
+         continue;
+      content = colon + 1;
+
+      unsigned long long stats[10];
+      for (size_t i = 0; i < ARRAYSIZE(stats); i++)
+         stats[i] = DataSource_nextNumber(&content);
+
+      rxBytes += stats[0];
+      rxPackets += stats[1];
+      txBytes += stats[8];
+      txPackets += stats[9];
+   } while (DataSource_skipLine(&content));
+
+   uint64_t timeDelta = ns->last_scan_ms ? saturatingSub(host->realtimeMs, ns->last_scan_ms) : 0;
+   ns->last_scan_ms = host->realtimeMs;
+
+   if (timeDelta > 0) {
+      double seconds = timeDelta / 1000.0;
+      ns->rx_rate = saturatingSub(rxBytes, ns->rx_bytes) / seconds;
+      ns->tx_rate = saturatingSub(txBytes, ns->tx_bytes) / seconds;
+      ns->rx_packets_rate = saturatingSub(rxPackets, ns->rx_packets) / seconds;
+      ns->tx_packets_rate = saturatingSub(txPackets, ns->tx_packets) / seconds;
+   }
+
+   ns->rx_bytes = rxBytes;
+   ns->rx_packets = rxPackets;
+   ns->tx_bytes = txBytes;
+   ns->tx_packets = txPackets;
+}
+
+typedef struct {
+   NetNamespaces* namespaces;
+   const Machine* host;
+   ht_key_t* stale;
+   size_t staleCount;
+   size_t staleCapacity;
+} NetNamespacesIterator;
+
+static void NetNamespaces_updateOne(ht_key_t key, void* value, void* data) {
+   NetNamespace* ns = (NetNamespace*) value;
+   NetNamespacesIterator* iter = (NetNamespacesIterator*) data;
+
+   if (ns->seen) {
+      NetNamespaces_sample(iter->namespaces, ns, iter->host);
+      ns->seen = false;
+      return;
+   }
+
+   if (iter->staleCount == iter->staleCapacity) {
+      iter->staleCapacity = iter->staleCapacity ? iter->staleCapacity * 2 : 8;
+      iter->stale = xReallocArray(iter->stale, iter->staleCapacity, sizeof(ht_key_t));
+   }
+   iter->stale[iter->staleCount++] = key;
+}
+
+void NetNamespaces_update(NetNamespaces* this, const Machine* host) {
+   NetNamespacesIterator iter = { .namespaces = this, .host = host };
+   Hashtable_foreach(this->table, NetNamespaces_updateOne, &iter);
+
+   for (size_t i = 0; i < iter.staleCount; i++)
+      Hashtable_remove(this->table, iter.stale[i]);
+   free(iter.stale);
+}
+
+const NetNamespace* NetNamespaces_get(const NetNamespaces* this, ino_t inode) {
+   const NetNamespace* ns = Hashtable_get(this->table, NetNamespaces_key(inode));
+   return ns && ns->inode == inode ? ns : NULL;
+}
@@ -0,0 +1,64 @@
+#ifndef HEADER_NetNamespace
+#define HEADER_NetNamespace
+/*
+htop - linux/NetNamespace.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "Machine.h"
+
+
+/*
+ * Network namespaces of the scanned processes.  The process scan counts
+ * every process in the namespace of its ns/net inode; afterwards the
+ * interface counters of each namespace are read once, from /proc/<pid>/net/dev
+ * of one of its processes, so the cost grows with the number of namespaces.
+ */
+typedef struct NetNamespace_ {
+   ino_t inode;
+   pid_t pid;                        /* representative process of the last scan */
+   unsigned int processes;           /* processes counted in the last scan */
+   bool seen;                        /* counted in the current scan */
+
+   /* summed over all interfaces but the loopback */
+   unsigned long long rx_bytes;
+   unsigned long long rx_packets;
+   unsigned long long tx_bytes;
+   unsigned long long tx_packets;
+
+   /* over the last interval, NAN until two samples were taken */
+   double rx_rate;
+   double tx_rate;
+   double rx_packets_rate;
+   double tx_packets_rate;
+
+   uint64_t last_scan_ms;            /* realtime of the previous sample, 0 if none */
+} NetNamespace;
+
+typedef struct NetNamespaces_ {
+   Hashtable* table;                 /* truncated inode -> NetNamespace */
+   char* buffer;                     /* reused for reading net/dev */
+   size_t size;
+} NetNamespaces;
+
+void NetNamespaces_init(NetNamespaces* this);
+
+void NetNamespaces_done(NetNamespaces* this);
+
+/* Counts a process in its namespace, the first one counted becomes the representative */
+void NetNamespaces_account(NetNamespaces* this, ino_t inode, pid_t pid);
+
+/* Samples the namespaces counted since the last update and forgets all others */
+void NetNamespaces_update(NetNamespaces* this, const Machine* host);
+
+const NetNamespace* NetNamespaces_get(const NetNamespaces* this, ino_t inode);
+
+#endif
@@ -0,0 +1,148 @@
+/*
+htop - linux/NetnsEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/NetnsEntry.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+NetnsEntry* NetnsEntry_new(const Machine* host, const Table* table) {
+   NetnsEntry* this = xCalloc(1, sizeof(NetnsEntry));
+   Object_setClass(this, Class(NetnsEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+
+   this->table = table;
+   this->rx_rate = NAN;
+   this->tx_rate = NAN;
+   this->rx_packets_rate = NAN;
+   this->tx_packets_rate = NAN;
+
+   return this;
+}
+
+void NetnsEntry_done(NetnsEntry* this) {
+   Row_done(&this->super);
+}
+
+static void NetnsEntry_delete(Object* cast) {
+   NetnsEntry* this = (NetnsEntry*) cast;
+   NetnsEntry_done(this);
+   free(this);
+}
+
+static void NetnsEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const NetnsEntry* this = (const NetnsEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+   uint8_t width = column ? (uint8_t) MINIMUM(abs(column->width), DYNAMIC_MAX_COLUMN_WIDTH) : 5;
+
+   int local = LinuxDynamicColumn_field(settings, this->table, field);
+   switch (local) {
+   case NETNS_INODE: xSnprintf(buffer, n, "%*llu ", width, (unsigned long long) this->inode); break;
+   case NETNS_PROCESSES: xSnprintf(buffer, n, "%*u ", width, this->processes); break;
+   case NETNS_PID: xSnprintf(buffer, n, "%*d ", width, this->pid); break;
+   case NETNS_RX_RATE: Row_printRate(str, this->rx_rate, coloring); return;
+   case NETNS_TX_RATE: Row_printRate(str, this->tx_rate, coloring); return;
+   case NETNS_RX_PACKETS_RATE: Row_printDecimal(this->rx_packets_rate, buffer, n, width, &attr); break;
+   case NETNS_TX_PACKETS_RATE: Row_printDecimal(this->tx_packets_rate, buffer, n, width, &attr); break;
+   case NETNS_RX_BYTES: Row_printBytes(str, this->rx_bytes, coloring); return;
+   case NETNS_TX_BYTES: Row_printBytes(str, this->tx_bytes, coloring); return;
+   case NETNS_COMMAND: Row_printLeftAlignedField(str, attr, this->command, width); return;
+   default:
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static const char* NetnsEntry_sortKeyString(Row* super) {
+   const NetnsEntry* this = (const NetnsEntry*) super;
+   return this->command;
+}
+
+static bool NetnsEntry_matchesFilter(const Row* super, const Table* table) {
+   const NetnsEntry* this = (const NetnsEntry*) super;
+   const char* incFilter = table->incFilter;
+   return incFilter && !String_contains_i(this->command, incFilter, true);
+}
+
+static int NetnsEntry_compareByKey(const NetnsEntry* n1, const NetnsEntry* n2, int local) {
+   switch (local) {
+   case NETNS_INODE:
+      return SPACESHIP_NUMBER(n1->inode, n2->inode);
+   case NETNS_PROCESSES:
+      return SPACESHIP_NUMBER(n1->processes, n2->processes);
+   case NETNS_PID:
+      return SPACESHIP_NUMBER(n1->pid, n2->pid);
+   case NETNS_RX_RATE:
+      return compareRealNumbers(n1->rx_rate, n2->rx_rate);
+   case NETNS_TX_RATE:
+      return compareRealNumbers(n1->tx_rate, n2->tx_rate);
+   case NETNS_RX_PACKETS_RATE:
+      return compareRealNumbers(n1->rx_packets_rate, n2->rx_packets_rate);
+   case NETNS_TX_PACKETS_RATE:
+      return compareRealNumbers(n1->tx_packets_rate, n2->tx_packets_rate);
+   case NETNS_RX_BYTES:
+      return SPACESHIP_NUMBER(n1->rx_bytes, n2->rx_bytes);
+   case NETNS_TX_BYTES:
+      return SPACESHIP_NUMBER(n1->tx_bytes, n2->tx_bytes);
+   case NETNS_COMMAND:
+      return SPACESHIP_NULLSTR(n1->command, n2->command);
+   default:
+      return 0;
+   }
+}
+
+static int NetnsEntry_compare(const void* v1, const void* v2) {
+   const NetnsEntry* n1 = (const NetnsEntry*)v1;
+   const NetnsEntry* n2 = (const NetnsEntry*)v2;
+   const Settings* settings = n1->super.host->settings;
+   const ScreenSettings* ss = settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int local = LinuxDynamicColumn_field(settings, n1->table, key);
+   int result = NetnsEntry_compareByKey(n1, n2, local);
+
+   // Implement tie-breaker (needed to make the sort order stable)
+   if (!result)
+      return SPACESHIP_NUMBER(n1->inode, n2->inode);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass NetnsEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = NetnsEntry_delete,
+      .compare = NetnsEntry_compare,
+   },
+   .matchesFilter = NetnsEntry_matchesFilter,
+   .sortKeyString = NetnsEntry_sortKeyString,
+   .writeField = NetnsEntry_writeField,
+};
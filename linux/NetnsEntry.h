@@ -0,0 +1,54 @@
+#ifndef HEADER_NetnsEntry
+#define HEADER_NetnsEntry
+/*
+htop - linux/NetnsEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <sys/types.h>
+
+#include "Machine.h"
+#include "Row.h"
+
+
+/* Table-local fields, in the order of NetnsTable_columns[] */
+typedef enum NetnsField_ {
+   NETNS_INODE = 0,
+   NETNS_PROCESSES,
+   NETNS_PID,
+   NETNS_RX_RATE,
+   NETNS_TX_RATE,
+   NETNS_RX_PACKETS_RATE,
+   NETNS_TX_PACKETS_RATE,
+   NETNS_RX_BYTES,
+   NETNS_TX_BYTES,
+   NETNS_COMMAND,
+   NETNS_LAST_FIELD
+} NetnsField;
+
+typedef struct NetnsEntry_ {
+   Row super;
+
+   const struct Table_* table;       /* owning table, to resolve sort keys */
+   ino_t inode;
+   unsigned int processes;
+   pid_t pid;                        /* process the counters were read from */
+   char command[64];                 /* of that process */
+
+   unsigned long long rx_bytes;
+   unsigned long long tx_bytes;
+   double rx_rate;
+   double tx_rate;
+   double rx_packets_rate;
+   double tx_packets_rate;
+} NetnsEntry;
+
+extern const RowClass NetnsEntry_class;
+
+NetnsEntry* NetnsEntry_new(const Machine* host, const struct Table_* table);
+
+void NetnsEntry_done(NetnsEntry* this);
+
+#endif
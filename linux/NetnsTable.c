@@ -0,0 +1,135 @@
+/*
+htop - linux/NetnsTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/NetnsTable.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Row.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcessTable.h"
+#include "linux/NetNamespace.h"
+#include "linux/NetnsEntry.h"
+
+
+/* Indexed by NetnsField */
+static const LinuxDynamicColumnDefaults NetnsTable_columns[] = {
+   [NETNS_INODE] = { .name = "inode", .heading = "NETNS", .description = "Inode of the network namespace", .width = 10, .enabled = true, },
+   [NETNS_PROCESSES] = { .name = "processes", .heading = "PROCS", .description = "Number of processes in the namespace", .width = 5, .enabled = true, },
+   [NETNS_PID] = { .name = "pid", .heading = "PID", .description = "Process the interface counters of the namespace were read from", .width = 7, .enabled = true, },
+   [NETNS_RX_RATE] = { .name = "rx_rate", .heading = "RECEIVE", .description = "Bytes received per second over all interfaces but the loopback", .width = 11, .enabled = true, },
+   [NETNS_TX_RATE] = { .name = "tx_rate", .heading = "TRANSMIT", .description = "Bytes transmitted per second over all interfaces but the loopback", .width = 11, .enabled = true, },
+   [NETNS_RX_PACKETS_RATE] = { .name = "rx_packets", .heading = "RX PKT/S", .description = "Packets received per second over all interfaces but the loopback", .width = 9, .enabled = true, },
+   [NETNS_TX_PACKETS_RATE] = { .name = "tx_packets", .heading = "TX PKT/S", .description = "Packets transmitted per second over all interfaces but the loopback", .width = 9, .enabled = true, },
+   [NETNS_RX_BYTES] = { .name = "rx_bytes", .heading = "RX_TOT", .description = "Total bytes received over all interfaces but the loopback", .width = 6, .enabled = false, },
+   [NETNS_TX_BYTES] = { .name = "tx_bytes", .heading = "TX_TOT", .description = "Total bytes transmitted over all interfaces but the loopback", .width = 6, .enabled = false, },
+   [NETNS_COMMAND] = { .name = "command", .heading = "Command", .description = "Command of the process the counters were read from", .width = -48, .enabled = true, },
+};
+
+static_assert(ARRAYSIZE(NetnsTable_columns) == NETNS_LAST_FIELD, "NetnsTable_columns must match NetnsField");
+
+const LinuxDynamicScreenDefaults NetnsTable_screen = {
+   .name = "netns",
+   .heading = "Net namespaces",
+   .caption = "Network traffic per network namespace",
+   .sortKey = "rx_rate",
+   .direction = -1,
+   .columns = NetnsTable_columns,
+   .totalColumns = ARRAYSIZE(NetnsTable_columns),
+   .newTable = NetnsTable_new,
+};
+
+Table* NetnsTable_new(Machine* host) {
+   NetnsTable* this = xCalloc(1, sizeof(NetnsTable));
+   Object_setClass(this, Class(NetnsTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(NetnsEntry), host);
+
+   return super;
+}
+
+void NetnsTable_done(NetnsTable* this) {
+   Table_done(&this->super);
+}
+
+static void NetnsTable_delete(Object* cast) {
+   NetnsTable* this = (NetnsTable*) cast;
+   NetnsTable_done(this);
+   free(this);
+}
+
+static void NetnsTable_addEntry(ATTR_UNUSED ht_key_t key, void* value, void* data) {
+   const NetNamespace* ns = (const NetNamespace*) value;
+   Table* super = (Table*) data;
+   ProcessTable* pt = (ProcessTable*) super->host->processTable;
+
+   int id = (int) (ns->inode & INT_MAX);
+   NetnsEntry* entry = (NetnsEntry*) Hashtable_get(super->table, id);
+   bool preExisting = entry != NULL;
+   if (entry) {
+      assert(Vector_indexOf(super->rows, entry, Row_idEqualCompare) != -1);
+   } else {
+      entry = NetnsEntry_new(super->host, super);
+      entry->super.id = id;
+      entry->inode = ns->inode;
+   }
+
+   entry->processes = ns->processes;
+   entry->rx_bytes = ns->rx_bytes;
+   entry->tx_bytes = ns->tx_bytes;
+   entry->rx_rate = ns->rx_rate;
+   entry->tx_rate = ns->tx_rate;
+   entry->rx_packets_rate = ns->rx_packets_rate;
+   entry->tx_packets_rate = ns->tx_packets_rate;
+
+   if (entry->pid != ns->pid || !entry->command[0]) {
+      const Process* proc = ProcessTable_findProcess(pt, ns->pid);
+      const char* command = proc ? Process_getCommand(proc) : NULL;
+      entry->pid = ns->pid;
+      String_safeStrncpy(entry->command, command ? command : "", sizeof(entry->command));
+   }
+
+   Row* row = &entry->super;
+   row->isRoot = true;
+
+   if (!preExisting)
+      Table_add(super, row);
+   row->updated = true;
+   row->show = true;
+}
+
+static void NetnsTable_iterateEntries(Table* super) {
+   LinuxProcessTable* pt = (LinuxProcessTable*) super->host->processTable;
+   if (!pt)
+      return;
+
+   /* namespaces are collected by the process scan, from now on also without netns columns */
+   pt->netNamespacesWanted = true;
+   Hashtable_foreach(pt->netNamespaces.table, NetnsTable_addEntry, super);
+}
+
+const TableClass NetnsTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = NetnsTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = NetnsTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,28 @@
+#ifndef HEADER_NetnsTable
+#define HEADER_NetnsTable
+/*
+htop - linux/NetnsTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Table.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+typedef struct NetnsTable_ {
+   Table super;
+} NetnsTable;
+
+extern const TableClass NetnsTable_class;
+
+extern const LinuxDynamicScreenDefaults NetnsTable_screen;
+
+Table* NetnsTable_new(Machine* host);
+
+void NetnsTable_done(NetnsTable* this);
+
+#endif
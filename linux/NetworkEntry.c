@@ -0,0 +1,166 @@
+/*
+htop - linux/NetworkEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/NetworkEntry.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "CRT.h"
+#include "DynamicColumn.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Table.h"
+#include "XUtils.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+NetworkEntry* NetworkEntry_new(const Machine* host, const Table* table) {
+   NetworkEntry* this = xCalloc(1, sizeof(NetworkEntry));
+   Object_setClass(this, Class(NetworkEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+
+   this->table = table;
+   this->speed = -1;
+   this->rx_rate = NAN;
+   this->tx_rate = NAN;
+   this->rx_packets_rate = NAN;
+   this->tx_packets_rate = NAN;
+   this->utilization = NAN;
+
+   return this;
+}
+
+void NetworkEntry_done(NetworkEntry* this) {
+   Row_done(&this->super);
+}
+
+static void NetworkEntry_delete(Object* cast) {
+   NetworkEntry* this = (NetworkEntry*) cast;
+   NetworkEntry_done(this);
+   free(this);
+}
+
+static void NetworkEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const NetworkEntry* this = (const NetworkEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[256];
+   size_t n = sizeof(buffer);
+   int attr = CRT_colors[DEFAULT_COLOR];
+
+   const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+   uint8_t width = column ? (uint8_t) MINIMUM(abs(column->width), DYNAMIC_MAX_COLUMN_WIDTH) : 5;
+
+   int local = LinuxDynamicColumn_field(settings, this->table, field);
+   switch (local) {
+   case NETWORK_NAME: Row_printLeftAlignedField(str, attr, this->name, width); return;
+   case NETWORK_RX_RATE: Row_printRate(str, this->rx_rate, coloring); return;
+   case NETWORK_TX_RATE: Row_printRate(str, this->tx_rate, coloring); return;
+   case NETWORK_RX_PACKETS_RATE: Row_printDecimal(this->rx_packets_rate, buffer, n, width, &attr); break;
+   case NETWORK_TX_PACKETS_RATE: Row_printDecimal(this->tx_packets_rate, buffer, n, width, &attr); break;
+   case NETWORK_UTILIZATION: Row_printPercentage(this->utilization, buffer, n, width, &attr); break;
+   case NETWORK_RX_ERRORS: Row_printCount(str, this->rx_errors, coloring); return;
+   case NETWORK_TX_ERRORS: Row_printCount(str, this->tx_errors, coloring); return;
+   case NETWORK_RX_DROPPED: Row_printCount(str, this->rx_dropped, coloring); return;
+   case NETWORK_TX_DROPPED: Row_printCount(str, this->tx_dropped, coloring); return;
+   case NETWORK_RX_BYTES: Row_printBytes(str, this->rx_bytes, coloring); return;
+   case NETWORK_TX_BYTES: Row_printBytes(str, this->tx_bytes, coloring); return;
+   case NETWORK_SPEED:
+      if (this->speed < 0) {
+         attr = CRT_colors[PROCESS_SHADOW];
+         xSnprintf(buffer, n, "%*s ", width, "N/A");
+      } else {
+         xSnprintf(buffer, n, "%*lld ", width, this->speed);
+      }
+      break;
+   default:
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static const char* NetworkEntry_sortKeyString(Row* super) {
+   const NetworkEntry* this = (const NetworkEntry*) super;
+   return this->name;
+}
+
+static bool NetworkEntry_matchesFilter(const Row* super, const Table* table) {
+   const NetworkEntry* this = (const NetworkEntry*) super;
+   const char* incFilter = table->incFilter;
+   return incFilter && !String_contains_i(this->name, incFilter, true);
+}
+
+static int NetworkEntry_compareByKey(const NetworkEntry* n1, const NetworkEntry* n2, int local) {
+   switch (local) {
+   case NETWORK_NAME:
+      return SPACESHIP_NULLSTR(n1->name, n2->name);
+   case NETWORK_RX_RATE:
+      return compareRealNumbers(n1->rx_rate, n2->rx_rate);
+   case NETWORK_TX_RATE:
+      return compareRealNumbers(n1->tx_rate, n2->tx_rate);
+   case NETWORK_RX_PACKETS_RATE:
+      return compareRealNumbers(n1->rx_packets_rate, n2->rx_packets_rate);
+   case NETWORK_TX_PACKETS_RATE:
+      return compareRealNumbers(n1->tx_packets_rate, n2->tx_packets_rate);
+   case NETWORK_UTILIZATION:
+      return compareRealNumbers(n1->utilization, n2->utilization);
+   case NETWORK_RX_ERRORS:
+      return SPACESHIP_NUMBER(n1->rx_errors, n2->rx_errors);
+   case NETWORK_TX_ERRORS:
+      return SPACESHIP_NUMBER(n1->tx_errors, n2->tx_errors);
+   case NETWORK_RX_DROPPED:
+      return SPACESHIP_NUMBER(n1->rx_dropped, n2->rx_dropped);
+   case NETWORK_TX_DROPPED:
+      return SPACESHIP_NUMBER(n1->tx_dropped, n2->tx_dropped);
+   case NETWORK_RX_BYTES:
+      return SPACESHIP_NUMBER(n1->rx_bytes, n2->rx_bytes);
+   case NETWORK_TX_BYTES:
+      return SPACESHIP_NUMBER(n1->tx_bytes, n2->tx_bytes);
+   case NETWORK_SPEED:
+      return SPACESHIP_NUMBER(n1->speed, n2->speed);
+   default:
+      return 0;
+   }
+}
+
+static int NetworkEntry_compare(const void* v1, const void* v2) {
+   const NetworkEntry* n1 = (const NetworkEntry*)v1;
+   const NetworkEntry* n2 = (const NetworkEntry*)v2;
+   const Settings* settings = n1->super.host->settings;
+   const ScreenSettings* ss = settings->ss;
+   RowField key = ScreenSettings_getActiveSortKey(ss);
+   int local = LinuxDynamicColumn_field(settings, n1->table, key);
+   int result = NetworkEntry_compareByKey(n1, n2, local);
+
+   // Implement tie-breaker (needed to make the sort order stable)
+   if (!result)
+      return SPACESHIP_NULLSTR(n1->name, n2->name);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+const RowClass NetworkEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = NetworkEntry_delete,
+      .compare = NetworkEntry_compare,
+   },
+   .matchesFilter = NetworkEntry_matchesFilter,
+   .sortKeyString = NetworkEntry_sortKeyString,
+   .writeField = NetworkEntry_writeField,
+};
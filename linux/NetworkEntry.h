@@ -0,0 +1,67 @@
+#ifndef HEADER_NetworkEntry
+#define HEADER_NetworkEntry
+/*
+htop - linux/NetworkEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Row.h"
+
+
+/* Table-local fields, in the order of NetworkTable_columns[] */
+typedef enum NetworkField_ {
+   NETWORK_NAME = 0,
+   NETWORK_RX_RATE,
+   NETWORK_TX_RATE,
+   NETWORK_RX_PACKETS_RATE,
+   NETWORK_TX_PACKETS_RATE,
+   NETWORK_UTILIZATION,
+   NETWORK_RX_ERRORS,
+   NETWORK_TX_ERRORS,
+   NETWORK_RX_DROPPED,
+   NETWORK_TX_DROPPED,
+   NETWORK_RX_BYTES,
+   NETWORK_TX_BYTES,
+   NETWORK_SPEED,
+   NETWORK_LAST_FIELD
+} NetworkField;
+
+typedef struct NetworkEntry_ {
+   Row super;
+
+   const struct Table_* table;       /* owning table, to resolve sort keys */
+   char name[32];                    /* interface name */
+   long long speed;                  /* link speed in Mbit/s, -1 if unknown */
+
+   /* cumulative counters of /proc/net/dev */
+   unsigned long long rx_bytes;
+   unsigned long long rx_packets;
+   unsigned long long rx_errors;
+   unsigned long long rx_dropped;
+   unsigned long long tx_bytes;
+   unsigned long long tx_packets;
+   unsigned long long tx_errors;
+   unsigned long long tx_dropped;
+
+   /* over the last interval, NAN until two samples were taken */
+   double rx_rate;                   /* bytes per second */
+   double tx_rate;
+   double rx_packets_rate;
+   double tx_packets_rate;
+   float utilization;                /* busier direction relative to the link speed */
+
+   uint64_t last_scan_ms;            /* realtime of the previous sample, 0 if none */
+} NetworkEntry;
+
+extern const RowClass NetworkEntry_class;
+
+NetworkEntry* NetworkEntry_new(const Machine* host, const struct Table_* table);
+
+void NetworkEntry_done(NetworkEntry* this);
+
+#endif
@@ -0,0 +1,200 @@
+/*
+htop - linux/NetworkTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/NetworkTable.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#include "linux/DataSource.h"
+#include "linux/LinuxMachine.h"
+#include "linux/NetworkEntry.h"
+
+
+/* Indexed by NetworkField */
+static const LinuxDynamicColumnDefaults NetworkTable_columns[] = {
+   [NETWORK_NAME] = { .name = "name", .heading = "INTERFACE", .description = "Name of the network interface", .width = -16, .enabled = true, },
+   [NETWORK_RX_RATE] = { .name = "rx_rate", .heading = "RECEIVE", .description = "Bytes received per second", .width = 11, .enabled = true, },
+   [NETWORK_TX_RATE] = { .name = "tx_rate", .heading = "TRANSMIT", .description = "Bytes transmitted per second", .width = 11, .enabled = true, },
+   [NETWORK_RX_PACKETS_RATE] = { .name = "rx_packets", .heading = "RX PKT/S", .description = "Packets received per second", .width = 9, .enabled = true, },
+   [NETWORK_TX_PACKETS_RATE] = { .name = "tx_packets", .heading = "TX PKT/S", .description = "Packets transmitted per second", .width = 9, .enabled = true, },
+   [NETWORK_UTILIZATION] = { .name = "util", .heading = "UTIL%", .description = "Throughput of the busier direction relative to the link speed", .width = 5, .enabled = true, },
+   [NETWORK_RX_ERRORS] = { .name = "rx_errors", .heading = "RX ERRORS", .description = "Receive errors since the interface was created", .width = 11, .enabled = true, },
+   [NETWORK_TX_ERRORS] = { .name = "tx_errors", .heading = "TX ERRORS", .description = "Transmit errors since the interface was created", .width = 11, .enabled = true, },
+   [NETWORK_RX_DROPPED] = { .name = "rx_dropped", .heading = "RX DROPPED", .description = "Received packets dropped since the interface was created", .width = 11, .enabled = true, },
+   [NETWORK_TX_DROPPED] = { .name = "tx_dropped", .heading = "TX DROPPED", .description = "Transmitted packets dropped since the interface was created", .width = 11, .enabled = true, },
+   [NETWORK_RX_BYTES] = { .name = "rx_bytes", .heading = "RX_TOT", .description = "Total bytes received since the interface was created", .width = 6, .enabled = false, },
+   [NETWORK_TX_BYTES] = { .name = "tx_bytes", .heading = "TX_TOT", .description = "Total bytes transmitted since the interface was created", .width = 6, .enabled = false, },
+   [NETWORK_SPEED] = { .name = "speed", .heading = "MBIT/S", .description = "Link speed in Mbit/s as reported by the driver", .width = 6, .enabled = false, },
+};
+
+static_assert(ARRAYSIZE(NetworkTable_columns) == NETWORK_LAST_FIELD, "NetworkTable_columns must match NetworkField");
+
+const LinuxDynamicScreenDefaults NetworkTable_screen = {
+   .name = "network",
+   .heading = "Network",
+   .caption = "Network interface statistics (/proc/net/dev)",
+   .sortKey = "rx_rate",
+   .direction = -1,
+   .columns = NetworkTable_columns,
+   .totalColumns = ARRAYSIZE(NetworkTable_columns),
+   .newTable = NetworkTable_new,
+};
+
+Table* NetworkTable_new(Machine* host) {
+   NetworkTable* this = xCalloc(1, sizeof(NetworkTable));
+   Object_setClass(this, Class(NetworkTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(NetworkEntry), host);
+
+   return super;
+}
+
+void NetworkTable_done(NetworkTable* this) {
+   Table_done(&this->super);
+}
+
+static void NetworkTable_delete(Object* cast) {
+   NetworkTable* this = (NetworkTable*) cast;
+   NetworkTable_done(this);
+   free(this);
+}
+
+static long long NetworkTable_readSpeed(const char* name) {
+   char path[PATH_MAX];
+   char buffer[32];
+   if (xReadfile(LinuxMachine_sysPath(path, sizeof(path), "/class/net/%s/speed", name), buffer, sizeof(buffer)) <= 0)
+      return -1;
+
+   /* virtual and disconnected interfaces report -1 or fail the read */
+   long long speed = strtoll(buffer, NULL, 10);
+   return speed > 0 ? speed : -1;
+}
+
+/* Interfaces have no stable small number, so rows are keyed by a hash
+   of the name; the rare collision moves on to the next free identifier */
+static NetworkEntry* NetworkTable_getEntry(NetworkTable* this, const char* name, size_t nameLen, bool* preExisting) {
+   Table* super = &this->super;
+
+   uint32_t hash = 2166136261U;
+   for (size_t i = 0; i < nameLen; i++)
+      hash = (hash ^ (unsigned char) name[i]) * 16777619U;
+
+   int id = (int) (hash & INT_MAX);
+   NetworkEntry* entry;
+   while ((entry = (NetworkEntry*) Hashtable_get(super->table, id)) != NULL) {
+      if (strncmp(entry->name, name, nameLen) == 0 && entry->name[nameLen] == '\0')
+         break;
+      id = id == INT_MAX ? 1 : id + 1;
+   }
+
+   *preExisting = entry != NULL;
+   if (entry) {
+      assert(Vector_indexOf(super->rows, entry, Row_idEqualCompare) != -1);
+      assert(entry->super.id == id);
+   } else {
+      entry = NetworkEntry_new(super->host, super);
+      entry->super.id = id;
+      memcpy(entry->name, name, nameLen);
+      entry->name[nameLen] = '\0';
+      entry->speed = NetworkTable_readSpeed(entry->name);
+   }
+   return entry;
+}
+
+static void NetworkTable_updateRates(NetworkEntry* entry, const Machine* host, const unsigned long long stats[16]) {
+   uint64_t timeDelta = entry->last_scan_ms ? saturatingSub(host->realtimeMs, entry->last_scan_ms) : 0;
+   entry->last_scan_ms = host->realtimeMs;
+
+   if (timeDelta > 0) {
+      double seconds = timeDelta / 1000.0;
+      entry->rx_rate = saturatingSub(stats[0], entry->rx_bytes) / seconds;
+      entry->rx_packets_rate = saturatingSub(stats[1], entry->rx_packets) / seconds;
+      entry->tx_rate = saturatingSub(stats[8], entry->tx_bytes) / seconds;
+      entry->tx_packets_rate = saturatingSub(stats[9], entry->tx_packets) / seconds;
+
+      if (entry->speed > 0) {
+         double bitsPerSecond = MAXIMUM(entry->rx_rate, entry->tx_rate) * 8.0;
+         entry->utilization = (float) MINIMUM(100.0, bitsPerSecond / (entry->speed * 10000.0));
+      }
+   }
+
+   entry->rx_bytes = stats[0];
+   entry->rx_packets = stats[1];
+   entry->rx_errors = stats[2];
+   entry->rx_dropped = stats[3];
+   entry->tx_bytes = stats[8];
+   entry->tx_packets = stats[9];
+   entry->tx_errors = stats[10];
+   entry->tx_dropped = stats[11];
+}
+
+static void NetworkTable_iterateEntries(Table* super) {
+   NetworkTable* this = (NetworkTable*) super;
+   const Machine* host = super->host;
+
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/net/dev"), 0));
+   if (!content)
+      return;
+
+   do {
+      /* counters of more than eight digits follow the colon without a blank */
+      const char* name;
+      size_t wordLen = DataSource_nextWord(&content, &name);
+      const char* colon = memchr(name, ':', wordLen);
+      if (!colon)
+         continue;
+
+      size_t nameLen = (size_t) (colon - name);
+      if (nameLen == 0 || nameLen >= sizeof(((NetworkEntry*)NULL)->name))
+         continue;
+      content = colon + 1;
+
+      /* receive: bytes packets errs drop fifo frame compressed multicast,
+         transmit: bytes packets errs drop fifo colls carrier compressed */
+      unsigned long long stats[16];
+      for (size_t i = 0; i < ARRAYSIZE(stats); i++)
+         stats[i] = DataSource_nextNumber(&content);
+
+      bool preExisting;
+      NetworkEntry* entry = NetworkTable_getEntry(this, name, nameLen, &preExisting);
+      NetworkTable_updateRates(entry, host, stats);
+
+      Row* row = &entry->super;
+      row->isRoot = true;
+
+      if (!preExisting)
+         Table_add(super, row);
+      row->updated = true;
+      row->show = true;
+   } while (DataSource_skipLine(&content));
+}
+
+const TableClass NetworkTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = NetworkTable_delete,
+   },
+   .prepare = Table_prepareEntries,
+   .iterate = NetworkTable_iterateEntries,
+   .cleanup = Table_cleanupEntries,
+};
@@ -0,0 +1,28 @@
+#ifndef HEADER_NetworkTable
+#define HEADER_NetworkTable
+/*
+htop - linux/NetworkTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+#include "Table.h"
+
+#include "linux/LinuxDynamicScreen.h"
+
+
+typedef struct NetworkTable_ {
+   Table super;
+} NetworkTable;
+
+extern const TableClass NetworkTable_class;
+
+extern const LinuxDynamicScreenDefaults NetworkTable_screen;
+
+Table* NetworkTable_new(Machine* host);
+
+void NetworkTable_done(NetworkTable* this);
+
+#endif
@@ -0,0 +1,208 @@
+/*
+htop - linux/PageSampler.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/PageSampler.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/LinuxMachine.h"
+#include "linux/ProcessMaps.h"
+
+
+/* pagemap entry bits, see Documentation/admin-guide/mm/pagemap.rst */
+#define PAGEMAP_PFN_MASK    ((1ULL << 55) - 1)
+#define PAGEMAP_EXCLUSIVE   (1ULL << 56)
+#define PAGEMAP_PRESENT     (1ULL << 63)
+
+/* entries read at once when samples are close to each other */
+#define PAGE_SAMPLER_BLOCK 64
+
+/* sparse address spaces are probed at most this many times per wanted sample */
+#define PAGE_SAMPLER_MAX_PROBES_PER_SAMPLE 64
+
+void PageSampler_init(PageSampler* this, size_t pageSize) {
+   this->pageSize = pageSize;
+   this->kpagecountFd = -1;
+   this->kpagecountTried = false;
+   this->ranges = NULL;
+   this->nRanges = 0;
+   this->rangesCapacity = 0;
+   this->random = 0x9E3779B97F4A7C15ULL ^ (uint64_t)getpid();
+   this->confidence = 0;
+   this->z = NAN;
+}
+
+void PageSampler_done(PageSampler* this) {
+   if (this->kpagecountFd >= 0)
+      close(this->kpagecountFd);
+   free(this->ranges);
+}
+
+/* Uniform in [0, 1) */
+static double PageSampler_random(PageSampler* this) {
+   uint64_t x = this->random;
+   x ^= x << 13;
+   x ^= x >> 7;
+   x ^= x << 17;
+   this->random = x;
+   return (double)(x >> 11) / (double)(1ULL << 53);
+}
+
+/* Two-sided z-score of a confidence level, by bisection of erf(3) */
+static double PageSampler_zScore(unsigned int confidence) {
+   double level = confidence / 100.0;
+   double low = 0.0;
+   double high = 8.0;
+   for (int i = 0; i < 50; i++) {
+      double mid = (low + high) / 2.0;
+      if (erf(mid / sqrt(2.0)) < level)
+         low = mid;
+      else
+         high = mid;
+   }
+   return (low + high) / 2.0;
+}
+
+/* Collects the address ranges of the mappings and returns their number of pages */
+static uint64_t PageSampler_parseRanges(PageSampler* this, const char* maps, size_t length) {
+   this->nRanges = ProcessMaps_ranges(maps, length, &this->ranges, &this->rangesCapacity);
+
+   uint64_t pages = 0;
+   for (size_t i = 0; i < this->nRanges; i++)
+      pages += (this->ranges[2 * i + 1] - this->ranges[2 * i]) / this->pageSize;
+
+   return pages;
+}
+
+static bool PageSampler_isPrivate(PageSampler* this, uint64_t entry) {
+   /* frame numbers are only visible with CAP_SYS_ADMIN, like kpagecount itself */
+   uint64_t pfn = entry & PAGEMAP_PFN_MASK;
+   if (pfn && !this->kpagecountTried) {
+      char path[PATH_MAX];
+      this->kpagecountFd = open(LinuxMachine_procPath(path, sizeof(path), "/kpagecount"), O_RDONLY | O_CLOEXEC);
+      this->kpagecountTried = true;
+   }
+
+   if (pfn && this->kpagecountFd >= 0) {
+      uint64_t count;
+      if (pread(this->kpagecountFd, &count, sizeof(count), (off_t)(pfn * sizeof(count))) == (ssize_t)sizeof(count))
+         return count <= 1;
+   }
+
+   return entry & PAGEMAP_EXCLUSIVE;
+}
+
+PageSampleStatus PageSampler_sample(PageSampler* this, const ScanBudget* budget, openat_arg_t procFd, const char* maps, size_t length,
+                                    unsigned long long resident, unsigned int samples, unsigned int confidence,
+                                    PageSample* result) {
+   result->uss = NAN;
+   result->error = NAN;
+
+   uint64_t pages = PageSampler_parseRanges(this, maps, length);
+   if (resident == 0 || pages == 0 || samples == 0) {
+      result->uss = 0.0;
+      result->error = 0.0;
+      return PAGE_SAMPLE_DONE;
+   }
+
+   int fd = Compat_openat(procFd, "pagemap", O_RDONLY);
+   if (fd < 0)
+      return PAGE_SAMPLE_FAILED;
+
+   if (confidence != this->confidence) {
+      this->confidence = confidence;
+      this->z = PageSampler_zScore(confidence);
+   }
+
+   /* Systematic sample over the virtual pages with a random start; probe
+      more of them the sparser the resident pages are in the address space */
+   uint64_t probes = (uint64_t)ceil((double)samples * (double)pages / (double)resident);
+   probes = CLAMP(probes, (uint64_t)samples, (uint64_t)samples * PAGE_SAMPLER_MAX_PROBES_PER_SAMPLE);
+   probes = MINIMUM(probes, pages);
+   double stride = (double)pages / (double)probes;
+   size_t block = stride < PAGE_SAMPLER_BLOCK ? PAGE_SAMPLER_BLOCK : 1;
+
+   uint64_t entries[PAGE_SAMPLER_BLOCK];
+   uint64_t blockFirst = 0;
+   size_t blockLength = 0;
+
+   size_t range = 0;
+   uint64_t rangeFirst = 0;   /* index of the first page of the range among all pages */
+   unsigned int present = 0;
+   unsigned int private = 0;
+
+   /* the probes run from low to high addresses, so a partial sample
+      only covers the start of the address space */
+   bool truncated = false;
+
+   double position = PageSampler_random(this) * stride;
+   for (uint64_t i = 0; i < probes; i++, position += stride) {
+      if ((i % PAGE_SAMPLER_BLOCK) == PAGE_SAMPLER_BLOCK - 1 && ScanBudget_expired(budget)) {
+         truncated = true;
+         break;
+      }
+
+      uint64_t page = (uint64_t)position;
+      while (range < this->nRanges) {
+         uint64_t rangePages = (this->ranges[2 * range + 1] - this->ranges[2 * range]) / this->pageSize;
+         if (page < rangeFirst + rangePages)
+            break;
+         rangeFirst += rangePages;
+         range++;
+      }
+      if (range >= this->nRanges)
+         break;
+
+      uint64_t index = this->ranges[2 * range] / this->pageSize + (page - rangeFirst);
+      if (index < blockFirst || index >= blockFirst + blockLength) {
+         ssize_t r = pread(fd, entries, block * sizeof(*entries), (off_t)(index * sizeof(*entries)));
+         if (r < (ssize_t)sizeof(*entries))
+            continue;
+         blockFirst = index;
+         blockLength = (size_t)r / sizeof(*entries);
+      }
+
+      uint64_t entry = entries[index - blockFirst];
+      if (!(entry & PAGEMAP_PRESENT))
+         continue;
+
+      present++;
+      if (PageSampler_isPrivate(this, entry))
+         private++;
+   }
+
+   close(fd);
+
+   if (truncated)
+      return PAGE_SAMPLE_TRUNCATED;
+
+   if (present == 0)
+      return PAGE_SAMPLE_DONE;
+
+   /* Agresti-Coull interval of the private share, scaled to the resident
+      set and narrowed by the finite population correction */
+   double n = present;
+   double z = this->z;
+   double adjustedN = n + z * z;
+   double adjustedP = (private + z * z / 2.0) / adjustedN;
+   double spread = z * sqrt(adjustedP * (1.0 - adjustedP) / adjustedN);
+   double total = (double)resident;
+   double correction = (n < total && total > 1.0) ? sqrt((total - n) / (total - 1.0)) : 0.0;
+
+   result->uss = private / n * total;
+   result->error = MINIMUM(spread * correction, 1.0) * total;
+   return PAGE_SAMPLE_DONE;
+}
@@ -0,0 +1,67 @@
+#ifndef HEADER_PageSampler
+#define HEADER_PageSampler
+/*
+htop - linux/PageSampler.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Compat.h"
+
+#include "linux/ScanBudget.h"
+
+
+/*
+ * Estimates the unique set size (USS) of a process, the resident memory
+ * mapped by no other process, from a sample of its pages instead of a
+ * walk over all of smaps.  Each sampled page is looked up in
+ * /proc/<pid>/pagemap; a present page counts as private when
+ * /proc/kpagecount reports a single mapping of its frame, or, without the
+ * privileges to see frame numbers, when pagemap flags it as exclusively
+ * mapped.  The private share of the sample is scaled to the resident set
+ * size and comes with a confidence interval.
+ */
+
+typedef struct PageSampler_ {
+   size_t pageSize;
+   int kpagecountFd;                 /* -1 if unavailable */
+   bool kpagecountTried;
+
+   /* virtual address ranges of the process being sampled */
+   uint64_t* ranges;                 /* start and end address of each mapping */
+   size_t nRanges;
+   size_t rangesCapacity;
+
+   uint64_t random;                  /* xorshift state for the sample offsets */
+
+   unsigned int confidence;          /* percent the z-score was computed for */
+   double z;
+} PageSampler;
+
+typedef struct PageSample_ {
+   double uss;                       /* estimated private resident memory, in pages */
+   double error;                     /* half-width of the confidence interval, in pages */
+} PageSample;
+
+typedef enum PageSampleStatus_ {
+   PAGE_SAMPLE_DONE,                 /* result holds the estimate */
+   PAGE_SAMPLE_TRUNCATED,            /* the budget ran out, the partial sample would be biased */
+   PAGE_SAMPLE_FAILED,               /* pagemap not readable */
+} PageSampleStatus;
+
+void PageSampler_init(PageSampler* this, size_t pageSize);
+
+void PageSampler_done(PageSampler* this);
+
+/* Samples about the given number of resident pages of a process with the
+   mappings in maps, within the running read of budget */
+PageSampleStatus PageSampler_sample(PageSampler* this, const ScanBudget* budget, openat_arg_t procFd, const char* maps, size_t length,
+                                    unsigned long long resident, unsigned int samples, unsigned int confidence,
+                                    PageSample* result);
+
+#endif
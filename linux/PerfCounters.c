@@ -0,0 +1,335 @@
+/*
+htop - linux/PerfCounters.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/PerfCounters.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+static const struct {
+   uint32_t type;
+   uint64_t config;
+} PerfCounters_events[PERF_EVENT_COUNT] = {
+   [PERF_EVENT_CYCLES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+   [PERF_EVENT_INSTRUCTIONS] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+   [PERF_EVENT_CACHE_REFERENCES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+   [PERF_EVENT_CACHE_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+   [PERF_EVENT_CONTEXT_SWITCHES] = { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+   [PERF_EVENT_PAGE_FAULTS] = { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+};
+
+/* File descriptors left to the rest of htop, which has to keep walking /proc */
+#define PERF_FDS_RESERVE 256
+
+/* Shared by all instances, as they draw on the same RLIMIT_NOFILE */
+static size_t PerfCounters_openFds;
+static size_t PerfCounters_maxFds;
+
+/* Half of the soft limit at most, keeping the reserve; a quarter of small limits */
+static size_t PerfCounters_fdBudget(void) {
+   struct rlimit limit;
+   if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+      return 0;
+
+   rlim_t soft = limit.rlim_cur == RLIM_INFINITY ? 65536 : MINIMUM(limit.rlim_cur, (rlim_t) 65536);
+   if (soft <= 2 * PERF_FDS_RESERVE)
+      return (size_t) soft / 4;
+
+   return (size_t) MINIMUM(soft / 2, soft - PERF_FDS_RESERVE);
+}
+
+void PerfCounters_init(PerfCounters* this) {
+   this->targets = Hashtable_new(64, false);
+   this->list = NULL;
+   this->nTargets = 0;
+   this->capacity = 0;
+   this->stamp = 0;
+   this->probed = false;
+   this->available = false;
+   this->hardware = false;
+   this->excludeKernel = false;
+   this->exhausted = false;
+}
+
+static void PerfCounters_closeGroup(PerfGroup* group) {
+   for (size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+      if (group->fds[e] >= 0) {
+         close(group->fds[e]);
+         group->fds[e] = -1;
+         PerfCounters_openFds--;
+      }
+   }
+   group->leader = -1;
+   group->nEvents = 0;
+}
+
+static void PerfCounters_closeTarget(PerfTarget* target) {
+   for (size_t i = 0; i < target->nGroups; i++)
+      PerfCounters_closeGroup(&target->groups[i]);
+   free(target->groups);
+   free(target);
+}
+
+void PerfCounters_clear(PerfCounters* this) {
+   for (size_t i = 0; i < this->nTargets; i++) {
+      Hashtable_remove(this->targets, this->list[i]->key);
+      PerfCounters_closeTarget(this->list[i]);
+   }
+   this->nTargets = 0;
+}
+
+void PerfCounters_done(PerfCounters* this) {
+   PerfCounters_clear(this);
+   Hashtable_delete(this->targets);
+   free(this->list);
+}
+
+static int PerfCounters_open(const PerfCounters* this, PerfEvent event, pid_t pid, int cpu, int groupFd, unsigned long flags) {
+   struct perf_event_attr attr;
+   memset(&attr, 0, sizeof(attr));
+   attr.size = sizeof(attr);
+   attr.type = PerfCounters_events[event].type;
+   attr.config = PerfCounters_events[event].config;
+   attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+   /* the group starts counting once all of its members are in */
+   attr.disabled = groupFd < 0;
+   attr.exclude_kernel = this->excludeKernel;
+   attr.exclude_hv = 1;
+
+   return (int) syscall(SYS_perf_event_open, &attr, pid, cpu, groupFd, flags | PERF_FLAG_FD_CLOEXEC);
+}
+
+/* Finds out once which events this process may count, on itself */
+static bool PerfCounters_probe(PerfCounters* this) {
+   if (this->probed)
+      return this->available;
+   this->probed = true;
+
+   int fd = PerfCounters_open(this, PERF_EVENT_CONTEXT_SWITCHES, 0, -1, -1, 0);
+   if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+      this->excludeKernel = true;
+      fd = PerfCounters_open(this, PERF_EVENT_CONTEXT_SWITCHES, 0, -1, -1, 0);
+   }
+   if (fd < 0)
+      return false;
+   close(fd);
+   this->available = true;
+   if (!PerfCounters_maxFds)
+      PerfCounters_maxFds = PerfCounters_fdBudget();
+
+   fd = PerfCounters_open(this, PERF_EVENT_CYCLES, 0, -1, -1, 0);
+   if (fd >= 0) {
+      this->hardware = true;
+      close(fd);
+   }
+
+   return true;
+}
+
+static bool PerfCounters_openGroup(PerfCounters* this, PerfGroup* group, pid_t pid, int cpu, unsigned long flags) {
+   group->leader = -1;
+   group->nEvents = 0;
+   for (size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+      group->fds[e] = -1;
+      group->counts[e] = 0.0;
+   }
+
+   PerfEvent first = this->hardware ? PERF_EVENT_CYCLES : PERF_EVENT_CONTEXT_SWITCHES;
+   if (PerfCounters_openFds + (PERF_EVENT_COUNT - first) > PerfCounters_maxFds) {
+      this->exhausted = true;
+      return false;
+   }
+
+   for (PerfEvent e = first; e < PERF_EVENT_COUNT; e++) {
+      int fd = PerfCounters_open(this, e, pid, cpu, group->leader, flags);
+      if (fd < 0) {
+         /* a group cut short would be read as complete */
+         if (errno == EMFILE || errno == ENFILE) {
+            this->exhausted = true;
+            PerfCounters_closeGroup(group);
+            return false;
+         }
+         /* members the PMU does not support are left out */
+         if (group->leader < 0)
+            break;
+         continue;
+      }
+
+      PerfCounters_openFds++;
+      if (group->leader < 0)
+         group->leader = fd;
+      group->fds[e] = fd;
+      group->order[group->nEvents++] = e;
+   }
+
+   if (group->leader < 0)
+      return false;
+
+   ioctl(group->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+   return true;
+}
+
+static bool PerfCounters_keep(PerfCounters* this, ht_key_t key) {
+   PerfTarget* target = Hashtable_get(this->targets, key);
+   if (!target)
+      return false;
+
+   target->stamp = this->stamp;
+   return true;
+}
+
+static void PerfCounters_add(PerfCounters* this, PerfTarget* target, ht_key_t key, ht_key_t owner) {
+   target->key = key;
+   target->owner = owner;
+   target->stamp = this->stamp;
+   target->readMs = 0;
+   for (size_t e = 0; e < PERF_EVENT_COUNT; e++)
+      target->rates[e] = NAN;
+
+   if (this->nTargets == this->capacity) {
+      this->capacity = this->capacity ? this->capacity * 2 : 64;
+      this->list = xReallocArray(this->list, this->capacity, sizeof(*this->list));
+   }
+   this->list[this->nTargets++] = target;
+   Hashtable_put(this->targets, key, target);
+}
+
+void PerfCounters_begin(PerfCounters* this) {
+   this->stamp++;
+   this->exhausted = false;
+}
+
+bool PerfCounters_attachTask(PerfCounters* this, pid_t tid, pid_t owner) {
+   if (PerfCounters_keep(this, (ht_key_t) tid))
+      return true;
+   if (this->exhausted || !PerfCounters_probe(this))
+      return false;
+
+   PerfTarget* target = xCalloc(1, sizeof(PerfTarget));
+   target->groups = xCalloc(1, sizeof(PerfGroup));
+   if (!PerfCounters_openGroup(this, &target->groups[0], tid, -1, 0)) {
+      PerfCounters_closeTarget(target);
+      return false;
+   }
+   target->nGroups = 1;
+
+   PerfCounters_add(this, target, (ht_key_t) tid, (ht_key_t) owner);
+   return true;
+}
+
+bool PerfCounters_attachCGroup(PerfCounters* this, ht_key_t key, const char* path, const Machine* host) {
+   if (PerfCounters_keep(this, key))
+      return true;
+   if (this->exhausted || !PerfCounters_probe(this))
+      return false;
+
+   int dirFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (dirFd < 0)
+      return false;
+
+   /* cgroup events count on one CPU each */
+   PerfTarget* target = xCalloc(1, sizeof(PerfTarget));
+   target->groups = xCalloc(host->existingCPUs, sizeof(PerfGroup));
+   for (unsigned int cpu = 0; cpu < host->existingCPUs && !this->exhausted; cpu++) {
+      if (!Machine_isCPUonline(host, cpu))
+         continue;
+
+      if (PerfCounters_openGroup(this, &target->groups[target->nGroups], dirFd, (int) cpu, PERF_FLAG_PID_CGROUP))
+         target->nGroups++;
+   }
+   close(dirFd);
+
+   /* missing CPUs would undercount the cgroup */
+   if (target->nGroups == 0 || this->exhausted) {
+      PerfCounters_closeTarget(target);
+      return false;
+   }
+
+   PerfCounters_add(this, target, key, key);
+   return true;
+}
+
+static void PerfCounters_read(PerfTarget* target, uint64_t monotonicMs) {
+   double deltas[PERF_EVENT_COUNT] = { 0.0 };
+   bool counted[PERF_EVENT_COUNT] = { false };
+   uint64_t buffer[3 + PERF_EVENT_COUNT];
+
+   for (size_t i = 0; i < target->nGroups; i++) {
+      PerfGroup* group = &target->groups[i];
+
+      ssize_t r = read(group->leader, buffer, sizeof(buffer));
+      if (r < (ssize_t) (3 * sizeof(*buffer)))
+         continue;
+
+      uint64_t nr = buffer[0];
+      uint64_t enabled = buffer[1];
+      uint64_t running = buffer[2];
+      if (nr > group->nEvents || (size_t) r < (3 + nr) * sizeof(*buffer))
+         continue;
+
+      /* a group that never got onto the PMU has nothing to scale */
+      bool scheduled = running > 0 || enabled == 0;
+      double scale = running > 0 ? (double) enabled / (double) running : 1.0;
+
+      for (size_t k = 0; k < nr; k++) {
+         PerfEvent e = group->order[k];
+         double count = (double) buffer[3 + k] * scale;
+         if (scheduled) {
+            /* scaled totals may step back when the running share changes */
+            deltas[e] += MAXIMUM(count - group->counts[e], 0.0);
+            counted[e] = true;
+         }
+         group->counts[e] = count;
+      }
+   }
+
+   double seconds = target->readMs ? (double) saturatingSub(monotonicMs, target->readMs) / 1000.0 : 0.0;
+   for (size_t e = 0; e < PERF_EVENT_COUNT; e++)
+      target->rates[e] = (counted[e] && seconds > 0.0) ? deltas[e] / seconds : NAN;
+   target->readMs = monotonicMs;
+}
+
+void PerfCounters_end(PerfCounters* this, uint64_t monotonicMs) {
+   size_t kept = 0;
+   for (size_t i = 0; i < this->nTargets; i++) {
+      PerfTarget* target = this->list[i];
+      if (target->stamp != this->stamp) {
+         Hashtable_remove(this->targets, target->key);
+         PerfCounters_closeTarget(target);
+         continue;
+      }
+
+      PerfCounters_read(target, monotonicMs);
+      this->list[kept++] = target;
+   }
+   this->nTargets = kept;
+}
+
+const PerfTarget* PerfCounters_find(PerfCounters* this, ht_key_t key) {
+   return Hashtable_get(this->targets, key);
+}
+
+double PerfCounters_ratio(const double* rates, PerfEvent numerator, PerfEvent denominator) {
+   if (!isNonnegative(rates[numerator]) || !(rates[denominator] > 0.0))
+      return NAN;
+
+   return rates[numerator] / rates[denominator];
+}
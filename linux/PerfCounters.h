@@ -0,0 +1,95 @@
+#ifndef HEADER_PerfCounters
+#define HEADER_PerfCounters
+/*
+htop - linux/PerfCounters.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "Machine.h"
+
+
+/*
+ * Event counters from perf_event_open(2) for a bounded set of tasks or
+ * cgroups.  The events of a target form one group, read at once together
+ * with the time it was enabled and running, so the counts can be scaled up
+ * when the kernel multiplexed the group with others on too few hardware
+ * counters.  Without a hardware PMU, as in many virtual machines, only the
+ * software events are counted.
+ */
+
+typedef enum PerfEvent_ {
+   PERF_EVENT_CYCLES = 0,
+   PERF_EVENT_INSTRUCTIONS,
+   PERF_EVENT_CACHE_REFERENCES,
+   PERF_EVENT_CACHE_MISSES,
+   PERF_EVENT_CONTEXT_SWITCHES,      /* first software event */
+   PERF_EVENT_PAGE_FAULTS,
+   PERF_EVENT_COUNT
+} PerfEvent;
+
+/* Counters of a task, or of a cgroup on one CPU */
+typedef struct PerfGroup_ {
+   int leader;                       /* fd read for the whole group */
+   int fds[PERF_EVENT_COUNT];        /* -1 for events not counted */
+   unsigned int nEvents;
+   PerfEvent order[PERF_EVENT_COUNT];   /* events in the order of a group read */
+   double counts[PERF_EVENT_COUNT];  /* scaled totals at the previous read */
+} PerfGroup;
+
+typedef struct PerfTarget_ {
+   ht_key_t key;
+   ht_key_t owner;                   /* process of a task, the cgroup itself otherwise */
+   PerfGroup* groups;
+   size_t nGroups;
+   uint64_t stamp;                   /* last pass the target was attached in */
+   uint64_t readMs;                  /* monotonic time of the previous read, 0 before the first */
+   double rates[PERF_EVENT_COUNT];   /* events per second between the last two reads, NAN if not counted */
+} PerfTarget;
+
+typedef struct PerfCounters_ {
+   Hashtable* targets;               /* key -> PerfTarget */
+   PerfTarget** list;                /* the same targets, for the read pass */
+   size_t nTargets;
+   size_t capacity;
+   uint64_t stamp;                   /* number of the current pass */
+
+   bool probed;
+   bool available;                   /* software events can be counted at all */
+   bool hardware;                    /* a hardware PMU counts cycles */
+   bool excludeKernel;               /* perf_event_paranoid allows user space counting only */
+   bool exhausted;                   /* out of file descriptors, or of their share of RLIMIT_NOFILE, in this pass */
+} PerfCounters;
+
+void PerfCounters_init(PerfCounters* this);
+
+void PerfCounters_done(PerfCounters* this);
+
+/* Starts a pass; targets not attached again before PerfCounters_end are detached by it */
+void PerfCounters_begin(PerfCounters* this);
+
+/* Keeps counting a task of a process, or starts to; false if it cannot be counted */
+bool PerfCounters_attachTask(PerfCounters* this, pid_t tid, pid_t owner);
+
+/* Same for a cgroup by the path of its directory, with a group on each online CPU */
+bool PerfCounters_attachCGroup(PerfCounters* this, ht_key_t key, const char* path, const Machine* host);
+
+/* Detaches the targets not attached in this pass and reads all others in one go */
+void PerfCounters_end(PerfCounters* this, uint64_t monotonicMs);
+
+/* Detaches all targets */
+void PerfCounters_clear(PerfCounters* this);
+
+const PerfTarget* PerfCounters_find(PerfCounters* this, ht_key_t key);
+
+/* Ratio of two event rates, NAN unless both were counted */
+double PerfCounters_ratio(const double* rates, PerfEvent numerator, PerfEvent denominator);
+
+#endif
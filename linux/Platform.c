@@ -35,6 +35,7 @@ in the source distribution for its full text.
 #include "DateMeter.h"
 #include "DateTimeMeter.h"
 #include "DiskIOMeter.h"
+#include "DynamicMeter.h"
 #include "FileDescriptorMeter.h"
 #include "GPUMeter.h"
 #include "HostnameMeter.h"
@@ -58,11 +59,16 @@ in the source distribution for its full text.
 #include "UptimeMeter.h"
 #include "Vector.h"
 #include "XUtils.h"
+#include "linux/DataSource.h"
 #include "linux/IOPriority.h"
 #include "linux/IOPriorityPanel.h"
+#include "linux/InterruptMeter.h"
+#include "linux/LinuxDynamicMeter.h"
+#include "linux/LinuxDynamicScreen.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
 #include "linux/SELinuxMeter.h"
+#include "linux/Snapshot.h"
 #include "linux/SystemdMeter.h"
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
@@ -75,12 +81,10 @@ in the source distribution for its full text.
 #include <sys/capability.h>
 #endif
 
-#ifdef HAVE_LIBIBERTY
-#include <libiberty/demangle.h>
-#endif
-
 #ifdef HAVE_LIBUNWIND_PTRACE
 #include <libunwind-ptrace.h>
+
+#include "linux/BacktraceSymbols.h"
 #endif
 
 #ifdef HAVE_SENSORS_SENSORS_H
@@ -263,18 +267,21 @@ const MeterClass* const Platform_meterTypes[] = {
    &ZramMeter_class,
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
+   &InterruptMeter_class,
    &SELinuxMeter_class,
    &SystemdMeter_class,
    &SystemdUserMeter_class,
    &FileDescriptorMeter_class,
    &GPUMeter_class,
+   &DynamicMeter_class,
    NULL
 };
 
 int Platform_getUptime(void) {
+   char path[PATH_MAX];
    char uptimedata[64] = {0};
 
-   ssize_t uptimeread = xReadfile(PROCDIR "/uptime", uptimedata, sizeof(uptimedata));
+   ssize_t uptimeread = xReadfile(LinuxMachine_procPath(path, sizeof(path), "/uptime"), uptimedata, sizeof(uptimedata));
    if (uptimeread < 1) {
       return 0;
    }
@@ -291,13 +298,14 @@ int Platform_getUptime(void) {
 }
 
 void Platform_getLoadAverage(double* one, double* five, double* fifteen) {
+   char path[PATH_MAX];
    char loaddata[128] = {0};
 
    *one = NAN;
    *five = NAN;
    *fifteen = NAN;
 
-   ssize_t loadread = xReadfile(PROCDIR "/loadavg", loaddata, sizeof(loaddata));
+   ssize_t loadread = xReadfile(LinuxMachine_procPath(path, sizeof(path), "/loadavg"), loaddata, sizeof(loaddata));
    if (loadread < 1)
       return;
 
@@ -314,9 +322,10 @@ void Platform_getLoadAverage(double* one, double* five, double* fifteen) {
 }
 
 pid_t Platform_getMaxPid(void) {
+   char path[PATH_MAX];
    char piddata[32] = {0};
 
-   ssize_t pidread = xReadfile(PROCDIR "/sys/kernel/pid_max", piddata, sizeof(piddata));
+   ssize_t pidread = xReadfile(LinuxMachine_procPath(path, sizeof(path), "/sys/kernel/pid_max"), piddata, sizeof(piddata));
    if (pidread < 1)
       goto err;
 
@@ -399,7 +408,8 @@ void Platform_setGPUValues(Meter* this, double* totalUsage, unsigned long long*
    // instances. We also need a local cache of the monotonic timestamp, thus we
    // don't use host->prevMonotonicMs.
    if (host->monotonicMs > prevMonotonicMs) {
-      uint64_t monotonictimeDelta = host->monotonicMs - prevMonotonicMs;
+      // the meter is not updated after the first scan, take its time instead
+      uint64_t monotonictimeDelta = host->monotonicMs - (prevMonotonicMs ? prevMonotonicMs : host->prevMonotonicMs);
 
       unsigned long long int curResidueTime = lhost->curGpuTime;
 
@@ -508,8 +518,8 @@ void Platform_setZfsCompressedArcValues(Meter* this) {
 }
 
 char* Platform_getProcessEnv(pid_t pid) {
-   char procname[128];
-   xSnprintf(procname, sizeof(procname), PROCDIR "/%d/environ", pid);
+   char procname[PATH_MAX];
+   LinuxMachine_procPath(procname, sizeof(procname), "/%d/environ", pid);
    FILE* fp = fopen(procname, "r");
    if (!fp)
       return NULL;
@@ -549,7 +559,7 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    int dfd;
 
    char path[PATH_MAX];
-   xSnprintf(path, sizeof(path), PROCDIR "/%d/fdinfo/", pid);
+   LinuxMachine_procPath(path, sizeof(path), "/%d/fdinfo/", pid);
    if (strlen(path) >= (sizeof(path) - 2))
       goto err;
 
@@ -608,7 +618,7 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
          else
             data.end = strtoull(lock_end, NULL, 10);
 
-         xSnprintf(path, sizeof(path), PROCDIR "/%d/fd/%s", pid, de->d_name);
+         LinuxMachine_procPath(path, sizeof(path), "/%d/fd/%s", pid, de->d_name);
          char link[PATH_MAX];
          ssize_t link_len;
          if (strlen(path) < (sizeof(path) - 2) && (link_len = readlink(path, link, sizeof(link))) != -1)
@@ -632,29 +642,30 @@ err:
 
 void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred) {
    *ten = *sixty = *threehundred = 0;
-   char procname[128];
-   xSnprintf(procname, sizeof(procname), PROCDIR "/pressure/%s", file);
-   FILE* fp = fopen(procname, "r");
-   if (!fp) {
+   char procname[PATH_MAX];
+   LinuxMachine_procPath(procname, sizeof(procname), "/pressure/%s", file);
+   const char* content = DataSource_read(DataSource_get(procname, 0));
+   if (!content) {
       *ten = *sixty = *threehundred = NAN;
       return;
    }
-   int total = fscanf(fp, "some avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
+   int total = sscanf(content, "some avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
    if (total != EOF && !some) {
-      total = fscanf(fp, "full avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
+      const char* full = strstr(content, "\nfull ");
+      total = full ? sscanf(full + 1, "full avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred) : EOF;
    }
    (void) total;
    assert(total == 3);
-   fclose(fp);
 }
 
 void Platform_getFileDescriptors(double* used, double* max) {
+   char path[PATH_MAX];
    char buffer[128] = {0};
 
    *used = NAN;
    *max = 65536;
 
-   ssize_t fdread = xReadfile(PROCDIR "/sys/fs/file-nr", buffer, sizeof(buffer));
+   ssize_t fdread = xReadfile(LinuxMachine_procPath(path, sizeof(path), "/sys/fs/file-nr"), buffer, sizeof(buffer));
    if (fdread < 1)
       return;
 
@@ -667,40 +678,50 @@ void Platform_getFileDescriptors(double* used, double* max) {
 }
 
 bool Platform_getDiskIO(DiskIOData* data) {
-   FILE* fp = fopen(PROCDIR "/diskstats", "r");
-   if (!fp)
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/diskstats"), 0));
+   if (!content)
       return false;
 
-   char lastTopDisk[32] = { '\0' };
+   const char* lastTopDisk = NULL;
+   size_t lastTopDiskLen = 0;
 
    uint64_t read_sum = 0, write_sum = 0, timeSpend_sum = 0;
    uint64_t numDisks = 0;
 
-   char lineBuffer[256];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char diskname[32];
-      unsigned long long int read_tmp, write_tmp, timeSpend_tmp;
-      if (sscanf(lineBuffer, "%*d %*d %31s %*u %*u %llu %*u %*u %*u %llu %*u %*u %llu", diskname, &read_tmp, &write_tmp, &timeSpend_tmp) == 4) {
-         if (String_startsWith(diskname, "dm-") ||
-             String_startsWith(diskname, "loop") ||
-             String_startsWith(diskname, "md") ||
-             String_startsWith(diskname, "zram"))
-            continue;
+   do {
+      (void) DataSource_nextNumber(&content);  /* major */
+      (void) DataSource_nextNumber(&content);  /* minor */
 
-         /* only count root disks, e.g. do not count IO from sda and sda1 twice */
-         if (lastTopDisk[0] && String_startsWith(diskname, lastTopDisk))
-            continue;
+      const char* diskname;
+      size_t len = DataSource_nextWord(&content, &diskname);
+      if (len == 0)
+         continue;
 
-         /* This assumes disks are listed directly before any of their partitions */
-         String_safeStrncpy(lastTopDisk, diskname, sizeof(lastTopDisk));
+      if (strncmp(diskname, "dm-", 3) == 0 ||
+          strncmp(diskname, "loop", 4) == 0 ||
+          strncmp(diskname, "md", 2) == 0 ||
+          strncmp(diskname, "zram", 4) == 0)
+         continue;
+
+      /* only count root disks, e.g. do not count IO from sda and sda1 twice */
+      if (lastTopDisk && len >= lastTopDiskLen && strncmp(diskname, lastTopDisk, lastTopDiskLen) == 0)
+         continue;
+
+      /* This assumes disks are listed directly before any of their partitions */
+      lastTopDisk = diskname;
+      lastTopDiskLen = len;
+
+      unsigned long long stats[10];
+      for (size_t i = 0; i < ARRAYSIZE(stats); i++)
+         stats[i] = DataSource_nextNumber(&content);
+
+      read_sum += stats[2];
+      write_sum += stats[6];
+      timeSpend_sum += stats[9];
+      numDisks++;
+   } while (DataSource_skipLine(&content));
 
-         read_sum += read_tmp;
-         write_sum += write_tmp;
-         timeSpend_sum += timeSpend_tmp;
-         numDisks++;
-      }
-   }
-   fclose(fp);
    /* multiply with sector size */
    data->totalBytesRead = 512 * read_sum;
    data->totalBytesWritten = 512 * write_sum;
@@ -710,40 +731,101 @@ bool Platform_getDiskIO(DiskIOData* data) {
 }
 
 bool Platform_getNetworkIO(NetworkIOData* data) {
-   FILE* fp = fopen(PROCDIR "/net/dev", "r");
-   if (!fp)
+   char path[PATH_MAX];
+   const char* content = DataSource_read(DataSource_get(LinuxMachine_procPath(path, sizeof(path), "/net/dev"), 0));
+   if (!content)
       return false;
 
-   char lineBuffer[512];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char interfaceName[32];
-      unsigned long long int bytesReceived, packetsReceived, bytesTransmitted, packetsTransmitted;
-      if (sscanf(lineBuffer, "%31s %llu %llu %*u %*u %*u %*u %*u %*u %llu %llu",
-                             interfaceName,
-                             &bytesReceived,
-                             &packetsReceived,
-                             &bytesTransmitted,
-                             &packetsTransmitted) != 5)
+   do {
+      /* counters of more than eight digits follow the colon without a blank */
+      const char* interfaceName;
+      size_t len = DataSource_nextWord(&content, &interfaceName);
+      const char* colon = memchr(interfaceName, ':', len);
+      if (!colon)
          continue;
 
-      if (String_eq(interfaceName, "lo:"))
+      if (colon - interfaceName == 2 && strncmp(interfaceName, "lo", 2) == 0)
          continue;
+      content = colon + 1;
 
-      data->bytesReceived += bytesReceived;
-      data->packetsReceived += packetsReceived;
-      data->bytesTransmitted += bytesTransmitted;
-      data->packetsTransmitted += packetsTransmitted;
-   }
+      unsigned long long stats[10];
+      for (size_t i = 0; i < ARRAYSIZE(stats); i++)
+         stats[i] = DataSource_nextNumber(&content);
 
-   fclose(fp);
+      data->bytesReceived += stats[0];
+      data->packetsReceived += stats[1];
+      data->bytesTransmitted += stats[8];
+      data->packetsTransmitted += stats[9];
+   } while (DataSource_skipLine(&content));
 
    return true;
 }
 
+#ifdef HAVE_LIBUNWIND_PTRACE
+static BacktraceSymbols* Platform_backtraceSymbols;
+
+/* Function of the frame at cursor, from the symbol cache where its address is in a mapped file */
+static void Platform_resolveFrame(unw_cursor_t* cursor, unw_word_t pc, BacktraceFrameData* frame) {
+   char procName[2048] = "?";
+   unw_word_t offset;
+
+   const BacktraceMapping* mapping = BacktraceSymbols_mapping(Platform_backtraceSymbols, pc);
+   if (!mapping) {
+      if (unw_get_proc_name(cursor, procName, sizeof(procName), &offset) == 0) {
+         frame->functionName = xStrndup(procName, 2048);
+         frame->offset = offset;
+      } else {
+         frame->functionName = xStrdup("???");
+      }
+
+#if defined(HAVE_LIBUNWIND_ELF_FILENAME)
+      char elfFileName[2048] = { 0 };
+      if (unw_get_elf_filename(cursor, elfFileName, sizeof(elfFileName), &offset) == 0) {
+         frame->objectPath = xStrndup(elfFileName, 2048);
+
+         const char* lastSlash = strrchr(frame->objectPath, '/');
+         frame->objectName = xStrdup(lastSlash ? lastSlash + 1 : frame->objectPath);
+      }
+#endif
+      return;
+   }
+
+   frame->objectPath = xStrdup(mapping->object->path);
+   frame->objectName = xStrdup(mapping->object->name);
+
+   const BacktraceSymbol* symbol = BacktraceSymbols_find(mapping, pc);
+   if (!symbol) {
+      if (unw_get_proc_name(cursor, procName, sizeof(procName), &offset) != 0) {
+         frame->functionName = xStrdup("???");
+         return;
+      }
+
+      /* the whole function is cached where the unwinder knows its extent */
+      unw_proc_info_t info;
+      unw_word_t start = pc - offset;
+      unw_word_t end = pc + 1;
+      if (unw_get_proc_info(cursor, &info) == 0 && info.start_ip <= pc && pc < info.end_ip)
+         end = info.end_ip;
+
+      symbol = BacktraceSymbols_add(Platform_backtraceSymbols, mapping, start, end, procName);
+   }
+
+   frame->functionName = xStrdup(symbol->name);
+   if (symbol->demangledName)
+      frame->demangleFunctionName = xStrdup(symbol->demangledName);
+   frame->offset = pc - mapping->start + mapping->offset - symbol->start;
+}
+#endif
+
 void Platform_getBacktrace(pid_t pid, Vector* frames, char** error) {
 #ifdef HAVE_LIBUNWIND_PTRACE
    *error = NULL;
 
+   if (!Platform_backtraceSymbols) {
+      Platform_backtraceSymbols = xMalloc(sizeof(BacktraceSymbols));
+      BacktraceSymbols_init(Platform_backtraceSymbols);
+   }
+
    unw_addr_space_t addrSpace = unw_create_addr_space(&_UPT_accessors, 0);
    if (!addrSpace) {
       xAsprintf(error, "Unable to initialize libunwind.");
@@ -761,8 +843,9 @@ void Platform_getBacktrace(pid_t pid, Vector* frames, char** error) {
       goto addr_space_error;
    }
 
+   /* __WALL: other threads than the main one are clone children to wait(2) */
    int waitStatus = 0;
-   if (wait(&waitStatus) == -1) {
+   if (waitpid(pid, &waitStatus, __WALL) == -1) {
       int waitErrno = errno;
       xAsprintf(error, "wait: %s (%d)", strerror(waitErrno), waitErrno);
       goto ptrace_error;
@@ -773,6 +856,11 @@ void Platform_getBacktrace(pid_t pid, Vector* frames, char** error) {
       goto ptrace_error;
    }
 
+   if (!BacktraceSymbols_readMaps(Platform_backtraceSymbols, pid)) {
+      xAsprintf(error, "Unable to read the memory mappings of the process");
+      goto ptrace_error;
+   }
+
    struct UPT_info* context = _UPT_create(pid);
    if (!context) {
       xAsprintf(error, "Unable to create the context of libunwind-ptrace");
@@ -788,46 +876,20 @@ void Platform_getBacktrace(pid_t pid, Vector* frames, char** error) {
 
    int index = 0;
    do {
-      char procName[2048] = "?";
-      unw_word_t offset;
       unw_word_t pc;
 
+      ret = unw_get_reg(&cursor, UNW_REG_IP, &pc);
+      if (ret < 0) {
+         xAsprintf(error, "unable to get program counter register: %d", ret);
+         break;
+      }
+
       BacktraceFrameData* frame = BacktraceFrameData_new();
       frame->index = index;
-      if (unw_get_proc_name(&cursor, procName, sizeof(procName), &offset) == 0) {
-         ret = unw_get_reg(&cursor, UNW_REG_IP, &pc);
-         if (ret < 0) {
-            xAsprintf(error, "unable to get program counter register: %d", ret);
-            BacktraceFrameData_delete((Object *)frame);
-            break;
-         }
+      frame->address = pc;
+      frame->isSignalFrame = unw_is_signal_frame(&cursor);
+      Platform_resolveFrame(&cursor, pc, frame);
 
-         frame->address = pc;
-         frame->offset = offset;
-         frame->isSignalFrame = unw_is_signal_frame(&cursor);
-
-         frame->functionName = xStrndup(procName, 2048);
-
-#if defined(HAVE_LIBIBERTY)
-         char* demangledName = cplus_demangle(frame->functionName,
-                                              DMGL_PARAMS | AUTO_DEMANGLING);
-         frame->demangleFunctionName = demangledName;
-#endif
-
-#if defined(HAVE_LIBUNWIND_ELF_FILENAME)
-         unw_word_t offsetElfFileName;
-         char elfFileName[2048] = { 0 };
-         if (unw_get_elf_filename(&cursor, elfFileName, sizeof(elfFileName), &offsetElfFileName) == 0) {
-            frame->objectPath = xStrndup(elfFileName, 2048);
-
-            char *lastSlash = strrchr(frame->objectPath, '/');
-            frame->objectName = xStrndup(lastSlash + 1, 2048);
-         }
-#endif
-
-      } else {
-         frame->functionName = xStrdup("???");
-      }
       Vector_add(frames, (Object *)frame);
       index++;
    } while (unw_step(&cursor) > 0);
@@ -1100,15 +1162,47 @@ void Platform_longOptionsUsage(const char* name)
 #else
    (void) name;
 #endif
+   printf(
+"   --procfs=DIR                 Read process and system data from DIR instead of " PROCDIR "\n"
+"   --sysfs=DIR                  Read device data from DIR instead of " SYSDIR "\n"
+"   --attach[=FILE]              Show the snapshots htop-collector publishes in FILE\n"
+"                                (default " SNAPSHOT_DEFAULT_PATH ")\n");
 }
 
-CommandLineStatus Platform_getLongOption(int opt, int argc, char** argv) {
-#ifndef HAVE_LIBCAP
-   (void) argc;
-   (void) argv;
-#endif
+/* Snapshot file to attach to, see --attach */
+static const char* Platform_attachPath = NULL;
 
+static CommandLineStatus Platform_setRootDir(const char** root, const char* dir) {
+   char* resolved = realpath(dir, NULL);
+   if (!resolved) {
+      fprintf(stderr, "Error: invalid directory \"%s\": %s\n", dir, strerror(errno));
+      return STATUS_ERROR_EXIT;
+   }
+
+   /* kept for the lifetime of the process */
+   *root = resolved;
+   return STATUS_OK;
+}
+
+CommandLineStatus Platform_getLongOption(int opt, int argc, char** argv) {
    switch (opt) {
+      case 161:
+         return Platform_setRootDir(&LinuxMachine_procDir, optarg);
+
+      case 162:
+         return Platform_setRootDir(&LinuxMachine_sysDir, optarg);
+
+      case 163: {
+         const char* path = optarg;
+         if (!path && optind < argc && argv[optind] != NULL &&
+             (argv[optind][0] != '\0' && argv[optind][0] != '-')) {
+            path = argv[optind++];
+         }
+
+         Platform_attachPath = path ? path : SNAPSHOT_DEFAULT_PATH;
+         return STATUS_OK;
+      }
+
 #ifdef HAVE_LIBCAP
       case 160: {
          const char* mode = optarg;
@@ -1229,17 +1323,26 @@ bool Platform_init(void) {
       return false;
 #endif
 
-   if (access(PROCDIR, R_OK) != 0) {
-      fprintf(stderr, "Error: could not read procfs (compiled to look in %s).\n", PROCDIR);
+   if (access(LinuxMachine_procDir, R_OK) != 0) {
+      fprintf(stderr, "Error: could not read procfs (looking in %s).\n", LinuxMachine_procDir);
       return false;
    }
 
+   if (Platform_attachPath) {
+      Snapshot_reader = SnapshotReader_new(Platform_attachPath);
+      if (!Snapshot_reader)
+         return false;
+   }
+
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_init();
 #endif
 
+   LinuxDynamicScreens_init();
+
+   char path[PATH_MAX];
    char target[PATH_MAX];
-   ssize_t ret = readlink(PROCDIR "/self/ns/pid", target, sizeof(target) - 1);
+   ssize_t ret = readlink(LinuxMachine_procPath(path, sizeof(path), "/self/ns/pid"), target, sizeof(target) - 1);
    if (ret > 0) {
       target[ret] = '\0';
 
@@ -1249,7 +1352,7 @@ bool Platform_init(void) {
       }
    }
 
-   FILE* fp = fopen(PROCDIR "/1/mounts", "r");
+   FILE* fp = fopen(LinuxMachine_procPath(path, sizeof(path), "/1/mounts"), "r");
    if (fp) {
       char lineBuffer[256];
       while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
@@ -1269,4 +1372,73 @@ void Platform_done(void) {
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_cleanup();
 #endif
+   DataSources_done();
+
+#ifdef HAVE_LIBUNWIND_PTRACE
+   if (Platform_backtraceSymbols) {
+      BacktraceSymbols_done(Platform_backtraceSymbols);
+      free(Platform_backtraceSymbols);
+      Platform_backtraceSymbols = NULL;
+   }
+#endif
+
+   if (Snapshot_reader) {
+      SnapshotReader_delete(Snapshot_reader);
+      Snapshot_reader = NULL;
+   }
+}
+
+const char* Platform_getFailedState(void) {
+   return Snapshot_reader ? SnapshotReader_failedState(Snapshot_reader) : NULL;
+}
+
+Hashtable* Platform_dynamicMeters(void) {
+   return LinuxDynamicMeters_new();
+}
+
+void Platform_dynamicMetersDone(Hashtable* table) {
+   LinuxDynamicMeters_done(table);
+}
+
+void Platform_dynamicMeterUpdateValues(Meter* meter) {
+   LinuxDynamicMeter* this = Hashtable_get(meter->host->settings->dynamicMeters, meter->param);
+   if (this)
+      LinuxDynamicMeter_updateValues(this, meter);
+}
+
+void Platform_dynamicMeterDisplay(const Meter* meter, RichString* out) {
+   const LinuxDynamicMeter* this = Hashtable_get(meter->host->settings->dynamicMeters, meter->param);
+   if (this)
+      LinuxDynamicMeter_display(this, out);
+}
+
+Hashtable* Platform_dynamicColumns(void) {
+   return LinuxDynamicScreens_columns();
+}
+
+void Platform_dynamicColumnsDone(Hashtable* columns) {
+   LinuxDynamicColumns_done(columns);
+}
+
+const char* Platform_dynamicColumnName(unsigned int key) {
+   const DynamicColumn* column = Hashtable_get(LinuxDynamicScreens_columns(), key);
+   if (!column)
+      return NULL;
+   return column->heading ? column->heading : column->name;
+}
+
+Hashtable* Platform_dynamicScreens(void) {
+   return LinuxDynamicScreens_screens();
+}
+
+void Platform_addDynamicScreen(ScreenSettings* ss) {
+   LinuxDynamicScreens_addDynamicScreen(ss);
+}
+
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen) {
+   LinuxDynamicScreens_addAvailableColumns(availableColumns, screen);
+}
+
+void Platform_dynamicScreensDone(Hashtable* screens) {
+   LinuxDynamicScreens_done(screens);
 }
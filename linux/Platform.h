@@ -102,15 +102,19 @@ static inline void Platform_getRelease(char** string) {
    *string = Generic_uname();
 }
 
-static inline const char* Platform_getFailedState(void) {
-   return NULL;
-}
+const char* Platform_getFailedState(void);
 
 #ifdef HAVE_LIBCAP
    #define PLATFORM_LONG_OPTIONS \
-      {"drop-capabilities", optional_argument, 0, 160},
+      {"drop-capabilities", optional_argument, 0, 160}, \
+      {"procfs", required_argument, 0, 161}, \
+      {"sysfs", required_argument, 0, 162}, \
+      {"attach", optional_argument, 0, 163},
 #else
-   #define PLATFORM_LONG_OPTIONS
+   #define PLATFORM_LONG_OPTIONS \
+      {"procfs", required_argument, 0, 161}, \
+      {"sysfs", required_argument, 0, 162}, \
+      {"attach", optional_argument, 0, 163},
 #endif
 
 void Platform_longOptionsUsage(const char* name);
@@ -125,42 +129,35 @@ static inline void Platform_gettime_monotonic(uint64_t* msec) {
    Generic_gettime_monotonic(msec);
 }
 
-static inline Hashtable* Platform_dynamicMeters(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicMeters(void);
 
-static inline void Platform_dynamicMetersDone(ATTR_UNUSED Hashtable* table) { }
+void Platform_dynamicMetersDone(Hashtable* table);
 
 static inline void Platform_dynamicMeterInit(ATTR_UNUSED Meter* meter) { }
 
-static inline void Platform_dynamicMeterUpdateValues(ATTR_UNUSED Meter* meter) { }
+void Platform_dynamicMeterUpdateValues(Meter* meter);
 
-static inline void Platform_dynamicMeterDisplay(ATTR_UNUSED const Meter* meter, ATTR_UNUSED RichString* out) { }
+void Platform_dynamicMeterDisplay(const Meter* meter, RichString* out);
 
-static inline Hashtable* Platform_dynamicColumns(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicColumns(void);
 
-static inline void Platform_dynamicColumnsDone(ATTR_UNUSED Hashtable* table) { }
+void Platform_dynamicColumnsDone(Hashtable* columns);
 
-static inline const char* Platform_dynamicColumnName(ATTR_UNUSED unsigned int key) {
-   return NULL;
-}
+const char* Platform_dynamicColumnName(unsigned int key);
 
 static inline bool Platform_dynamicColumnWriteField(ATTR_UNUSED const Process* proc, ATTR_UNUSED RichString* str, ATTR_UNUSED unsigned int key) {
    return false;
 }
 
-static inline Hashtable* Platform_dynamicScreens(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicScreens(void);
 
+/* built-in screens are opt-in, they can be added in the Setup menu */
 static inline void Platform_defaultDynamicScreens(ATTR_UNUSED Settings* settings) { }
 
-static inline void Platform_addDynamicScreen(ATTR_UNUSED ScreenSettings* ss) { }
+void Platform_addDynamicScreen(ScreenSettings* ss);
 
-static inline void Platform_addDynamicScreenAvailableColumns(ATTR_UNUSED Panel* availableColumns, ATTR_UNUSED const char* screen) { }
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen);
 
-static inline void Platform_dynamicScreensDone(ATTR_UNUSED Hashtable* screens) { }
+void Platform_dynamicScreensDone(Hashtable* screens);
 
 #endif
@@ -51,6 +51,27 @@ in the source distribution for its full text.
    GPU_TIME = 132,               \
    GPU_PERCENT = 133,            \
    ISCONTAINER = 134,            \
+   PERCENT_RUNQ_WAIT = 135,      \
+   TIMESLICE_RATE = 136,         \
+   PERCENT_CPU_HISTORY = 137,    \
+   M_RESIDENT_HISTORY = 138,     \
+   IO_RATE_HISTORY = 139,        \
+   NET_NS = 140,                 \
+   NET_NS_RX_RATE = 141,         \
+   NET_NS_TX_RATE = 142,         \
+   NUMA_NODE = 143,              \
+   PERCENT_NUMA_REMOTE = 144,    \
+   M_USS = 145,                  \
+   M_USS_ERROR = 146,            \
+   M_WSS = 147,                  \
+   PERF_IPC = 148,               \
+   PERF_CACHE_MISS = 149,        \
+   PERF_CSW_RATE = 150,          \
+   PERF_FAULT_RATE = 151,        \
+   RUNQ_P50 = 152,               \
+   RUNQ_P99 = 153,               \
+   OFFCPU_P50 = 154,             \
+   OFFCPU_P99 = 155,             \
    // End of list
 
 
@@ -0,0 +1,318 @@
+/*
+htop - linux/ProcessMaps.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcessMaps.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+void ProcessMaps_init(ProcessMaps* this) {
+   this->size = 65536;
+   this->buffer = xMalloc(this->size);
+   this->files = Hashtable_new(256, false);
+   this->layouts = Hashtable_new(64, true);
+   this->refreshMs = 0;
+   this->touched = NULL;
+   this->nTouched = 0;
+   this->touchedCapacity = 0;
+   this->stamp = 0;
+}
+
+static void ProcessMaps_freeChain(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   MappedFile* file = value;
+   while (file) {
+      MappedFile* next = file->next;
+      free(file);
+      file = next;
+   }
+}
+
+static void ProcessMaps_forget(ProcessMaps* this) {
+   Hashtable_foreach(this->files, ProcessMaps_freeChain, NULL);
+   Hashtable_clear(this->files);
+   Hashtable_clear(this->layouts);
+}
+
+void ProcessMaps_done(ProcessMaps* this) {
+   ProcessMaps_forget(this);
+   Hashtable_delete(this->files);
+   Hashtable_delete(this->layouts);
+   free(this->touched);
+   free(this->buffer);
+}
+
+static inline ht_key_t ProcessMaps_fileKey(uint64_t dev, uint64_t inode) {
+   uint64_t mixed = (inode ^ (dev * 0x9E3779B97F4A7C15ULL));
+   return (ht_key_t) (mixed ^ (mixed >> 32));
+}
+
+/* Word-at-a-time FNV variant; only compared for equality together with the length */
+static uint64_t ProcessMaps_hash(const char* data, size_t length) {
+   uint64_t hash = 0xcbf29ce484222325ULL ^ length;
+   size_t i = 0;
+   for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(word));
+      hash = (hash ^ word) * 0x100000001b3ULL;
+      hash ^= hash >> 29;
+   }
+   for (; i < length; i++)
+      hash = (hash ^ (unsigned char)data[i]) * 0x100000001b3ULL;
+
+   return hash;
+}
+
+static inline uint64_t ProcessMaps_parseHex(const char** cursor, const char* end) {
+   uint64_t result = 0;
+   const char* p = *cursor;
+   for (; p < end; p++) {
+      unsigned int c = (unsigned char)*p;
+      unsigned int nibble;
+      if (c - '0' < 10U)
+         nibble = c - '0';
+      else if ((c | 0x20) - 'a' < 6U)
+         nibble = (c | 0x20) - 'a' + 10;
+      else
+         break;
+      result = (result << 4) | nibble;
+   }
+   *cursor = p;
+   return result;
+}
+
+static inline uint64_t ProcessMaps_parseDec(const char** cursor, const char* end) {
+   uint64_t result = 0;
+   const char* p = *cursor;
+   for (; p < end && *p >= '0' && *p <= '9'; p++)
+      result = result * 10 + (uint64_t)(*p - '0');
+   *cursor = p;
+   return result;
+}
+
+static bool ProcessMaps_isDeleted(const char* path, size_t length) {
+   static const char marker[] = " (deleted)";
+   const size_t markerLen = sizeof(marker) - 1;
+
+   if (length <= markerLen || path[0] != '/')
+      return false;
+
+   if (memcmp(path + length - markerLen, marker, markerLen) != 0)
+      return false;
+
+   if (length >= 7 && memcmp(path, "/memfd:", 7) == 0)
+      return false;
+
+   /* Virtualbox maps /dev/zero for memory allocation. That results in
+    * false positive, so ignore. */
+   if (length == 19 && memcmp(path, "/dev/zero (deleted)", 19) == 0)
+      return false;
+
+   return true;
+}
+
+static MappedFile* ProcessMaps_file(ProcessMaps* this, uint64_t dev, uint64_t inode, const char* path, size_t pathLen) {
+   ht_key_t key = ProcessMaps_fileKey(dev, inode);
+   MappedFile* head = Hashtable_get(this->files, key);
+   for (MappedFile* file = head; file; file = file->next) {
+      if (file->dev == dev && file->inode == inode)
+         return file;
+   }
+
+   MappedFile* file = xCalloc(1, sizeof(MappedFile));
+   file->dev = dev;
+   file->inode = inode;
+   file->deleted = ProcessMaps_isDeleted(path, pathLen);
+   file->next = head;
+   Hashtable_put(this->files, key, file);
+   return file;
+}
+
+static void ProcessMaps_touch(ProcessMaps* this, MappedFile* file) {
+   if (file->stamp == this->stamp)
+      return;
+
+   file->stamp = this->stamp;
+   file->size = 0;
+   file->exec = false;
+
+   if (this->nTouched == this->touchedCapacity) {
+      this->touchedCapacity = this->touchedCapacity ? this->touchedCapacity * 2 : 64;
+      this->touched = xReallocArray(this->touched, this->touchedCapacity, sizeof(*this->touched));
+   }
+   this->touched[this->nTouched++] = file;
+}
+
+/* Lines look like "start-end perms offset major:minor inode   path" */
+bool ProcessMaps_nextFile(const char** cursor, const char* end, ProcessMapping* mapping) {
+   while (*cursor < end) {
+      const char* eol = memchr(*cursor, '\n', (size_t)(end - *cursor));
+      if (!eol)
+         eol = end;
+
+      const char* p = *cursor;
+      *cursor = eol + 1;
+
+      /* anonymous mappings have no path */
+      if (!memchr(p, '/', (size_t)(eol - p)))
+         continue;
+
+      mapping->start = ProcessMaps_parseHex(&p, eol);
+      if (p >= eol || *p++ != '-')
+         continue;
+
+      mapping->end = ProcessMaps_parseHex(&p, eol);
+      if (eol - p < 6 || *p++ != ' ')
+         continue;
+
+      mapping->exec = (p[2] == 'x');
+      p += 4;
+      if (*p++ != ' ')
+         continue;
+
+      mapping->offset = ProcessMaps_parseHex(&p, eol);
+      if (p >= eol || *p++ != ' ')
+         continue;
+
+      uint64_t devMajor = ProcessMaps_parseHex(&p, eol);
+      if (p >= eol || *p++ != ':')
+         continue;
+
+      uint64_t devMinor = ProcessMaps_parseHex(&p, eol);
+      if (p >= eol || *p++ != ' ')
+         continue;
+
+      if (!devMajor && !devMinor)
+         continue;
+
+      mapping->dev = (devMajor << 32) | devMinor;
+      mapping->inode = ProcessMaps_parseDec(&p, eol);
+      if (!mapping->inode)
+         continue;
+
+      while (p < eol && *p == ' ')
+         p++;
+
+      mapping->path = p;
+      mapping->pathLen = (size_t)(eol - p);
+      return true;
+   }
+
+   return false;
+}
+
+static void ProcessMaps_parse(ProcessMaps* this, const char* content, size_t length, ProcessMapsInfo* info) {
+   this->stamp++;
+   this->nTouched = 0;
+   info->libSize = 0;
+   info->usesDeletedLib = false;
+
+   const char* cursor = content;
+   const char* end = content + length;
+   ProcessMapping mapping;
+   while (ProcessMaps_nextFile(&cursor, end, &mapping)) {
+      MappedFile* file = ProcessMaps_file(this, mapping.dev, mapping.inode, mapping.path, mapping.pathLen);
+      ProcessMaps_touch(this, file);
+      file->size += mapping.end - mapping.start;
+      file->exec |= mapping.exec;
+
+      if (mapping.exec && file->deleted)
+         info->usesDeletedLib = true;
+   }
+
+   for (size_t i = 0; i < this->nTouched; i++) {
+      if (this->touched[i]->exec)
+         info->libSize += this->touched[i]->size;
+   }
+}
+
+/* mappings above this address are not in the page tables of the process, like [vsyscall] */
+#define PROCESS_MAPS_USER_LIMIT (1ULL << 57)
+
+size_t ProcessMaps_ranges(const char* content, size_t length, uint64_t** ranges, size_t* capacity) {
+   size_t count = 0;
+
+   const char* end = content + length;
+   for (const char* line = content; line < end; ) {
+      const char* eol = memchr(line, '\n', (size_t)(end - line));
+      if (!eol)
+         eol = end;
+
+      const char* p = line;
+      line = eol + 1;
+
+      uint64_t start = ProcessMaps_parseHex(&p, eol);
+      if (p >= eol || *p++ != '-')
+         continue;
+
+      uint64_t stop = ProcessMaps_parseHex(&p, eol);
+      if (stop <= start || start >= PROCESS_MAPS_USER_LIMIT)
+         continue;
+
+      if (count == *capacity) {
+         *capacity = *capacity ? *capacity * 2 : 256;
+         *ranges = xReallocArray(*ranges, *capacity, 2 * sizeof(**ranges));
+      }
+      (*ranges)[2 * count] = start;
+      (*ranges)[2 * count + 1] = stop;
+      count++;
+   }
+
+   return count;
+}
+
+const char* ProcessMaps_load(ProcessMaps* this, openat_arg_t procFd, size_t* length) {
+   for (;;) {
+      ssize_t r = xReadfileat(procFd, "maps", this->buffer, this->size);
+      if (r < 0)
+         return NULL;
+      if ((size_t) r < this->size - 1) {
+         *length = (size_t) r;
+         return this->buffer;
+      }
+
+      this->size *= 2;
+      this->buffer = xRealloc(this->buffer, this->size);
+   }
+}
+
+bool ProcessMaps_read(ProcessMaps* this, openat_arg_t procFd, uint64_t monotonicMs, ProcessMapsInfo* info) {
+   if (this->refreshMs != monotonicMs) {
+      ProcessMaps_forget(this);
+      this->refreshMs = monotonicMs;
+   }
+
+   size_t length;
+   const char* content = ProcessMaps_load(this, procFd, &length);
+   if (!content)
+      return false;
+
+   uint64_t hash = ProcessMaps_hash(content, length);
+   ht_key_t key = (ht_key_t) (hash ^ (hash >> 32));
+
+   MapsLayout* layout = Hashtable_get(this->layouts, key);
+   if (layout && layout->hash == hash && layout->length == length) {
+      *info = layout->info;
+      return true;
+   }
+
+   ProcessMaps_parse(this, content, length, info);
+
+   if (!layout) {
+      layout = xMalloc(sizeof(MapsLayout));
+      Hashtable_put(this->layouts, key, layout);
+   }
+   layout->hash = hash;
+   layout->length = length;
+   layout->info = *info;
+   return true;
+}
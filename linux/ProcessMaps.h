@@ -0,0 +1,97 @@
+#ifndef HEADER_ProcessMaps
+#define HEADER_ProcessMaps
+/*
+htop - linux/ProcessMaps.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Compat.h"
+#include "Hashtable.h"
+
+
+/*
+ * Parser for /proc/<pid>/maps shared by all processes of a refresh.
+ * Mapped files are looked up by device and inode, so the path of each
+ * library is only examined the first time a refresh sees it; processes
+ * with a byte-identical maps file, like forked workers, reuse the result
+ * of the first one.  Both caches are forgotten at the start of a refresh.
+ */
+
+/* Summary of the file mappings of a process */
+typedef struct ProcessMapsInfo_ {
+   uint64_t libSize;                 /* bytes of files mapped executable at least once */
+   bool usesDeletedLib;              /* maps an unlinked file executable */
+} ProcessMapsInfo;
+
+/* A file mapped by some process of this refresh */
+typedef struct MappedFile_ {
+   uint64_t dev;
+   uint64_t inode;
+   bool deleted;                     /* path had a " (deleted)" suffix when first seen */
+
+   /* accumulated for the process being parsed, valid while stamp is current */
+   uint64_t stamp;
+   uint64_t size;
+   bool exec;
+
+   struct MappedFile_* next;         /* another file with the same key */
+} MappedFile;
+
+/* Result for the content of a maps file, by content hash */
+typedef struct MapsLayout_ {
+   uint64_t hash;
+   size_t length;
+   ProcessMapsInfo info;
+} MapsLayout;
+
+/* A file mapping as parsed from one line of a maps file */
+typedef struct ProcessMapping_ {
+   uint64_t start;
+   uint64_t end;
+   uint64_t offset;                  /* in the file */
+   uint64_t dev;
+   uint64_t inode;
+   bool exec;
+   const char* path;                 /* not terminated, pathLen bytes */
+   size_t pathLen;
+} ProcessMapping;
+
+typedef struct ProcessMaps_ {
+   char* buffer;                     /* reused for reading maps, grown for large processes */
+   size_t size;
+
+   Hashtable* files;                 /* mixed dev and inode -> MappedFile chain */
+   Hashtable* layouts;               /* truncated content hash -> MapsLayout */
+   uint64_t refreshMs;               /* monotonic time the caches belong to */
+
+   MappedFile** touched;             /* files mapped by the process being parsed */
+   size_t nTouched;
+   size_t touchedCapacity;
+   uint64_t stamp;                   /* number of the current parse */
+} ProcessMaps;
+
+void ProcessMaps_init(ProcessMaps* this);
+
+void ProcessMaps_done(ProcessMaps* this);
+
+/* Reads the maps file of a process into the buffer, valid until the next read; NULL if it is not readable */
+const char* ProcessMaps_load(ProcessMaps* this, openat_arg_t procFd, size_t* length);
+
+/* Collects the start and end address of each mapping in content, two
+   entries per mapping, skipping those outside the user address space;
+   returns the number of mappings */
+size_t ProcessMaps_ranges(const char* content, size_t length, uint64_t** ranges, size_t* capacity);
+
+/* Parses the next file mapping of content from *cursor on, advancing it; false past the last one */
+bool ProcessMaps_nextFile(const char** cursor, const char* end, ProcessMapping* mapping);
+
+/* Reads and summarizes the maps file of a process; false if it is not readable */
+bool ProcessMaps_read(ProcessMaps* this, openat_arg_t procFd, uint64_t monotonicMs, ProcessMapsInfo* info);
+
+#endif
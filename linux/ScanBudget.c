@@ -0,0 +1,50 @@
+/*
+htop - linux/ScanBudget.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ScanBudget.h"
+
+#include <time.h>
+
+
+/* single reads take well below a millisecond, so they are timed finer than the refresh clock */
+static uint64_t ScanBudget_now(void) {
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      return 0;
+
+   return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void ScanBudget_init(ScanBudget* this, uint64_t budgetMs) {
+   this->budgetUs = budgetMs * 1000;
+   this->refreshMs = 0;
+   this->spentUs = 0;
+   this->startUs = 0;
+}
+
+bool ScanBudget_begin(ScanBudget* this, uint64_t monotonicMs) {
+   if (this->refreshMs != monotonicMs) {
+      this->refreshMs = monotonicMs;
+      this->spentUs = 0;
+   }
+
+   if (this->spentUs >= this->budgetUs)
+      return false;
+
+   this->startUs = ScanBudget_now();
+   return true;
+}
+
+bool ScanBudget_expired(const ScanBudget* this) {
+   return this->spentUs + (ScanBudget_now() - this->startUs) >= this->budgetUs;
+}
+
+void ScanBudget_end(ScanBudget* this) {
+   this->spentUs += ScanBudget_now() - this->startUs;
+}
@@ -0,0 +1,39 @@
+#ifndef HEADER_ScanBudget
+#define HEADER_ScanBudget
+/*
+htop - linux/ScanBudget.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*
+ * Time a refresh may spend in the readers that walk page tables: the
+ * numa_maps reads, the USS samples and the working set walks all draw from
+ * the same budget.  Only the time between ScanBudget_begin and
+ * ScanBudget_end counts, the rest of the scan does not use it up.
+ */
+
+typedef struct ScanBudget_ {
+   uint64_t budgetUs;
+   uint64_t refreshMs;               /* monotonic time the budget belongs to */
+   uint64_t spentUs;                 /* spent by the finished reads of this refresh */
+   uint64_t startUs;                 /* start of the running read */
+} ScanBudget;
+
+void ScanBudget_init(ScanBudget* this, uint64_t budgetMs);
+
+/* Whether budget is left in this refresh; if so, starts timing a read */
+bool ScanBudget_begin(ScanBudget* this, uint64_t monotonicMs);
+
+/* Whether the running read used up the rest of the budget */
+bool ScanBudget_expired(const ScanBudget* this);
+
+/* Charges the running read to the budget */
+void ScanBudget_end(ScanBudget* this);
+
+#endif
@@ -0,0 +1,806 @@
+/*
+htop - linux/Snapshot.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/Snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Row.h"
+#include "RowField.h"
+#include "Settings.h"
+#include "UsersTable.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "generic/gettime.h"
+#include "linux/LinuxProcess.h"
+
+
+#define SNAPSHOT_MAGIC 0x70616e73706f7468ULL  /* "htopsnap" */
+#define SNAPSHOT_HEADER_SIZE 4096
+#define SNAPSHOT_INITIAL_SLOT_SIZE (4 * 1024 * 1024)
+#define SNAPSHOT_FETCH_ATTEMPTS 16
+
+SnapshotReader* Snapshot_reader = NULL;
+
+/*
+ * Numeric process data copied as is, listed as
+ * X(type, field in the record, member of LinuxProcess)
+ */
+#define SNAPSHOT_PROCESS_FIELDS(X) \
+   X(int, pgrp, super.pgrp) \
+   X(int, session, super.session) \
+   X(int, tpgid, super.tpgid) \
+   X(Tristate, isRunningInContainer, super.isRunningInContainer) \
+   X(unsigned long int, tty_nr, super.tty_nr) \
+   X(uid_t, st_uid, super.st_uid) \
+   X(Tristate, elevated_priv, super.elevated_priv) \
+   X(unsigned long long int, time, super.time) \
+   X(int, processor, super.processor) \
+   X(float, percent_cpu, super.percent_cpu) \
+   X(float, percent_mem, super.percent_mem) \
+   X(long int, priority, super.priority) \
+   X(long int, nice, super.nice) \
+   X(long int, nlwp, super.nlwp) \
+   X(long, m_virt, super.m_virt) \
+   X(long, m_resident, super.m_resident) \
+   X(unsigned long int, minflt, super.minflt) \
+   X(unsigned long int, majflt, super.majflt) \
+   X(ProcessState, state, super.state) \
+   X(int, scheduling_policy, super.scheduling_policy) \
+   X(IOPriority, ioPriority, ioPriority) \
+   X(unsigned long int, cminflt, cminflt) \
+   X(unsigned long int, cmajflt, cmajflt) \
+   X(unsigned long long int, utime, utime) \
+   X(unsigned long long int, stime, stime) \
+   X(unsigned long long int, cutime, cutime) \
+   X(unsigned long long int, cstime, cstime) \
+   X(long, m_share, m_share) \
+   X(long, m_priv, m_priv) \
+   X(long, m_pss, m_pss) \
+   X(long, m_swap, m_swap) \
+   X(long, m_psswp, m_psswp) \
+   X(long, m_trs, m_trs) \
+   X(long, m_drs, m_drs) \
+   X(long, m_lrs, m_lrs) \
+   X(unsigned long int, flags, flags) \
+   X(unsigned long long, io_rchar, io_rchar) \
+   X(unsigned long long, io_wchar, io_wchar) \
+   X(unsigned long long, io_syscr, io_syscr) \
+   X(unsigned long long, io_syscw, io_syscw) \
+   X(unsigned long long, io_read_bytes, io_read_bytes) \
+   X(unsigned long long, io_write_bytes, io_write_bytes) \
+   X(unsigned long long, io_cancelled_write_bytes, io_cancelled_write_bytes) \
+   X(double, io_rate_read_bps, io_rate_read_bps) \
+   X(double, io_rate_write_bps, io_rate_write_bps) \
+   X(unsigned int, oom, oom) \
+   X(unsigned long, ctxt_total, ctxt_total) \
+   X(unsigned long, ctxt_diff, ctxt_diff) \
+   X(unsigned long long int, gpu_time, gpu_time) \
+   X(float, gpu_percent, gpu_percent) \
+   X(uint64_t, gpu_activityMs, gpu_activityMs) \
+   X(long int, autogroup_id, autogroup_id) \
+   X(int, autogroup_nice, autogroup_nice) \
+   X(unsigned long long int, sched_wait_ns, sched_wait_ns) \
+   X(unsigned long long int, sched_timeslices, sched_timeslices) \
+   X(float, sched_wait_percent, sched_wait_percent) \
+   X(double, sched_timeslice_rate, sched_timeslice_rate) \
+   X(int, numa_node, numa_node) \
+   X(float, percent_numa_remote, percent_numa_remote) \
+   X(bool, numa_off_node, numa_off_node) \
+   X(double, m_uss, m_uss) \
+   X(double, m_uss_error, m_uss_error) \
+   X(double, m_wss, m_wss) \
+   X(double, perf_cycles, perf_rates[PERF_EVENT_CYCLES]) \
+   X(double, perf_instructions, perf_rates[PERF_EVENT_INSTRUCTIONS]) \
+   X(double, perf_cache_references, perf_rates[PERF_EVENT_CACHE_REFERENCES]) \
+   X(double, perf_cache_misses, perf_rates[PERF_EVENT_CACHE_MISSES]) \
+   X(double, perf_context_switches, perf_rates[PERF_EVENT_CONTEXT_SWITCHES]) \
+   X(double, perf_page_faults, perf_rates[PERF_EVENT_PAGE_FAULTS]) \
+   SNAPSHOT_OPENVZ_FIELDS(X) \
+   SNAPSHOT_VSERVER_FIELDS(X) \
+   SNAPSHOT_DELAYACCT_FIELDS(X) \
+   SNAPSHOT_BPF_FIELDS(X)
+
+#ifdef HAVE_OPENVZ
+#define SNAPSHOT_OPENVZ_FIELDS(X) X(pid_t, vpid, vpid)
+#else
+#define SNAPSHOT_OPENVZ_FIELDS(X)
+#endif
+
+#ifdef HAVE_VSERVER
+#define SNAPSHOT_VSERVER_FIELDS(X) X(unsigned int, vxid, vxid)
+#else
+#define SNAPSHOT_VSERVER_FIELDS(X)
+#endif
+
+#ifdef HAVE_DELAYACCT
+#define SNAPSHOT_DELAYACCT_FIELDS(X) \
+   X(float, cpu_delay_percent, cpu_delay_percent) \
+   X(float, blkio_delay_percent, blkio_delay_percent) \
+   X(float, swapin_delay_percent, swapin_delay_percent)
+#else
+#define SNAPSHOT_DELAYACCT_FIELDS(X)
+#endif
+
+#ifdef HAVE_BPF
+#define SNAPSHOT_BPF_FIELDS(X) \
+   X(double, runq_p50, runq_p50) \
+   X(double, runq_p99, runq_p99) \
+   X(double, offcpu_p50, offcpu_p50) \
+   X(double, offcpu_p99, offcpu_p99)
+#else
+#define SNAPSHOT_BPF_FIELDS(X)
+#endif
+
+typedef enum SnapshotString_ {
+   SNAPSHOT_TTY_NAME,
+   SNAPSHOT_CMDLINE,
+   SNAPSHOT_COMM,
+   SNAPSHOT_EXE,
+   SNAPSHOT_CWD,
+   SNAPSHOT_CGROUP,
+   SNAPSHOT_CGROUP_SHORT,
+   SNAPSHOT_CONTAINER_SHORT,
+   SNAPSHOT_SECATTR,
+   #ifdef HAVE_OPENVZ
+   SNAPSHOT_CTID,
+   #endif
+   SNAPSHOT_LAST_STRING
+} SnapshotString;
+
+#define SNAPSHOT_DECLARE(type_, name_, member_) type_ name_;
+
+typedef struct SnapshotProcess_ {
+   int32_t pid;
+   int32_t tgid;
+   int32_t ppid;
+   SNAPSHOT_PROCESS_FIELDS(SNAPSHOT_DECLARE)
+   time_t starttime_ctime;
+   uint32_t cmdlineBasenameStart;
+   uint32_t cmdlineBasenameEnd;
+   uint32_t strings[SNAPSHOT_LAST_STRING];   /* offsets into the string area, 0 for NULL */
+   bool isKernelThread;
+   bool isUserlandThread;
+   bool procExeDeleted;
+   bool usesDeletedLib;
+} SnapshotProcess;
+
+/* Start of each slot, followed by the CPUs, the processes and the strings */
+typedef struct SnapshotMachine_ {
+   uint64_t size;             /* bytes of the slot in use */
+   uint64_t generation;
+   uint32_t cpuCount;         /* including the average in front */
+   uint32_t processCount;
+   uint64_t stringsSize;
+
+   memory_t totalMem;
+   memory_t usedMem;
+   memory_t buffersMem;
+   memory_t cachedMem;
+   memory_t sharedMem;
+   memory_t availableMem;
+   memory_t totalSwap;
+   memory_t usedSwap;
+   memory_t cachedSwap;
+   memory_t totalHugePageMem;
+   memory_t usedHugePageMem[HTOP_HUGEPAGE_COUNT];
+   unsigned int activeCPUs;
+   unsigned int runningTasks;
+   double period;
+   unsigned long long int prevGpuTime;
+   unsigned long long int curGpuTime;
+   ZfsArcStats zfs;
+   ZramStats zram;
+   ZswapStats zswap;
+} SnapshotMachine;
+
+static size_t Snapshot_slotOffset(uint32_t slot, uint64_t slotSize) {
+   return SNAPSHOT_HEADER_SIZE + (size_t)slot * slotSize;
+}
+
+/*
+ * Collector side
+ */
+
+static bool SnapshotWriter_map(SnapshotWriter* this, uint64_t slotSize) {
+   size_t mapSize = Snapshot_slotOffset(SNAPSHOT_SLOTS, slotSize);
+
+   struct stat sb;
+   if (fstat(this->fd, &sb) < 0)
+      return false;
+
+   /* never shrink the file, readers could have mapped the whole of it */
+   if ((size_t)sb.st_size < mapSize && ftruncate(this->fd, mapSize) < 0)
+      return false;
+
+   if (this->header)
+      munmap(this->header, this->mapSize);
+
+   void* map = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+   if (map == MAP_FAILED) {
+      this->header = NULL;
+      return false;
+   }
+
+   this->header = map;
+   this->mapSize = mapSize;
+   return true;
+}
+
+SnapshotWriter* SnapshotWriter_new(const char* path, uint64_t intervalMs, uint32_t processFlags) {
+   int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, 0640);
+   if (fd < 0) {
+      fprintf(stderr, "Error: can not open %s: %s\n", path, strerror(errno));
+      return NULL;
+   }
+
+   /* the default lives in a world-writable directory: never write to a file planted by someone else */
+   struct stat sb;
+   if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode) || sb.st_uid != geteuid()) {
+      fprintf(stderr, "Error: %s is not a regular file owned by this user\n", path);
+      close(fd);
+      return NULL;
+   }
+   if ((sb.st_mode & 07777) != 0640 && fchmod(fd, 0640) < 0) {
+      fprintf(stderr, "Error: can not set the mode of %s: %s\n", path, strerror(errno));
+      close(fd);
+      return NULL;
+   }
+
+   if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+      fprintf(stderr, "Error: %s is in use by another collector\n", path);
+      close(fd);
+      return NULL;
+   }
+
+   SnapshotWriter* this = xCalloc(1, sizeof(SnapshotWriter));
+   this->path = xStrdup(path);
+   this->fd = fd;
+
+   /* attached readers stay attached across collector restarts */
+   uint64_t slotSize = SNAPSHOT_INITIAL_SLOT_SIZE;
+   uint64_t generation = 0;
+   SnapshotHeader previous;
+   if (pread(fd, &previous, sizeof(previous), 0) == (ssize_t)sizeof(previous) && previous.magic == SNAPSHOT_MAGIC) {
+      slotSize = MAXIMUM(slotSize, previous.slotSize);
+      generation = previous.generation;
+   }
+
+   if (!SnapshotWriter_map(this, slotSize)) {
+      fprintf(stderr, "Error: can not map %s: %s\n", path, strerror(errno));
+      SnapshotWriter_delete(this);
+      return NULL;
+   }
+
+   SnapshotHeader* header = this->header;
+   for (size_t i = 0; i < SNAPSHOT_SLOTS; i++)
+      __atomic_store_n(&header->sequence[i], header->sequence[i] | 1, __ATOMIC_RELEASE);
+
+   header->magic = SNAPSHOT_MAGIC;
+   xSnprintf(header->version, sizeof(header->version), "%s", VERSION);
+   header->recordSize = sizeof(SnapshotProcess);
+   header->slotCount = SNAPSHOT_SLOTS;
+   header->intervalMs = intervalMs;
+   header->processFlags = processFlags;
+   header->generation = generation;
+   header->writerPid = getpid();
+   __atomic_store_n(&header->slotSize, slotSize, __ATOMIC_RELEASE);
+
+   return this;
+}
+
+void SnapshotWriter_delete(SnapshotWriter* this) {
+   if (this->header) {
+      __atomic_store_n(&this->header->writerPid, 0, __ATOMIC_RELEASE);
+      munmap(this->header, this->mapSize);
+   }
+   if (this->fd >= 0)
+      close(this->fd);
+
+   free(this->records);
+   free(this->strings);
+   free(this->path);
+   free(this);
+}
+
+static uint32_t SnapshotWriter_addString(SnapshotWriter* this, const char* string) {
+   if (!string)
+      return 0;
+
+   size_t length = strlen(string) + 1;
+   if (this->stringsSize + length > this->stringsCapacity) {
+      this->stringsCapacity = MAXIMUM(2 * this->stringsCapacity, this->stringsSize + length);
+      this->strings = xRealloc(this->strings, this->stringsCapacity);
+   }
+
+   uint32_t offset = this->stringsSize;
+   memcpy(this->strings + offset, string, length);
+   this->stringsSize += length;
+   return offset;
+}
+
+#define SNAPSHOT_STORE(type_, name_, member_) record->name_ = lp->member_;
+
+static void SnapshotWriter_addProcess(SnapshotWriter* this, SnapshotProcess* record, const LinuxProcess* lp) {
+   const Process* proc = &lp->super;
+
+   record->pid = Process_getPid(proc);
+   record->tgid = Process_getThreadGroup(proc);
+   record->ppid = Process_getParent(proc);
+   SNAPSHOT_PROCESS_FIELDS(SNAPSHOT_STORE)
+   record->starttime_ctime = proc->starttime_ctime;
+   record->cmdlineBasenameStart = proc->cmdlineBasenameStart;
+   record->cmdlineBasenameEnd = proc->cmdlineBasenameEnd;
+   record->isKernelThread = proc->isKernelThread;
+   record->isUserlandThread = proc->isUserlandThread;
+   record->procExeDeleted = proc->procExeDeleted;
+   record->usesDeletedLib = proc->usesDeletedLib;
+
+   uint32_t* strings = record->strings;
+   strings[SNAPSHOT_TTY_NAME] = SnapshotWriter_addString(this, proc->tty_name);
+   strings[SNAPSHOT_CMDLINE] = SnapshotWriter_addString(this, proc->cmdline);
+   strings[SNAPSHOT_COMM] = SnapshotWriter_addString(this, proc->procComm);
+   strings[SNAPSHOT_EXE] = SnapshotWriter_addString(this, proc->procExe);
+   strings[SNAPSHOT_CWD] = SnapshotWriter_addString(this, proc->procCwd);
+   strings[SNAPSHOT_CGROUP] = SnapshotWriter_addString(this, lp->cgroup);
+   strings[SNAPSHOT_CGROUP_SHORT] = SnapshotWriter_addString(this, lp->cgroup_short);
+   strings[SNAPSHOT_CONTAINER_SHORT] = SnapshotWriter_addString(this, lp->container_short);
+   strings[SNAPSHOT_SECATTR] = SnapshotWriter_addString(this, lp->secattr);
+   #ifdef HAVE_OPENVZ
+   strings[SNAPSHOT_CTID] = SnapshotWriter_addString(this, lp->ctid);
+   #endif
+}
+
+static void SnapshotWriter_fillMachine(SnapshotMachine* machine, const LinuxMachine* lhost) {
+   const Machine* host = &lhost->super;
+
+   machine->totalMem = host->totalMem;
+   machine->usedMem = host->usedMem;
+   machine->buffersMem = host->buffersMem;
+   machine->cachedMem = host->cachedMem;
+   machine->sharedMem = host->sharedMem;
+   machine->availableMem = host->availableMem;
+   machine->totalSwap = host->totalSwap;
+   machine->usedSwap = host->usedSwap;
+   machine->cachedSwap = host->cachedSwap;
+   machine->totalHugePageMem = lhost->totalHugePageMem;
+   memcpy(machine->usedHugePageMem, lhost->usedHugePageMem, sizeof(machine->usedHugePageMem));
+   machine->activeCPUs = host->activeCPUs;
+   machine->runningTasks = lhost->runningTasks;
+   machine->period = lhost->period;
+   machine->prevGpuTime = lhost->prevGpuTime;
+   machine->curGpuTime = lhost->curGpuTime;
+   machine->zfs = lhost->zfs;
+   machine->zram = lhost->zram;
+   machine->zswap = lhost->zswap;
+}
+
+void SnapshotWriter_publish(SnapshotWriter* this, const Machine* host) {
+   const LinuxMachine* lhost = (const LinuxMachine*) host;
+   const Vector* rows = host->processTable->rows;
+
+   /* serialize first, the slot is only locked for copying */
+   size_t count = Vector_size(rows);
+   if (count > this->recordsCapacity) {
+      this->recordsCapacity = count + count / 4;
+      this->records = xReallocArray(this->records, this->recordsCapacity, sizeof(SnapshotProcess));
+   }
+
+   this->stringsSize = 0;
+   SnapshotWriter_addString(this, "");  /* offset 0 stands for NULL */
+
+   SnapshotProcess* records = this->records;
+   uint32_t processCount = 0;
+   for (size_t i = 0; i < count; i++) {
+      const LinuxProcess* lp = (const LinuxProcess*) Vector_get(rows, i);
+      if (!lp->super.super.updated)
+         continue;
+      SnapshotWriter_addProcess(this, &records[processCount++], lp);
+   }
+
+   uint32_t cpuCount = host->existingCPUs + 1;
+   size_t size = sizeof(SnapshotMachine) + cpuCount * sizeof(CPUData) + processCount * sizeof(SnapshotProcess) + this->stringsSize;
+
+   SnapshotHeader* header = this->header;
+   if (size > header->slotSize) {
+      /* all slots move, keep readers away from them until rewritten */
+      for (size_t i = 0; i < SNAPSHOT_SLOTS; i++)
+         __atomic_store_n(&header->sequence[i], header->sequence[i] | 1, __ATOMIC_RELEASE);
+
+      uint64_t slotSize = header->slotSize;
+      while (slotSize < size)
+         slotSize *= 2;
+
+      if (!SnapshotWriter_map(this, slotSize))
+         CRT_fatalError("Cannot grow the snapshot file");
+
+      header = this->header;
+      __atomic_store_n(&header->slotSize, slotSize, __ATOMIC_RELEASE);
+   }
+
+   uint32_t slot = (header->current + 1) % SNAPSHOT_SLOTS;
+   uint64_t sequence = header->sequence[slot] | 1;
+   __atomic_store_n(&header->sequence[slot], sequence, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+
+   char* data = (char*)header + Snapshot_slotOffset(slot, header->slotSize);
+
+   SnapshotMachine* machine = (SnapshotMachine*) data;
+   memset(machine, 0, sizeof(SnapshotMachine));
+   machine->size = size;
+   machine->generation = header->generation + 1;
+   machine->cpuCount = cpuCount;
+   machine->processCount = processCount;
+   machine->stringsSize = this->stringsSize;
+   SnapshotWriter_fillMachine(machine, lhost);
+   data += sizeof(SnapshotMachine);
+
+   memcpy(data, lhost->cpuData, cpuCount * sizeof(CPUData));
+   data += cpuCount * sizeof(CPUData);
+   memcpy(data, records, processCount * sizeof(SnapshotProcess));
+   data += processCount * sizeof(SnapshotProcess);
+   memcpy(data, this->strings, this->stringsSize);
+
+   __atomic_store_n(&header->sequence[slot], sequence + 1, __ATOMIC_RELEASE);
+   __atomic_store_n(&header->current, slot, __ATOMIC_RELEASE);
+   __atomic_store_n(&header->generation, header->generation + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Viewer side
+ */
+
+static bool SnapshotReader_map(SnapshotReader* this, size_t mapSize) {
+   if (this->header)
+      munmap((void*)(uintptr_t)this->header, this->mapSize);
+
+   void* map = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, this->fd, 0);
+   if (map == MAP_FAILED) {
+      this->header = NULL;
+      this->mapSize = 0;
+      return false;
+   }
+
+   this->header = map;
+   this->mapSize = mapSize;
+   return true;
+}
+
+static bool SnapshotReader_open(SnapshotReader* this) {
+   int fd = open(this->path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+   if (fd < 0)
+      return false;
+
+   struct stat sb;
+   if (fstat(fd, &sb) < 0 || (size_t)sb.st_size < sizeof(SnapshotHeader)) {
+      close(fd);
+      errno = EINVAL;
+      return false;
+   }
+
+   /* only trust data that neither other users nor the group could have written */
+   if (!S_ISREG(sb.st_mode) || (sb.st_uid != 0 && sb.st_uid != geteuid()) || (sb.st_mode & (S_IWGRP | S_IWOTH))) {
+      close(fd);
+      errno = EPERM;
+      return false;
+   }
+
+   if (this->fd >= 0)
+      close(this->fd);
+   this->fd = fd;
+   this->inode = sb.st_ino;
+   return SnapshotReader_map(this, sb.st_size);
+}
+
+SnapshotReader* SnapshotReader_new(const char* path) {
+   SnapshotReader* this = xCalloc(1, sizeof(SnapshotReader));
+   this->path = xStrdup(path);
+   this->fd = -1;
+
+   if (!SnapshotReader_open(this)) {
+      if (errno == EPERM) {
+         fprintf(stderr, "Error: can not attach to %s: not owned by root or this user, or writable by others\n", path);
+      } else {
+         fprintf(stderr, "Error: can not attach to %s: %s\n", path, strerror(errno));
+      }
+      SnapshotReader_delete(this);
+      return NULL;
+   }
+
+   const SnapshotHeader* header = this->header;
+   if (header->magic != SNAPSHOT_MAGIC) {
+      fprintf(stderr, "Error: %s is not a snapshot written by htop-collector\n", path);
+      SnapshotReader_delete(this);
+      return NULL;
+   }
+   /* the collector stores a possibly truncated copy of its version */
+   char version[sizeof(header->version)];
+   xSnprintf(version, sizeof(version), "%s", VERSION);
+   if (strncmp(header->version, version, sizeof(version)) != 0 || header->recordSize != sizeof(SnapshotProcess) || header->slotCount != SNAPSHOT_SLOTS) {
+      fprintf(stderr, "Error: %s was written by htop-collector %.*s, which does not match this htop\n",
+              path, (int)sizeof(header->version), header->version);
+      SnapshotReader_delete(this);
+      return NULL;
+   }
+
+   Generic_gettime_monotonic(&this->changedMs);
+   return this;
+}
+
+void SnapshotReader_delete(SnapshotReader* this) {
+   if (this->header)
+      munmap((void*)(uintptr_t)this->header, this->mapSize);
+   if (this->fd >= 0)
+      close(this->fd);
+
+   free(this->data);
+   free(this->path);
+   free(this);
+}
+
+/* Copies the newest consistent snapshot, returns false if there was none */
+static bool SnapshotReader_fetch(SnapshotReader* this) {
+   for (int attempt = 0; attempt < SNAPSHOT_FETCH_ATTEMPTS; attempt++) {
+      const SnapshotHeader* header = this->header;
+
+      uint64_t slotSize = __atomic_load_n(&header->slotSize, __ATOMIC_ACQUIRE);
+      if (slotSize < sizeof(SnapshotMachine))
+         return false;
+
+      /* the collector grew the file */
+      size_t mapSize = Snapshot_slotOffset(SNAPSHOT_SLOTS, slotSize);
+      if (mapSize > this->mapSize) {
+         if (!SnapshotReader_map(this, mapSize))
+            return false;
+         continue;
+      }
+
+      uint32_t slot = __atomic_load_n(&header->current, __ATOMIC_ACQUIRE) % SNAPSHOT_SLOTS;
+      uint64_t sequence = __atomic_load_n(&header->sequence[slot], __ATOMIC_ACQUIRE);
+      if (sequence & 1) {
+         sched_yield();
+         continue;
+      }
+
+      const char* data = (const char*)header + Snapshot_slotOffset(slot, slotSize);
+      uint64_t size = ((const volatile SnapshotMachine*) data)->size;
+      if (size >= sizeof(SnapshotMachine) && size <= slotSize) {
+         if (size > this->dataCapacity) {
+            this->dataCapacity = size + size / 4;
+            this->data = xRealloc(this->data, this->dataCapacity);
+         }
+         memcpy(this->data, data, size);
+      }
+
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&header->sequence[slot], __ATOMIC_RELAXED) != sequence ||
+          __atomic_load_n(&header->slotSize, __ATOMIC_RELAXED) != slotSize)
+         continue;
+
+      /* the copy is consistent, check it describes itself correctly */
+      const SnapshotMachine* machine = (const SnapshotMachine*) this->data;
+      if (size < sizeof(SnapshotMachine) || size > slotSize ||
+          machine->cpuCount == 0 ||
+          size != sizeof(SnapshotMachine) + machine->cpuCount * sizeof(CPUData) + machine->processCount * sizeof(SnapshotProcess) + machine->stringsSize ||
+          machine->stringsSize == 0 || this->data[size - 1] != '\0')
+         return false;
+
+      return true;
+   }
+
+   return false;
+}
+
+void SnapshotReader_scanMachine(SnapshotReader* this, LinuxMachine* lhost) {
+   Machine* host = &lhost->super;
+
+   /* follow a collector that was restarted on a recreated file */
+   struct stat sb;
+   if ((!this->header || this->header->writerPid == 0) && stat(this->path, &sb) == 0 && sb.st_ino != this->inode)
+      SnapshotReader_open(this);
+
+   if (!this->header)
+      return;
+
+   if (!SnapshotReader_fetch(this))
+      return;
+   this->valid = true;
+
+   const SnapshotMachine* machine = (const SnapshotMachine*) this->data;
+   if (machine->generation != this->generation) {
+      this->generation = machine->generation;
+      Generic_gettime_monotonic(&this->changedMs);
+   }
+
+   host->totalMem = machine->totalMem;
+   host->usedMem = machine->usedMem;
+   host->buffersMem = machine->buffersMem;
+   host->cachedMem = machine->cachedMem;
+   host->sharedMem = machine->sharedMem;
+   host->availableMem = machine->availableMem;
+   host->totalSwap = machine->totalSwap;
+   host->usedSwap = machine->usedSwap;
+   host->cachedSwap = machine->cachedSwap;
+   lhost->availableMem = machine->availableMem;
+   lhost->totalHugePageMem = machine->totalHugePageMem;
+   memcpy(lhost->usedHugePageMem, machine->usedHugePageMem, sizeof(lhost->usedHugePageMem));
+   lhost->runningTasks = machine->runningTasks;
+   lhost->period = machine->period;
+   lhost->prevGpuTime = machine->prevGpuTime;
+   lhost->curGpuTime = machine->curGpuTime;
+   lhost->zfs = machine->zfs;
+   lhost->zram = machine->zram;
+   lhost->zswap = machine->zswap;
+
+   /* The CPU meters are sized for the CPU count seen by Machine_new, so
+    * adopt the count of the collector once and keep it afterwards. */
+   unsigned int existingCPUs = machine->cpuCount - 1;
+   if (host->existingCPUs == 0) {
+      free(lhost->cpuData);
+      lhost->cpuData = xCalloc(existingCPUs + 1, sizeof(CPUData));
+      host->existingCPUs = existingCPUs;
+   } else {
+      existingCPUs = MINIMUM(existingCPUs, host->existingCPUs);
+   }
+   host->activeCPUs = MINIMUM(machine->activeCPUs, host->existingCPUs);
+
+   const CPUData* cpus = (const CPUData*)(machine + 1);
+   for (unsigned int i = 0; i <= existingCPUs; i++) {
+      struct DataSource_* frequencySource = lhost->cpuData[i].frequencySource;
+      lhost->cpuData[i] = cpus[i];
+      lhost->cpuData[i].frequencySource = frequencySource;
+   }
+}
+
+static const char* Snapshot_string(const char* strings, uint64_t stringsSize, uint32_t offset) {
+   return (offset && offset < stringsSize) ? strings + offset : NULL;
+}
+
+static void Snapshot_updateString(char** string, const char* value) {
+   if (value) {
+      if (!*string || !String_eq(*string, value))
+         free_and_xStrdup(string, value);
+   } else {
+      free(*string);
+      *string = NULL;
+   }
+}
+
+#define SNAPSHOT_LOAD(type_, name_, member_) lp->member_ = record->name_;
+
+void SnapshotReader_scanProcesses(const SnapshotReader* this, LinuxProcessTable* lpt) {
+   ProcessTable* pt = &lpt->super;
+   const Machine* host = pt->super.host;
+   const LinuxMachine* lhost = (const LinuxMachine*) host;
+   const Settings* settings = host->settings;
+   const ScreenSettings* ss = settings->ss;
+
+   pt->runningTasks = lhost->runningTasks;
+
+   if (!this->valid)
+      return;
+
+   const SnapshotMachine* machine = (const SnapshotMachine*) this->data;
+   const SnapshotProcess* records = (const SnapshotProcess*)((const char*)(machine + 1) + machine->cpuCount * sizeof(CPUData));
+   const char* strings = (const char*)(records + machine->processCount);
+   uint64_t stringsSize = machine->stringsSize;
+
+   for (uint32_t i = 0; i < machine->processCount; i++) {
+      const SnapshotProcess* record = &records[i];
+      if (record->pid <= 0)
+         continue;
+
+      bool preExisting;
+      Process* proc = ProcessTable_getProcess(pt, record->pid, &preExisting, LinuxProcess_new);
+      LinuxProcess* lp = (LinuxProcess*) proc;
+
+      /* the same pid might have been reused for another process */
+      if (preExisting && proc->super.updated)
+         continue;
+
+      uid_t lastUid = proc->st_uid;
+      time_t lastStarttime = proc->starttime_ctime;
+
+      Process_setThreadGroup(proc, record->tgid);
+      Process_setParent(proc, record->ppid);
+      proc->isKernelThread = record->isKernelThread;
+      proc->isUserlandThread = record->isUserlandThread;
+      SNAPSHOT_PROCESS_FIELDS(SNAPSHOT_LOAD)
+      proc->starttime_ctime = record->starttime_ctime;
+
+      if (proc->procExeDeleted != record->procExeDeleted || proc->usesDeletedLib != record->usesDeletedLib) {
+         proc->procExeDeleted = record->procExeDeleted;
+         proc->usesDeletedLib = record->usesDeletedLib;
+         proc->mergedCommand.lastUpdate = 0;
+      }
+
+      const char* cmdline = Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CMDLINE]);
+      size_t basenameStart = record->cmdlineBasenameStart;
+      size_t basenameEnd = record->cmdlineBasenameEnd;
+      if (cmdline && basenameStart < strlen(cmdline) && basenameEnd <= strlen(cmdline) &&
+          (basenameEnd > basenameStart || basenameEnd == 0)) {
+         Process_updateCmdline(proc, cmdline, basenameEnd ? basenameStart : 0, basenameEnd);
+      } else {
+         Process_updateCmdline(proc, NULL, 0, 0);
+      }
+      Process_updateComm(proc, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_COMM]));
+      Process_updateExe(proc, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_EXE]));
+
+      Snapshot_updateString(&proc->tty_name, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_TTY_NAME]));
+      Snapshot_updateString(&proc->procCwd, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CWD]));
+      Snapshot_updateString(&lp->cgroup, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CGROUP]));
+      Snapshot_updateString(&lp->cgroup_short, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CGROUP_SHORT]));
+      Snapshot_updateString(&lp->container_short, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CONTAINER_SHORT]));
+      Snapshot_updateString(&lp->secattr, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_SECATTR]));
+      #ifdef HAVE_OPENVZ
+      Snapshot_updateString(&lp->ctid, Snapshot_string(strings, stringsSize, record->strings[SNAPSHOT_CTID]));
+      #endif
+
+      if (!preExisting || !proc->user || lastUid != proc->st_uid)
+         proc->user = UsersTable_getRef(host->usersTable, proc->st_uid);
+
+      Process_updateCPUFieldWidths(proc->percent_cpu);
+      LinuxProcess_updateFieldWidths(lp, ss->flags);
+      LinuxProcess_updateHistory(lp, ss->flags & PROCESS_FLAG_LINUX_HISTORY);
+
+      if (!preExisting) {
+         Process_fillStarttimeBuffer(proc);
+         ProcessTable_add(pt, proc);
+      } else if (lastStarttime != proc->starttime_ctime) {
+         Process_fillStarttimeBuffer(proc);
+      }
+
+      proc->super.updated = true;
+
+      if (settings->hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
+         proc->super.show = false;
+         continue;
+      }
+
+      if (Process_isKernelThread(proc)) {
+         pt->kernelThreads++;
+      } else if (Process_isUserlandThread(proc)) {
+         pt->userlandThreads++;
+      }
+
+      proc->super.show = ! ((settings->hideKernelThreads && Process_isKernelThread(proc)) || (settings->hideUserlandThreads && Process_isUserlandThread(proc)));
+
+      pt->totalTasks++;
+   }
+}
+
+bool SnapshotReader_hasFlags(const SnapshotReader* this, uint32_t flags) {
+   return this->header && (this->header->processFlags & flags) == flags;
+}
+
+const char* SnapshotReader_failedState(const SnapshotReader* this) {
+   const SnapshotHeader* header = this->header;
+   if (!header || header->writerPid == 0)
+      return "htop-collector is not running";
+
+   uint64_t now;
+   Generic_gettime_monotonic(&now);
+   if (now - this->changedMs > 3 * header->intervalMs + 1000)
+      return "htop-collector stopped publishing";
+
+   return NULL;
+}
@@ -0,0 +1,109 @@
+#ifndef HEADER_Snapshot
+#define HEADER_Snapshot
+/*
+htop - linux/Snapshot.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+/*
+ * Snapshots of the machine and process data shared through a memory mapped
+ * file: htop-collector scans and publishes, any number of htop instances
+ * started with --attach render from the newest published snapshot.
+ *
+ * The file holds a header followed by SNAPSHOT_SLOTS slots.  Each slot is
+ * guarded by a sequence counter (seqlock) that is odd while the collector
+ * writes to it; readers copy the newest slot and retry when the counter
+ * changed meanwhile, so the collector never waits for its readers.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Machine.h"
+
+#include "linux/LinuxMachine.h"
+#include "linux/LinuxProcessTable.h"
+
+
+#ifndef SNAPSHOT_DEFAULT_PATH
+#define SNAPSHOT_DEFAULT_PATH "/dev/shm/htop-snapshot"
+#endif
+
+#define SNAPSHOT_SLOTS 3
+
+typedef struct SnapshotHeader_ {
+   uint64_t magic;
+   char version[32];          /* VERSION of the collector */
+   uint32_t recordSize;       /* size of a process record, changes with the build configuration */
+   uint32_t slotCount;
+   uint64_t slotSize;         /* bytes per slot, only ever grows */
+   uint64_t generation;       /* number of snapshots published */
+   uint32_t current;          /* slot of the newest snapshot */
+   int32_t writerPid;         /* 0 once the collector exited */
+   uint64_t intervalMs;       /* time between two snapshots */
+   uint32_t processFlags;     /* PROCESS_FLAG_* collected, columns needing others are unavailable */
+   uint64_t sequence[SNAPSHOT_SLOTS];
+} SnapshotHeader;
+
+typedef struct SnapshotWriter_ {
+   char* path;
+   int fd;
+   SnapshotHeader* header;
+   size_t mapSize;
+
+   /* serialized records and strings of the next snapshot */
+   void* records;
+   size_t recordsCapacity;
+   char* strings;
+   size_t stringsSize;
+   size_t stringsCapacity;
+} SnapshotWriter;
+
+typedef struct SnapshotReader_ {
+   char* path;
+   int fd;
+   ino_t inode;
+   const SnapshotHeader* header;
+   size_t mapSize;
+
+   /* private copy of the newest snapshot */
+   char* data;
+   size_t dataCapacity;
+   bool valid;
+
+   uint64_t generation;
+   uint64_t changedMs;        /* local time the generation last changed */
+} SnapshotReader;
+
+/* The snapshot htop renders from when started with --attach, NULL otherwise */
+extern SnapshotReader* Snapshot_reader;
+
+SnapshotWriter* SnapshotWriter_new(const char* path, uint64_t intervalMs, uint32_t processFlags);
+
+void SnapshotWriter_delete(SnapshotWriter* this);
+
+/* Publishes the machine-wide data and the process table of host */
+void SnapshotWriter_publish(SnapshotWriter* this, const Machine* host);
+
+/* Returns NULL after printing the reason if the file can not be attached */
+SnapshotReader* SnapshotReader_new(const char* path);
+
+void SnapshotReader_delete(SnapshotReader* this);
+
+/* Copies the newest snapshot and applies its machine-wide data */
+void SnapshotReader_scanMachine(SnapshotReader* this, LinuxMachine* host);
+
+/* Updates the process table from the snapshot copied by SnapshotReader_scanMachine */
+void SnapshotReader_scanProcesses(const SnapshotReader* this, LinuxProcessTable* pt);
+
+/* Whether the collector gathers the data of columns needing these PROCESS_FLAG_* */
+bool SnapshotReader_hasFlags(const SnapshotReader* this, uint32_t flags);
+
+/* Function bar diagnostic when the collector stopped publishing, NULL otherwise */
+const char* SnapshotReader_failedState(const SnapshotReader* this);
+
+#endif
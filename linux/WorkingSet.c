@@ -0,0 +1,196 @@
+/*
+htop - linux/WorkingSet.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WorkingSet.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/LinuxMachine.h"
+#include "linux/Platform.h"
+#include "linux/ProcessMaps.h"
+
+
+/* pagemap entry bits, see Documentation/admin-guide/mm/pagemap.rst */
+#define PAGEMAP_PFN_MASK    ((1ULL << 55) - 1)
+#define PAGEMAP_PRESENT     (1ULL << 63)
+
+/* pagemap entries read at once, the unit of work between budget checks */
+#define WORKING_SET_CHUNK 512
+
+/* bitmap words read or written at once for frames close to each other */
+#define WORKING_SET_SPAN 64
+
+#define WORKING_SET_BITS 64
+
+void WorkingSet_init(WorkingSet* this) {
+   this->bitmapFd = -1;
+   this->bitmapTried = false;
+   this->ranges = NULL;
+   this->rangesCapacity = 0;
+}
+
+void WorkingSet_done(WorkingSet* this) {
+   if (this->bitmapFd >= 0)
+      close(this->bitmapFd);
+   free(this->ranges);
+}
+
+bool WorkingSet_available(WorkingSet* this) {
+   if (!this->bitmapTried) {
+      char path[PATH_MAX];
+      this->bitmapFd = open(LinuxMachine_sysPath(path, sizeof(path), "/kernel/mm/page_idle/bitmap"), O_RDWR | O_CLOEXEC);
+      this->bitmapTried = true;
+   }
+
+   return this->bitmapFd >= 0;
+}
+
+bool WorkingSet_waiting(const WorkingSetScan* scan, uint64_t monotonicMs, uint64_t windowMs) {
+   return scan->phase == WORKING_SET_WAIT && monotonicMs < scan->markedMs + windowMs;
+}
+
+static int WorkingSet_compareFrames(const void* v1, const void* v2) {
+   uint64_t f1 = *(const uint64_t*)v1;
+   uint64_t f2 = *(const uint64_t*)v2;
+   return SPACESHIP_NUMBER(f1, f2);
+}
+
+/* Marks the frames idle, or counts those accessed since they were marked */
+static bool WorkingSet_processFrames(const WorkingSet* this, uint64_t* frames, size_t count, bool mark, unsigned long long* accessed) {
+   qsort(frames, count, sizeof(*frames), WorkingSet_compareFrames);
+
+   uint64_t words[WORKING_SET_SPAN];
+   size_t i = 0;
+   while (i < count) {
+      uint64_t first = frames[i] / WORKING_SET_BITS;
+      size_t j = i;
+      while (j < count && frames[j] / WORKING_SET_BITS < first + WORKING_SET_SPAN)
+         j++;
+
+      size_t nWords = (size_t)(frames[j - 1] / WORKING_SET_BITS - first + 1);
+      off_t offset = (off_t)(first * sizeof(*words));
+
+      if (mark) {
+         /* zero bits leave the flags of their frames alone */
+         memset(words, 0, nWords * sizeof(*words));
+         for (size_t k = i; k < j; k++)
+            words[frames[k] / WORKING_SET_BITS - first] |= 1ULL << (frames[k] % WORKING_SET_BITS);
+
+         if (pwrite(this->bitmapFd, words, nWords * sizeof(*words), offset) < 0)
+            return false;
+      } else {
+         ssize_t r = pread(this->bitmapFd, words, nWords * sizeof(*words), offset);
+         if (r < 0)
+            return false;
+
+         size_t got = (size_t)r / sizeof(*words);
+         for (size_t k = i; k < j; k++) {
+            /* a frame mapped at several addresses counts once */
+            if (k > i && frames[k] == frames[k - 1])
+               continue;
+
+            size_t word = (size_t)(frames[k] / WORKING_SET_BITS - first);
+            if (word >= got || !(words[word] & (1ULL << (frames[k] % WORKING_SET_BITS))))
+               (*accessed)++;
+         }
+      }
+
+      i = j;
+   }
+
+   return true;
+}
+
+WorkingSetStatus WorkingSet_advance(WorkingSet* this, const ScanBudget* budget, WorkingSetScan* scan, openat_arg_t procFd,
+                                    const char* maps, size_t length, size_t pageSize,
+                                    uint64_t monotonicMs, uint64_t windowMs, unsigned long long* pages) {
+   if (scan->phase == WORKING_SET_WAIT) {
+      if (WorkingSet_waiting(scan, monotonicMs, windowMs))
+         return WORKING_SET_PENDING;
+
+      scan->phase = WORKING_SET_CHECK;
+      scan->cursor = 0;
+      scan->accessed = 0;
+   }
+
+   int fd = Compat_openat(procFd, "pagemap", O_RDONLY);
+   if (fd < 0)
+      return WORKING_SET_FAILED;
+
+   size_t nRanges = ProcessMaps_ranges(maps, length, &this->ranges, &this->rangesCapacity);
+   bool mark = scan->phase == WORKING_SET_MARK;
+   bool finished = true;
+
+   uint64_t entries[WORKING_SET_CHUNK];
+   uint64_t frames[WORKING_SET_CHUNK];
+
+   for (size_t r = 0; r < nRanges && finished; r++) {
+      uint64_t stop = this->ranges[2 * r + 1];
+      uint64_t address = MAXIMUM(this->ranges[2 * r], scan->cursor);
+
+      while (address < stop) {
+         if (ScanBudget_expired(budget)) {
+            finished = false;
+            break;
+         }
+
+         size_t n = (size_t) MINIMUM((uint64_t)WORKING_SET_CHUNK, (stop - address) / pageSize);
+         ssize_t got = n ? pread(fd, entries, n * sizeof(*entries), (off_t)(address / pageSize * sizeof(*entries))) : 0;
+         if (got < (ssize_t)sizeof(*entries))
+            break;
+         n = (size_t)got / sizeof(*entries);
+
+         size_t nFrames = 0;
+         for (size_t i = 0; i < n; i++) {
+            if (!(entries[i] & PAGEMAP_PRESENT))
+               continue;
+
+            /* frame numbers read as zero without CAP_SYS_ADMIN */
+            uint64_t pfn = entries[i] & PAGEMAP_PFN_MASK;
+            if (!pfn) {
+               close(fd);
+               return WORKING_SET_FAILED;
+            }
+            frames[nFrames++] = pfn;
+         }
+
+         if (nFrames && !WorkingSet_processFrames(this, frames, nFrames, mark, &scan->accessed)) {
+            close(fd);
+            return WORKING_SET_FAILED;
+         }
+
+         address += n * pageSize;
+         scan->cursor = address;
+      }
+   }
+
+   close(fd);
+
+   if (!finished)
+      return WORKING_SET_PENDING;
+
+   scan->cursor = 0;
+   if (mark) {
+      scan->phase = WORKING_SET_WAIT;
+      /* not monotonicMs, which stands in for the past on the first scan */
+      Platform_gettime_monotonic(&scan->markedMs);
+      return WORKING_SET_PENDING;
+   }
+
+   *pages = scan->accessed;
+   scan->phase = WORKING_SET_MARK;
+   return WORKING_SET_DONE;
+}
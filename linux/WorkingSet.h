@@ -0,0 +1,76 @@
+#ifndef HEADER_WorkingSet
+#define HEADER_WorkingSet
+/*
+htop - linux/WorkingSet.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Compat.h"
+
+#include "linux/ScanBudget.h"
+
+
+/*
+ * Working set estimation by idle page tracking: the resident pages of a
+ * process are marked idle in /sys/kernel/mm/page_idle/bitmap, and after a
+ * window the pages whose idle flag was cleared by an access are counted.
+ * Page frames are found through /proc/<pid>/pagemap, which only shows them
+ * with CAP_SYS_ADMIN; the bitmap itself is only accessible to root.
+ *
+ * Both walks over the address space of a process proceed in chunks of
+ * pages and stop when the time budget of the refresh is used up, to be
+ * continued in the next refresh at the address they stopped at.
+ */
+
+typedef enum WorkingSetPhase_ {
+   WORKING_SET_MARK = 0,             /* marking the resident pages idle */
+   WORKING_SET_WAIT,                 /* waiting for the window to pass */
+   WORKING_SET_CHECK,                /* counting the pages accessed since */
+} WorkingSetPhase;
+
+typedef enum WorkingSetStatus_ {
+   WORKING_SET_PENDING,              /* no new result yet */
+   WORKING_SET_DONE,                 /* a window was completed */
+   WORKING_SET_FAILED,               /* pagemap or page frames not accessible */
+} WorkingSetStatus;
+
+/* Progress of the estimation for one process */
+typedef struct WorkingSetScan_ {
+   WorkingSetPhase phase;
+   uint64_t cursor;                  /* virtual address the walk continues at */
+   uint64_t markedMs;                /* monotonic time the marking finished */
+   unsigned long long accessed;      /* pages found accessed by the running check */
+} WorkingSetScan;
+
+typedef struct WorkingSet_ {
+   int bitmapFd;                     /* page_idle/bitmap, -1 if unavailable */
+   bool bitmapTried;
+
+   uint64_t* ranges;                 /* mappings of the process being walked */
+   size_t rangesCapacity;
+} WorkingSet;
+
+void WorkingSet_init(WorkingSet* this);
+
+void WorkingSet_done(WorkingSet* this);
+
+/* Whether idle page tracking is available to this process */
+bool WorkingSet_available(WorkingSet* this);
+
+/* Whether the process waits for its window to pass, so no walk is due */
+bool WorkingSet_waiting(const WorkingSetScan* scan, uint64_t monotonicMs, uint64_t windowMs);
+
+/* Continues the estimation of a process with the mappings in maps, within the
+   running read of budget; on WORKING_SET_DONE, pages is the number of resident
+   pages accessed in the window */
+WorkingSetStatus WorkingSet_advance(WorkingSet* this, const ScanBudget* budget, WorkingSetScan* scan, openat_arg_t procFd,
+                                    const char* maps, size_t length, size_t pageSize,
+                                    uint64_t monotonicMs, uint64_t windowMs, unsigned long long* pages);
+
+#endif
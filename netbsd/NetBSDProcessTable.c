@@ -204,7 +204,7 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
          NetBSDProcessTable_updateCwd(kproc, proc);
       }
 
-      if (proc->st_uid != kproc->p_uid) {
+      if (proc->st_uid != kproc->p_uid || !proc->user) {
          proc->st_uid = kproc->p_uid;
          proc->user = UsersTable_getRef(host->usersTable, proc->st_uid);
       }
@@ -205,7 +205,7 @@ static void OpenBSDProcessTable_scanProcs(OpenBSDProcessTable* this) {
       proc->majflt = kproc->p_uru_majflt;
       proc->nlwp = 1;
 
-      if (proc->st_uid != kproc->p_uid) {
+      if (proc->st_uid != kproc->p_uid || !proc->user) {
          proc->st_uid = kproc->p_uid;
          proc->user = UsersTable_getRef(host->usersTable, proc->st_uid);
       }
@@ -12,9 +12,11 @@ in the source distribution for its full text.
 
 #include <ctype.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "Hashtable.h"
 #include "XUtils.h"
 
 #include "pcp/Platform.h"
@@ -62,17 +64,35 @@ int Metric_instanceCount(Metric metric) {
    return 0;
 }
 
+/*
+ * Offset of an instance within the value set of the current result.
+ * The index is built on first use after each fetch, replacing what used
+ * to be a linear scan - quadratic when done for every process instance.
+ */
+static int Metric_lookupOffset(Metric metric, const pmValueSet* vset, int inst) {
+   Hashtable* offsets = pcp->offsets[metric];
+   if (!offsets) {
+      offsets = Hashtable_new((size_t)vset->numval, false);
+      for (int i = 0; i < vset->numval; i++) {
+         ht_key_t key = (ht_key_t)vset->vlist[i].inst;
+         if (!Hashtable_get(offsets, key))  /* first match, as a linear scan */
+            Hashtable_put(offsets, key, (void*)(uintptr_t)(i + 1));
+      }
+      pcp->offsets[metric] = offsets;
+   }
+
+   uintptr_t found = (uintptr_t)Hashtable_get(offsets, (ht_key_t)inst);
+   return (int)found - 1;
+}
+
 int Metric_instanceOffset(Metric metric, int inst) {
    pmValueSet* vset = pcp->result->vset[metric];
    if (!vset || vset->numval <= 0)
       return 0;
 
-   /* search for optimal offset for subsequent inst lookups to begin */
-   for (int i = 0; i < vset->numval; i++) {
-      if (inst == vset->vlist[i].inst)
-         return i;
-   }
-   return 0;
+   /* optimal offset for subsequent inst lookups to begin */
+   int offset = Metric_lookupOffset(metric, vset, inst);
+   return offset < 0 ? 0 : offset;
 }
 
 static pmAtomValue* Metric_extract(Metric metric, int inst, int offset, pmValueSet* vset, pmAtomValue* atom, const pmDesc **desc, int type) {
@@ -102,12 +122,10 @@ static const pmDesc* Metric_instanceDesc(Metric metric, int inst, int offset, pm
        && Metric_extract(metric, inst, offset, vset, atom, &desc, type))
       return desc;
 
-   /* slow-path using a linear search for the requested instance */
-   for (int i = 0; i < vset->numval; i++) {
-      if (inst == vset->vlist[i].inst
-          && Metric_extract(metric, inst, i, vset, atom, &desc, type))
-         break;
-   }
+   /* slow-path using the instance index of this result */
+   offset = Metric_lookupOffset(metric, vset, inst);
+   if (offset >= 0)
+      Metric_extract(metric, inst, offset, vset, atom, &desc, type);
    return desc;
 }
 
@@ -224,6 +242,12 @@ bool Metric_fetch(struct timeval* timestamp) {
       pmFreeResult(pcp->result);
       pcp->result = NULL;
    }
+   for (size_t i = 0; i < pcp->totalMetrics; i++) {
+      if (pcp->offsets[i]) {
+         Hashtable_delete(pcp->offsets[i]);
+         pcp->offsets[i] = NULL;
+      }
+   }
    if (pcp->reconnect) {
       if (pmReconnectContext(pcp->context) < 0)
          return false;
@@ -241,13 +265,16 @@ bool Metric_fetch(struct timeval* timestamp) {
       pcp->reconnect = true;
       return false;
    }
-   if (timestamp) {
+   struct timeval sampled;
 #if PMAPI_VERSION >= 3
-      pmtimespecTotimeval(&pcp->result->timestamp, timestamp);
+   pmtimespecTotimeval(&pcp->result->timestamp, &sampled);
 #else
-      *timestamp = pcp->result->timestamp;
+   sampled = pcp->result->timestamp;
 #endif
-   }
+   if (timestamp)
+      *timestamp = sampled;
+   if (pcp->archive)
+      pcp->archive->position = pmtimevalToReal(&sampled);
    return true;
 }
 
@@ -0,0 +1,275 @@
+/*
+htop - PCPArchive.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "pcp/PCPArchive.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "Header.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+#include "pcp/Platform.h"
+
+
+extern Platform* pcp;
+extern pmOptions opts;
+
+/* replay speeds cycled through, in sampling intervals per fetch */
+static const unsigned int PCPArchive_speeds[] = { 1, 10, 100 };
+
+#if PMAPI_VERSION >= 3
+#define PCPArchive_toReal(t_) pmtimespecToReal(t_)
+#define PCPArchive_fromReal(r_, t_) pmtimespecFromReal(r_, t_)
+#else
+#define PCPArchive_toReal(t_) pmtimevalToReal(t_)
+#define PCPArchive_fromReal(r_, t_) pmtimevalFromReal(r_, t_)
+#endif
+
+PCPArchive* PCPArchive_new(void) {
+   if (opts.context != PM_CONTEXT_ARCHIVE)
+      return NULL;
+
+   PCPArchive* this = xCalloc(1, sizeof(PCPArchive));
+   this->start = PCPArchive_toReal(&opts.start);
+   this->finish = PCPArchive_toReal(&opts.finish);
+   this->interval = PCPArchive_toReal(&opts.interval);
+   if (this->interval <= 0.0)
+      this->interval = 1.0;
+   this->position = this->start;
+   this->speed = 1;
+
+   if (this->finish <= this->start) {
+#if PMAPI_VERSION >= 3
+      struct timespec end;
+#else
+      struct timeval end;
+#endif
+      if (pmGetArchiveEnd(&end) >= 0)
+         this->finish = PCPArchive_toReal(&end);
+   }
+   return this;
+}
+
+void PCPArchive_delete(PCPArchive* this) {
+   free(this);
+}
+
+/*
+ * Position the archive so the next fetch returns the sample at `when`.
+ * Seeking uses the temporal index libpcp keeps for each archive volume,
+ * so it never reads the archive from its start.
+ */
+static bool PCPArchive_setMode(const PCPArchive* this, double when) {
+   double delta = this->interval * this->speed;
+   int sts;
+#if PMAPI_VERSION >= 3
+   struct timespec origin, step;
+   pmtimespecFromReal(when, &origin);
+   pmtimespecFromReal(delta, &step);
+   sts = pmSetMode(PM_MODE_INTERP, &origin, &step);
+#else
+   struct timeval origin;
+   pmtimevalFromReal(when, &origin);
+   sts = pmSetMode(PM_MODE_INTERP, &origin, (int)(delta * 1000));
+#endif
+   if (sts < 0) {
+      if (pmDebugOptions.appl0)
+         fprintf(stderr, "Error: cannot set archive position: %s\n", pmErrStr(sts));
+      return false;
+   }
+   return true;
+}
+
+static void PCPArchive_resetHistory(const Header* header) {
+   Header_forEachColumn(header, col) {
+      for (int i = 0; i < Vector_size(header->columns[col]); i++) {
+         Meter* meter = (Meter*) Vector_get(header->columns[col], i);
+         GraphData* data = &meter->drawData;
+         if (data->values)
+            memset(data->values, 0, data->nValues * sizeof(*data->values));
+         timerclear(&data->time);
+      }
+   }
+}
+
+static Htop_Reaction PCPArchive_seek(State* st, double when) {
+   PCPArchive* this = pcp->archive;
+   if (!this)
+      return HTOP_OK;
+
+   double delta = this->interval * this->speed;
+   if (this->start + delta > this->finish)
+      return HTOP_OK;
+
+   when = CLAMP(when, this->start + delta, this->finish);
+   if (!PCPArchive_setMode(this, when - delta))
+      return HTOP_OK;
+
+   /* Sample right before the seek point once, so that rows and rates are
+      rebuilt from there instead of spanning the jump or replaying the
+      archive up to it; the next refresh then fetches `when` itself. */
+   Machine* host = st->host;
+   Machine_scan(host);
+   Machine_scanTables(host);
+
+   /* keep the realtime clock (and graph meters) in step with the archive */
+   struct timeval now;
+   gettimeofday(&now, NULL);
+   pmtimevalFromReal(pmtimevalToReal(&now) - when, &pcp->offset);
+   Platform_gettime_realtime(&host->realtime, &host->realtimeMs);
+   PCPArchive_resetHistory(st->header);
+
+   return HTOP_RECALCULATE | HTOP_REDRAW_BAR | HTOP_KEEP_FOLLOWING;
+}
+
+static Htop_Reaction PCPArchive_actionStepBackward(State* st) {
+   const PCPArchive* this = pcp->archive;
+   return PCPArchive_seek(st, this->position - this->interval);
+}
+
+static Htop_Reaction PCPArchive_actionStepForward(State* st) {
+   const PCPArchive* this = pcp->archive;
+   return PCPArchive_seek(st, this->position + this->interval);
+}
+
+static Htop_Reaction PCPArchive_actionSeekBackward(State* st) {
+   const PCPArchive* this = pcp->archive;
+   return PCPArchive_seek(st, this->position - 60 * this->interval);
+}
+
+static Htop_Reaction PCPArchive_actionSeekForward(State* st) {
+   const PCPArchive* this = pcp->archive;
+   return PCPArchive_seek(st, this->position + 60 * this->interval);
+}
+
+static Htop_Reaction PCPArchive_actionSeekStart(State* st) {
+   return PCPArchive_seek(st, pcp->archive->start);
+}
+
+static Htop_Reaction PCPArchive_actionSeekEnd(State* st) {
+   return PCPArchive_seek(st, pcp->archive->finish);
+}
+
+/* Replays on from the current position, only the step between fetches changes */
+static Htop_Reaction PCPArchive_actionCycleSpeed(ATTR_UNUSED State* st) {
+   PCPArchive* this = pcp->archive;
+   unsigned int previous = this->speed;
+
+   size_t i = 0;
+   while (i < ARRAYSIZE(PCPArchive_speeds) && PCPArchive_speeds[i] != this->speed)
+      i++;
+   this->speed = PCPArchive_speeds[(i + 1) % ARRAYSIZE(PCPArchive_speeds)];
+
+   if (!PCPArchive_setMode(this, this->position + this->interval * this->speed)) {
+      this->speed = previous;
+      return HTOP_OK;
+   }
+
+   return HTOP_REDRAW_BAR | HTOP_KEEP_FOLLOWING;
+}
+
+static const char* const PCPArchive_gotoKeys[] = {"Enter", "Esc", "  "};
+static const int PCPArchive_gotoEvents[] = {13, 27, ERR};
+
+/* Edits a line on the function bar, false when cancelled */
+static bool PCPArchive_readLine(const char* label, char* buffer, size_t size) {
+   const char* const functions[] = {"Go    ", "Cancel ", label, NULL};
+   FunctionBar* bar = FunctionBar_new(functions, PCPArchive_gotoKeys, PCPArchive_gotoEvents);
+
+   size_t len = strlen(buffer);
+   bool done = false;
+   for (;;) {
+      FunctionBar_drawExtra(bar, buffer, -1, true);
+      refresh();
+
+      int ch = getch();
+      if (ch == 27) {
+         break;
+      } else if (ch == 13 || ch == 10 || ch == KEY_ENTER) {
+         done = true;
+         break;
+      } else if (ch == KEY_BACKSPACE || ch == 127) {
+         if (len > 0)
+            buffer[--len] = '\0';
+      } else if (ch == KEY_CTRL('U')) {
+         len = 0;
+         buffer[len] = '\0';
+      } else if (0 < ch && ch < 255 && isprint((unsigned char)ch) && len < size - 1) {
+         buffer[len++] = (char) ch;
+         buffer[len] = '\0';
+      }
+   }
+
+   curs_set(0);
+   FunctionBar_delete(bar);
+   return done;
+}
+
+/*
+ * Asks for a time in the syntax of --start (pmParseTimeWindow(3)): an
+ * absolute time such as "@ 14:30", or an offset like "+5min" from the
+ * start or "-1h" from the end of the archive.
+ */
+static Htop_Reaction PCPArchive_actionGoTo(State* st) {
+   const PCPArchive* this = pcp->archive;
+
+#if PMAPI_VERSION >= 3
+   struct timespec logStart, logEnd, start, end, offset;
+#else
+   struct timeval logStart, logEnd, start, end, offset;
+#endif
+   PCPArchive_fromReal(this->start, &logStart);
+   PCPArchive_fromReal(this->finish, &logEnd);
+
+   char input[64] = "";
+   char label[128] = " Go to time: ";
+   while (PCPArchive_readLine(label, input, sizeof(input))) {
+      if (!input[0])
+         break;
+
+      char* error = NULL;
+      if (pmParseTimeWindow(input, NULL, NULL, NULL, &logStart, &logEnd, &start, &end, &offset, &error) >= 0) {
+         free(error);
+         return PCPArchive_seek(st, PCPArchive_toReal(&start)) | HTOP_REDRAW_BAR;
+      }
+
+      /* the message may span lines, only its first one fits */
+      if (error)
+         error[strcspn(error, "\n")] = '\0';
+      xSnprintf(label, sizeof(label), " %s; go to time: ", error && error[0] ? error : "invalid time");
+      free(error);
+      beep();
+   }
+
+   return HTOP_REDRAW_BAR;
+}
+
+void PCPArchive_setBindings(Htop_Action* keys) {
+   if (!pcp->archive)
+      return;
+
+   keys['('] = PCPArchive_actionStepBackward;
+   keys[')'] = PCPArchive_actionStepForward;
+   keys['{'] = PCPArchive_actionSeekBackward;
+   keys['}'] = PCPArchive_actionSeekForward;
+   keys['g'] = PCPArchive_actionSeekStart;
+   keys['G'] = PCPArchive_actionSeekEnd;
+   keys['f'] = PCPArchive_actionCycleSpeed;
+   keys['@'] = PCPArchive_actionGoTo;
+}
@@ -0,0 +1,30 @@
+#ifndef HEADER_PCPArchive
+#define HEADER_PCPArchive
+/*
+htop - PCPArchive.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+
+#include "Action.h"
+
+
+/* Replay state when sampling from a PCP archive */
+typedef struct PCPArchive_ {
+   double start;         /* archive time bounds, seconds since the epoch */
+   double finish;
+   double interval;      /* sampling interval at normal replay speed */
+   double position;      /* timestamp of the most recently fetched sample */
+   unsigned int speed;   /* sampling intervals advanced per fetch */
+} PCPArchive;
+
+PCPArchive* PCPArchive_new(void);
+
+void PCPArchive_delete(PCPArchive* this);
+
+void PCPArchive_setBindings(Htop_Action* keys);
+
+#endif
@@ -0,0 +1,68 @@
+/*
+htop - PCPArchiveMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "pcp/PCPArchiveMeter.h"
+
+#include <math.h>
+#include <time.h>
+
+#include "CRT.h"
+#include "Object.h"
+#include "XUtils.h"
+
+#include "pcp/PCPArchive.h"
+#include "pcp/Platform.h"
+
+
+extern Platform* pcp;
+
+static const int PCPArchiveMeter_attributes[] = {
+   CLOCK
+};
+
+/* timeline of the archive being replayed: position as a bar, sample time as text */
+static void PCPArchiveMeter_updateValues(Meter* this) {
+   const PCPArchive* archive = pcp->archive;
+   if (!archive) {
+      this->values[0] = NAN;
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "live");
+      return;
+   }
+
+   double length = archive->finish - archive->start;
+   this->values[0] = length > 0.0 ? 100.0 * (archive->position - archive->start) / length : NAN;
+
+   time_t when = (time_t)archive->position;
+   struct tm result;
+   const struct tm* lt = localtime_r(&when, &result);
+   char stamp[32];
+   strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", lt);
+
+   if (archive->speed > 1)
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s x%u", stamp, archive->speed);
+   else
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s", stamp);
+}
+
+const MeterClass PCPArchiveMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = PCPArchiveMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE) | (1 << TEXT_METERMODE),
+   .maxItems = 1,
+   .isPercentChart = true,
+   .total = 100.0,
+   .attributes = PCPArchiveMeter_attributes,
+   .name = "Archive",
+   .uiName = "Archive timeline",
+   .caption = "Archive: ",
+};
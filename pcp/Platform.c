@@ -46,6 +46,8 @@ in the source distribution for its full text.
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
 #include "pcp/Metric.h"
+#include "pcp/PCPArchive.h"
+#include "pcp/PCPArchiveMeter.h"
 #include "pcp/PCPDynamicColumn.h"
 #include "pcp/PCPDynamicMeter.h"
 #include "pcp/PCPDynamicScreen.h"
@@ -120,6 +122,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &FileDescriptorMeter_class,
    &BlankMeter_class,
    &DynamicMeter_class,
+   &PCPArchiveMeter_class,
    NULL
 };
 
@@ -301,7 +304,9 @@ size_t Platform_addMetric(Metric id, const char* name) {
       pcp->pmids = xRealloc(pcp->pmids, j * sizeof(pmID));
       pcp->names = xRealloc(pcp->names, j * sizeof(char*));
       pcp->descs = xRealloc(pcp->descs, j * sizeof(pmDesc));
+      pcp->offsets = xRealloc(pcp->offsets, j * sizeof(Hashtable*));
       memset(&pcp->descs[i], 0, sizeof(pmDesc));
+      pcp->offsets[i] = NULL;
    }
 
    pcp->pmids[i] = pcp->fetch[i] = PM_ID_NULL;
@@ -346,6 +351,7 @@ bool Platform_init(void) {
    pcp->pmids = xCalloc(PCP_METRIC_COUNT, sizeof(pmID));
    pcp->names = xCalloc(PCP_METRIC_COUNT, sizeof(char*));
    pcp->descs = xCalloc(PCP_METRIC_COUNT, sizeof(pmDesc));
+   pcp->offsets = xCalloc(PCP_METRIC_COUNT, sizeof(Hashtable*));
 
    if (opts.context == PM_CONTEXT_ARCHIVE) {
       gettimeofday(&pcp->offset, NULL);
@@ -355,6 +361,7 @@ bool Platform_init(void) {
 #else
       pmtimevalDec(&pcp->offset, &opts.start);
 #endif
+      pcp->archive = PCPArchive_new();
    }
 
    for (unsigned int i = 0; i < PCP_METRIC_COUNT; i++)
@@ -440,6 +447,12 @@ void Platform_done(void) {
    pmDestroyContext(pcp->context);
    if (pcp->result)
       pmFreeResult(pcp->result);
+   for (size_t i = 0; i < pcp->totalMetrics; i++) {
+      if (pcp->offsets[i])
+         Hashtable_delete(pcp->offsets[i]);
+   }
+   free(pcp->offsets);
+   PCPArchive_delete(pcp->archive);
    free(pcp->release);
    free(pcp->fetch);
    free(pcp->pmids);
@@ -449,8 +462,8 @@ void Platform_done(void) {
 }
 
 void Platform_setBindings(Htop_Action* keys) {
-   /* no platform-specific key bindings */
-   (void)keys;
+   /* time navigation when replaying an archive */
+   PCPArchive_setBindings(keys);
 }
 
 int Platform_getUptime(void) {
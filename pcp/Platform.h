@@ -38,6 +38,7 @@ in the source distribution for its full text.
 #include "CommandLine.h"
 
 #include "pcp/Metric.h"
+#include "pcp/PCPArchive.h"
 #include "pcp/PCPDynamicColumn.h"
 #include "pcp/PCPDynamicMeter.h"
 #include "pcp/PCPDynamicScreen.h"
@@ -52,10 +53,12 @@ typedef struct Platform_ {
    pmID* fetch;               /* enabled identifiers for sampling */
    pmDesc* descs;             /* metric desc array indexed by Metric */
    pmResult* result;          /* sample values result indexed by Metric */
+   Hashtable** offsets;       /* per-Metric instance to result offset index */
    PCPDynamicMeters meters;   /* dynamic meters via configuration files */
    PCPDynamicColumns columns; /* dynamic columns via configuration files */
    PCPDynamicScreens screens; /* dynamic screens via configuration files */
    struct timeval offset;     /* time offset used in archive mode only */
+   PCPArchive* archive;       /* archive replay state, NULL for live sources */
    long long btime;           /* boottime in seconds since the epoch */
    char* release;             /* uname and distro from this context */
    int pidmax;                /* maximum platform process identifier */